@@ -0,0 +1,162 @@
+#include <benchmark/benchmark.h>
+
+#include <cstdio>
+#include <filesystem>
+#include <fstream>
+#include <string>
+#include <vector>
+
+#include "intns/io.hpp"
+
+namespace {
+
+using namespace intns::io;
+
+// Bytes parsed per iteration by the reader benchmarks
+constexpr size_t kPayloadSize = 1 << 20;
+
+// Elements per read_array() call
+constexpr size_t kArrayLength = 256;
+
+// A payload of pseudo-random bytes, made once
+const std::vector<uint8_t>& payload() {
+  static const std::vector<uint8_t> bytes = [] {
+    std::vector<uint8_t> result(kPayloadSize);
+    uint32_t state = 0x9e3779b9;
+    for (uint8_t& byte : result) {
+      state = state * 1664525 + 1013904223;
+      byte = static_cast<uint8_t>(state >> 24);
+    }
+    return result;
+  }();
+  return bytes;
+}
+
+// The payload written to a temporary file, removed at exit
+const std::string& payload_file() {
+  struct TempFile {
+    std::string path;
+
+    TempFile()
+        : path((std::filesystem::temp_directory_path() / "intns_bench.bin")
+                   .string()) {
+      std::ofstream file(path, std::ios::binary);
+      file.write(reinterpret_cast<const char*>(payload().data()),
+                 static_cast<std::streamsize>(payload().size()));
+    }
+
+    ~TempFile() { std::remove(path.c_str()); }
+  };
+
+  static const TempFile file;
+  return file.path;
+}
+
+// MemoryReader
+
+template <typename Reader>
+void BM_MemoryReader_U32(benchmark::State& state) {
+  Reader reader(payload());
+  for (auto _ : state) {
+    reader.set_position(0);
+    uint32_t sum = 0;
+    for (size_t i = 0; i < kPayloadSize / sizeof(uint32_t); ++i) {
+      sum += reader.read_u32();
+    }
+    benchmark::DoNotOptimize(sum);
+  }
+  state.SetBytesProcessed(state.iterations() * kPayloadSize);
+}
+BENCHMARK(BM_MemoryReader_U32<LEMemoryReader>);
+BENCHMARK(BM_MemoryReader_U32<BEMemoryReader>);
+
+template <typename Reader>
+void BM_MemoryReader_Array(benchmark::State& state) {
+  Reader reader(payload());
+  std::vector<uint32_t> values(kArrayLength);
+  for (auto _ : state) {
+    reader.set_position(0);
+    for (size_t i = 0; i < kPayloadSize / (kArrayLength * sizeof(uint32_t));
+         ++i) {
+      reader.read_array(std::span<uint32_t>(values));
+    }
+    benchmark::DoNotOptimize(values.data());
+  }
+  state.SetBytesProcessed(state.iterations() * kPayloadSize);
+}
+BENCHMARK(BM_MemoryReader_Array<LEMemoryReader>);
+BENCHMARK(BM_MemoryReader_Array<BEMemoryReader>);
+
+// FileReader, over its buffer size in bytes
+
+template <typename Reader>
+void BM_FileReader_U32(benchmark::State& state) {
+  Reader reader(payload_file(), static_cast<size_t>(state.range(0)));
+  for (auto _ : state) {
+    reader.set_position(0);
+    uint32_t sum = 0;
+    for (size_t i = 0; i < kPayloadSize / sizeof(uint32_t); ++i) {
+      sum += reader.read_u32();
+    }
+    benchmark::DoNotOptimize(sum);
+  }
+  state.SetBytesProcessed(state.iterations() * kPayloadSize);
+}
+BENCHMARK(BM_FileReader_U32<LEFileReader>)->RangeMultiplier(8)->Range(
+    512, 256 * 1024);
+BENCHMARK(BM_FileReader_U32<BEFileReader>)->RangeMultiplier(8)->Range(
+    512, 256 * 1024);
+
+template <typename Reader>
+void BM_FileReader_Array(benchmark::State& state) {
+  Reader reader(payload_file(), static_cast<size_t>(state.range(0)));
+  std::vector<uint32_t> values(kArrayLength);
+  for (auto _ : state) {
+    reader.set_position(0);
+    for (size_t i = 0; i < kPayloadSize / (kArrayLength * sizeof(uint32_t));
+         ++i) {
+      reader.read_array(std::span<uint32_t>(values));
+    }
+    benchmark::DoNotOptimize(values.data());
+  }
+  state.SetBytesProcessed(state.iterations() * kPayloadSize);
+}
+BENCHMARK(BM_FileReader_Array<LEFileReader>)->RangeMultiplier(8)->Range(
+    512, 256 * 1024);
+BENCHMARK(BM_FileReader_Array<BEFileReader>)->RangeMultiplier(8)->Range(
+    512, 256 * 1024);
+
+// Decoding helpers
+
+// Decodes LEB128 values of state.range(0) bytes each
+void BM_Leb128(benchmark::State& state) {
+  const auto length = static_cast<size_t>(state.range(0));
+  std::vector<uint8_t> encoded(kPayloadSize / length * length, 0x80);
+  for (size_t i = length - 1; i < encoded.size(); i += length) {
+    encoded[i] = 0x01;
+  }
+
+  LEMemoryReader reader(encoded);
+  for (auto _ : state) {
+    reader.set_position(0);
+    uint64_t sum = 0;
+    for (size_t i = 0; i < encoded.size() / length; ++i) {
+      sum += reader.read_uleb128();
+    }
+    benchmark::DoNotOptimize(sum);
+  }
+  state.SetBytesProcessed(state.iterations() * encoded.size());
+}
+BENCHMARK(BM_Leb128)->DenseRange(1, 9, 2);
+
+void BM_Crc32c(benchmark::State& state) {
+  const std::span<const uint8_t> data(payload());
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(crc32c(data));
+  }
+  state.SetBytesProcessed(state.iterations() * data.size());
+  state.SetLabel(std::string(crc32c_kernel()));
+}
+BENCHMARK(BM_Crc32c);
+
+}  // namespace
@@ -0,0 +1,138 @@
+#include <benchmark/benchmark.h>
+
+#include <array>
+#include <cstdlib>
+
+#include "intns/memory.hpp"
+
+namespace {
+
+using namespace intns::memory;
+
+// Pooled object, big enough that creating one isn't free
+struct Payload {
+  std::array<uint64_t, 8> data{};
+};
+
+// Largest thread count of the contended benchmarks
+constexpr int kMaxThreads = 8;
+
+// Allocations per batch in the allocator benchmarks, freed all at once
+constexpr int kBatch = 64;
+
+void BM_ObjectPool_TakeAdd(benchmark::State& state) {
+  static ObjectPool<Payload> pool(kMaxThreads * 4);
+  for (auto _ : state) {
+    Payload object = pool.take();
+    benchmark::DoNotOptimize(object);
+    pool.add(std::move(object));
+  }
+  state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_ObjectPool_TakeAdd)->ThreadRange(1, kMaxThreads)->UseRealTime();
+
+void BM_CachedObjectPool_TakeAdd(benchmark::State& state) {
+  static CachedObjectPool<Payload> pool(kMaxThreads * 64);
+  for (auto _ : state) {
+    Payload object = pool.take();
+    benchmark::DoNotOptimize(object);
+    pool.add(std::move(object));
+  }
+  state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_CachedObjectPool_TakeAdd)
+    ->ThreadRange(1, kMaxThreads)
+    ->UseRealTime();
+
+void BM_SlotPool_TakeAdd(benchmark::State& state) {
+  static SlotPool<Payload> pool(kMaxThreads * 4);
+  for (auto _ : state) {
+    Payload* object = pool.take();
+    benchmark::DoNotOptimize(object);
+    pool.add(object);
+  }
+  state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_SlotPool_TakeAdd)->ThreadRange(1, kMaxThreads)->UseRealTime();
+
+// Batches of kBatch allocations of state.range(0) bytes, then frees them
+
+void BM_Malloc(benchmark::State& state) {
+  const auto size = static_cast<size_t>(state.range(0));
+  std::array<void*, kBatch> blocks;
+  for (auto _ : state) {
+    for (void*& block : blocks) {
+      block = std::malloc(size);
+      benchmark::DoNotOptimize(block);
+    }
+    for (void* block : blocks) {
+      std::free(block);
+    }
+  }
+  state.SetItemsProcessed(state.iterations() * kBatch);
+}
+BENCHMARK(BM_Malloc)->RangeMultiplier(4)->Range(16, 4096);
+
+void BM_StackAllocator(benchmark::State& state) {
+  const auto size = static_cast<size_t>(state.range(0));
+  StackAllocator stack(kBatch * (size + alignof(std::max_align_t)));
+  for (auto _ : state) {
+    for (int i = 0; i < kBatch; ++i) {
+      benchmark::DoNotOptimize(stack.alloc(size));
+    }
+    stack.reset();
+  }
+  state.SetItemsProcessed(state.iterations() * kBatch);
+}
+BENCHMARK(BM_StackAllocator)->RangeMultiplier(4)->Range(16, 4096);
+
+void BM_ArenaAllocator(benchmark::State& state) {
+  const auto size = static_cast<size_t>(state.range(0));
+  ArenaAllocator arena;
+  for (auto _ : state) {
+    for (int i = 0; i < kBatch; ++i) {
+      benchmark::DoNotOptimize(arena.alloc(size));
+    }
+    arena.reset();
+  }
+  state.SetItemsProcessed(state.iterations() * kBatch);
+}
+BENCHMARK(BM_ArenaAllocator)->RangeMultiplier(4)->Range(16, 4096);
+
+// Shared by all threads, so contention on the back end shows up
+template <typename Allocator>
+void BM_SizeClass(benchmark::State& state) {
+  const auto size = static_cast<size_t>(state.range(0));
+  static Allocator allocator;
+  std::array<void*, kBatch> blocks;
+  for (auto _ : state) {
+    for (void*& block : blocks) {
+      block = allocator.alloc(size);
+      benchmark::DoNotOptimize(block);
+    }
+    for (void* block : blocks) {
+      allocator.deallocate(block, size);
+    }
+  }
+  state.SetItemsProcessed(state.iterations() * kBatch);
+}
+BENCHMARK(BM_SizeClass<SizeClassAllocator>)
+    ->RangeMultiplier(4)
+    ->Range(16, 1024)
+    ->ThreadRange(1, kMaxThreads)
+    ->UseRealTime();
+BENCHMARK(BM_SizeClass<CachedSizeClassAllocator>)
+    ->RangeMultiplier(4)
+    ->Range(16, 1024)
+    ->ThreadRange(1, kMaxThreads)
+    ->UseRealTime();
+
+// The global heap under the same load, for comparison
+BENCHMARK(BM_Malloc)
+    ->Name("BM_Malloc/threaded")
+    ->RangeMultiplier(4)
+    ->Range(16, 1024)
+    ->ThreadRange(1, kMaxThreads)
+    ->UseRealTime();
+
+}  // namespace
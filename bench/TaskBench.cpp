@@ -0,0 +1,117 @@
+#include <benchmark/benchmark.h>
+
+#include <atomic>
+#include <cstdint>
+#include <thread>
+#include <vector>
+
+#include "intns/task.hpp"
+
+namespace {
+
+using namespace intns::task;
+
+// Largest worker count of the scaling benchmarks
+constexpr int kMaxThreads = 8;
+
+// Elements handed through the rings per iteration
+constexpr size_t kRingItems = 1 << 16;
+
+// Rings
+
+// One producer thread feeds the benchmark thread
+void BM_SpscRing_Transfer(benchmark::State& state) {
+  SpscRing<uint64_t> ring(1024);
+  for (auto _ : state) {
+    std::jthread producer([&ring] {
+      for (uint64_t i = 0; i < kRingItems;) {
+        if (ring.try_push(uint64_t{i})) {
+          ++i;
+        } else {
+          std::this_thread::yield();
+        }
+      }
+    });
+
+    uint64_t sum = 0;
+    for (size_t received = 0; received < kRingItems;) {
+      if (auto value = ring.try_pop()) {
+        sum += *value;
+        ++received;
+      } else {
+        std::this_thread::yield();
+      }
+    }
+    benchmark::DoNotOptimize(sum);
+  }
+  state.SetItemsProcessed(state.iterations() * kRingItems);
+}
+BENCHMARK(BM_SpscRing_Transfer)->UseRealTime();
+
+// Every thread pushes then pops its own element on a shared ring, so the
+// cost is that of the contended indices
+void BM_MpmcRing_PushPop(benchmark::State& state) {
+  static MpmcRing<uint64_t> ring(1024);
+  uint64_t value = 0;
+  for (auto _ : state) {
+    while (!ring.try_push(uint64_t{value})) {
+      std::this_thread::yield();
+    }
+    while (!ring.try_pop(value)) {
+      std::this_thread::yield();
+    }
+  }
+  benchmark::DoNotOptimize(value);
+  state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_MpmcRing_PushPop)->ThreadRange(1, kMaxThreads)->UseRealTime();
+
+// Scheduler, over the worker count
+
+void BM_Scheduler_ParallelFor(benchmark::State& state) {
+  Scheduler scheduler({.thread_count = static_cast<size_t>(state.range(0))});
+  std::vector<uint32_t> values(1 << 20, 1);
+  for (auto _ : state) {
+    std::atomic<uint64_t> total{0};
+    scheduler.parallel_for(0, values.size(), [&](size_t first, size_t last) {
+      uint64_t sum = 0;
+      for (size_t i = first; i < last; ++i) {
+        sum += values[i];
+      }
+      total.fetch_add(sum, std::memory_order_relaxed);
+    });
+    benchmark::DoNotOptimize(total.load());
+  }
+  state.SetItemsProcessed(state.iterations() * values.size());
+}
+BENCHMARK(BM_Scheduler_ParallelFor)
+    ->RangeMultiplier(2)
+    ->Range(1, kMaxThreads)
+    ->UseRealTime();
+
+// Many empty tasks, measuring spawn, steal and completion overhead
+void BM_Scheduler_SpawnWait(benchmark::State& state) {
+  constexpr size_t kTasks = 4096;
+  Scheduler scheduler({.thread_count = static_cast<size_t>(state.range(0))});
+  std::atomic<size_t> counter{0};
+  for (auto _ : state) {
+    // Spawned from a worker, onto its own deque, as nested tasks are
+    TaskGroup group;
+    scheduler.spawn(group, [&] {
+      for (size_t i = 0; i < kTasks; ++i) {
+        scheduler.spawn(group, [&counter] {
+          counter.fetch_add(1, std::memory_order_relaxed);
+        });
+      }
+    });
+    scheduler.wait(group);
+  }
+  benchmark::DoNotOptimize(counter.load());
+  state.SetItemsProcessed(state.iterations() * kTasks);
+}
+BENCHMARK(BM_Scheduler_SpawnWait)
+    ->RangeMultiplier(2)
+    ->Range(1, kMaxThreads)
+    ->UseRealTime();
+
+}  // namespace
@@ -0,0 +1,87 @@
+#!/usr/bin/env python3
+"""Compares two intnslib_bench JSON runs and flags regressions.
+
+Runs are saved with --benchmark_out_format=json (see the bench_baseline
+target). With repetitions, each benchmark's median is compared; otherwise
+its single run. Exits with 1 if any benchmark got slower than --threshold
+percent, so CI can fail on it.
+
+    compare.py [--threshold 10] [--metric real_time] baseline.json new.json
+"""
+
+import argparse
+import json
+import sys
+
+# Nanoseconds per unit of "time_unit"
+UNIT_NS = {"ns": 1.0, "us": 1e3, "ms": 1e6, "s": 1e9}
+
+
+def load(path, metric):
+    """Returns {benchmark name: time in ns} for one saved run."""
+    with open(path) as file:
+        report = json.load(file)
+
+    singles, medians = {}, {}
+    for entry in report["benchmarks"]:
+        if entry.get("error_occurred"):
+            continue
+        name = entry.get("run_name", entry["name"])
+        time = entry[metric] * UNIT_NS[entry.get("time_unit", "ns")]
+        if entry.get("run_type") == "aggregate":
+            if entry.get("aggregate_name") == "median":
+                medians[name] = time
+        else:
+            singles.setdefault(name, time)
+
+    singles.update(medians)
+    return singles
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__.splitlines()[0])
+    parser.add_argument("baseline", help="saved run to compare against")
+    parser.add_argument("current", help="new run")
+    parser.add_argument("--threshold", type=float, default=10.0,
+                        help="allowed slowdown in percent (default 10)")
+    parser.add_argument("--metric", choices=("real_time", "cpu_time"),
+                        default="real_time", help="time to compare")
+    args = parser.parse_args()
+
+    baseline = load(args.baseline, args.metric)
+    current = load(args.current, args.metric)
+
+    width = max(map(len, baseline.keys() | current.keys()), default=9)
+    print(f"{'Benchmark':<{width}}  {'Baseline':>12}  {'Current':>12}  "
+          f"{'Change':>8}")
+
+    regressions = []
+    for name in sorted(baseline.keys() | current.keys()):
+        if name not in current:
+            print(f"{name:<{width}}  {baseline[name]:>10.1f}ns  "
+                  f"{'-':>12}  {'removed':>8}")
+            continue
+        if name not in baseline:
+            print(f"{name:<{width}}  {'-':>12}  {current[name]:>10.1f}ns  "
+                  f"{'new':>8}")
+            continue
+
+        change = (current[name] / baseline[name] - 1.0) * 100.0
+        flag = ""
+        if change > args.threshold:
+            regressions.append(name)
+            flag = "  REGRESSION"
+        print(f"{name:<{width}}  {baseline[name]:>10.1f}ns  "
+              f"{current[name]:>10.1f}ns  {change:>+7.1f}%{flag}")
+
+    if regressions:
+        print(f"\n{len(regressions)} benchmark(s) slower than "
+              f"{args.threshold:g}%:", file=sys.stderr)
+        for name in regressions:
+            print(f"  {name}", file=sys.stderr)
+        return 1
+    return 0
+
+
+if __name__ == "__main__":
+    sys.exit(main())
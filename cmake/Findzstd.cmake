@@ -0,0 +1,19 @@
+# Finds the zstd compression library.
+#
+# Defines zstd_FOUND and the imported target zstd::libzstd. The search can
+# be steered with ZSTD_INCLUDE_DIR and ZSTD_LIBRARY.
+
+find_path(ZSTD_INCLUDE_DIR zstd.h)
+find_library(ZSTD_LIBRARY NAMES zstd zstd_static)
+mark_as_advanced(ZSTD_INCLUDE_DIR ZSTD_LIBRARY)
+
+include(FindPackageHandleStandardArgs)
+find_package_handle_standard_args(zstd
+    REQUIRED_VARS ZSTD_LIBRARY ZSTD_INCLUDE_DIR)
+
+if(zstd_FOUND AND NOT TARGET zstd::libzstd)
+    add_library(zstd::libzstd UNKNOWN IMPORTED)
+    set_target_properties(zstd::libzstd PROPERTIES
+        IMPORTED_LOCATION "${ZSTD_LIBRARY}"
+        INTERFACE_INCLUDE_DIRECTORIES "${ZSTD_INCLUDE_DIR}")
+endif()
@@ -1,7 +1,24 @@
 #ifndef INTNS_IO_HPP
 #define INTNS_IO_HPP
 
+#include "io/BatchLoader.hpp"
 #include "io/BinaryReader.hpp"
+#include "io/BinaryWriter.hpp"
+#include "io/BitReader.hpp"
+#include "io/BufferedReader.hpp"
+#include "io/ByteSwap.hpp"
+#include "io/Checksum.hpp"
+#include "io/ChunkFile.hpp"
+#include "io/Decompress.hpp"
+#include "io/InputStream.hpp"
 #include "io/IoTypes.hpp"
+#include "io/MappedFile.hpp"
+#include "io/MappedFileReader.hpp"
+#include "io/ReadAhead.hpp"
+#include "io/ReadCursor.hpp"
+#include "io/Schema.hpp"
+#include "io/StreamReader.hpp"
+#include "io/StringTable.hpp"
+#include "io/Varint.hpp"
 
 #endif
@@ -0,0 +1,194 @@
+#include "BatchLoader.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <limits>
+#include <mutex>
+#include <stdexcept>
+#include <thread>
+
+#if defined(_WIN32)
+#ifndef NOMINMAX
+#define NOMINMAX
+#endif
+#ifndef WIN32_LEAN_AND_MEAN
+#define WIN32_LEAN_AND_MEAN
+#endif
+#include <windows.h>
+#else
+#include <cerrno>
+
+#include <fcntl.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+namespace intns::io {
+
+BatchLoader::BatchLoader(BatchLoadOptions options)
+    : options_(options),
+      buffers_([] { return std::vector<uint8_t>(); },
+               memory::PoolGrowth{.chunk_size = 1}) {}
+
+BatchLoadResult BatchLoader::load(std::span<const std::string> paths,
+                                  const parse_callback& parse,
+                                  const error_callback& on_error) {
+  if (paths.empty()) {
+    return {};
+  }
+
+  size_t thread_count = options_.thread_count;
+  if (thread_count == 0) {
+    thread_count = std::max(1u, std::thread::hardware_concurrency());
+  }
+  thread_count = std::min(thread_count, paths.size());
+
+  std::atomic<size_t> next{0};
+  std::atomic<size_t> loaded{0};
+  std::atomic<size_t> failed{0};
+  std::atomic<bool> stop{false};
+  std::mutex error_mutex;
+  std::exception_ptr first_error;
+
+  // Keeps the first error for load() to rethrow and stops the batch
+  const auto record = [&](std::exception_ptr error) {
+    std::lock_guard lock(error_mutex);
+    if (!first_error) {
+      first_error = std::move(error);
+    }
+    stop.store(true, std::memory_order_relaxed);
+  };
+
+  const auto work = [&] {
+    // One buffer per worker, reused for every file it loads
+    std::vector<uint8_t> buffer = buffers_.take();
+
+    while (!stop.load(std::memory_order_relaxed)) {
+      const size_t index = next.fetch_add(1, std::memory_order_relaxed);
+      if (index >= paths.size()) {
+        break;
+      }
+
+      std::exception_ptr error;
+      try {
+        read_file(paths[index], buffer);
+        LEMemoryReader reader{std::span<const uint8_t>(buffer)};
+        parse(index, reader);
+        loaded.fetch_add(1, std::memory_order_relaxed);
+      } catch (...) {
+        error = std::current_exception();
+      }
+
+      if (error) {
+        failed.fetch_add(1, std::memory_order_relaxed);
+        if (!on_error) {
+          record(std::move(error));
+        } else {
+          try {
+            on_error(index, std::move(error));
+          } catch (...) {
+            record(std::current_exception());
+          }
+        }
+      }
+
+      if (buffer.capacity() > options_.max_pooled_buffer_size) {
+        buffer = std::vector<uint8_t>();
+      }
+    }
+
+    (void)buffers_.try_add(std::move(buffer));
+  };
+
+  {
+    // The calling thread is one of the workers
+    std::vector<std::jthread> threads;
+    threads.reserve(thread_count - 1);
+    for (size_t i = 1; i < thread_count; ++i) {
+      threads.emplace_back(work);
+    }
+    work();
+  }
+
+  if (first_error) {
+    std::rethrow_exception(first_error);
+  }
+  return {loaded.load(), failed.load()};
+}
+
+#if defined(_WIN32)
+
+void BatchLoader::read_file(const std::string& filename,
+                            std::vector<uint8_t>& buffer) {
+  HANDLE file = CreateFileA(filename.c_str(), GENERIC_READ, FILE_SHARE_READ,
+                            nullptr, OPEN_EXISTING, FILE_FLAG_SEQUENTIAL_SCAN,
+                            nullptr);
+  if (file == INVALID_HANDLE_VALUE) {
+    throw std::runtime_error("Failed to open file: " + filename);
+  }
+
+  LARGE_INTEGER size;
+  if (!GetFileSizeEx(file, &size)) {
+    CloseHandle(file);
+    throw std::runtime_error("Failed to query size of file: " + filename);
+  }
+  buffer.resize(static_cast<size_t>(size.QuadPart));
+
+  size_t done = 0;
+  while (done < buffer.size()) {
+    const auto chunk = static_cast<DWORD>(std::min<size_t>(
+        buffer.size() - done, std::numeric_limits<DWORD>::max()));
+    DWORD read = 0;
+    if (!ReadFile(file, buffer.data() + done, chunk, &read, nullptr)) {
+      CloseHandle(file);
+      throw std::runtime_error("Failed to read file: " + filename);
+    }
+    if (read == 0) {
+      break;  // Truncated since its size was queried
+    }
+    done += read;
+  }
+  CloseHandle(file);
+  buffer.resize(done);
+}
+
+#else
+
+void BatchLoader::read_file(const std::string& filename,
+                            std::vector<uint8_t>& buffer) {
+  const int fd = ::open(filename.c_str(), O_RDONLY | O_CLOEXEC);
+  if (fd < 0) {
+    throw std::runtime_error("Failed to open file: " + filename);
+  }
+
+  struct stat info;
+  if (::fstat(fd, &info) != 0) {
+    ::close(fd);
+    throw std::runtime_error("Failed to query size of file: " + filename);
+  }
+  buffer.resize(static_cast<size_t>(info.st_size));
+
+  size_t done = 0;
+  while (done < buffer.size()) {
+    const ssize_t read =
+        ::pread(fd, buffer.data() + done, buffer.size() - done,
+                static_cast<off_t>(done));
+    if (read < 0) {
+      if (errno == EINTR) {
+        continue;
+      }
+      ::close(fd);
+      throw std::runtime_error("Failed to read file: " + filename);
+    }
+    if (read == 0) {
+      break;  // Truncated since its size was queried
+    }
+    done += static_cast<size_t>(read);
+  }
+  ::close(fd);
+  buffer.resize(done);
+}
+
+#endif
+
+}  // namespace intns::io
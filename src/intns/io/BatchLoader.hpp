@@ -0,0 +1,130 @@
+#ifndef INTNS_IO_BATCH_LOADER_HPP
+#define INTNS_IO_BATCH_LOADER_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <exception>
+#include <functional>
+#include <span>
+#include <string>
+#include <vector>
+
+#include "../memory/ObjectPool.hpp"
+#include "BinaryReader.hpp"
+
+namespace intns::io {
+
+/**
+ * @brief Settings for BatchLoader.
+ */
+struct BatchLoadOptions {
+  // Worker threads, each reading and parsing one file at a time; 0 uses
+  // std::thread::hardware_concurrency(). Cold caches benefit from more
+  // workers than cores, since most of them are waiting on the disk
+  size_t thread_count = 0;
+
+  // Buffers larger than this are freed after use instead of being kept for
+  // the next file, so one huge file doesn't pin its memory
+  size_t max_pooled_buffer_size = 4 * 1024 * 1024;
+};
+
+/**
+ * @brief Totals of one BatchLoader::load() call.
+ */
+struct BatchLoadResult {
+  size_t loaded = 0;  // Files read and parsed without error
+  size_t failed = 0;  // Files that could not be read or parsed
+};
+
+/**
+ * @brief Loads many small files concurrently, parsing each from memory once
+ * it has been read in full.
+ *
+ * Opening files one by one with FileReader pays for an open, a size query
+ * and a blocking read per file, serially. BatchLoader instead hands the
+ * paths to a set of worker threads: each opens a file, sizes it with a
+ * single stat call, reads it whole into a buffer taken from an ObjectPool,
+ * and calls the parse callback with a MemoryReader over it. Buffers go back
+ * to the pool afterwards, so a batch of thousands of files only allocates
+ * about one buffer per worker.
+ *
+ * @section Usage
+ * @code
+ * BatchLoader loader;
+ * std::vector<Mesh> meshes(paths.size());
+ * loader.load(paths, [&](size_t index, LEMemoryReader& reader) {
+ *   meshes[index] = parse_mesh(reader);
+ * });
+ * @endcode
+ *
+ * @note The parse callback runs on the worker threads, concurrently for
+ * different files, and must be thread-safe. The reader and its buffer are
+ * only valid during the call.
+ *
+ * @section Exception Safety
+ * A file that cannot be read, or whose parse callback throws, is passed to
+ * the error callback with its exception. Without an error callback, load()
+ * stops handing out files and rethrows the first such exception once every
+ * worker has finished.
+ */
+class BatchLoader {
+ public:
+  /**
+   * @brief Called with a file's index in the batch and a reader over its
+   * entire contents.
+   */
+  using parse_callback = std::function<void(size_t, LEMemoryReader&)>;
+
+  /**
+   * @brief Called with a file's index in the batch and why it failed.
+   */
+  using error_callback = std::function<void(size_t, std::exception_ptr)>;
+
+  /**
+   * @brief Creates a loader; threads are only started by load().
+   *
+   * @param options Thread count and buffer pooling settings.
+   */
+  explicit BatchLoader(BatchLoadOptions options = {});
+
+  BatchLoader(const BatchLoader&) = delete;
+  BatchLoader& operator=(const BatchLoader&) = delete;
+
+  /**
+   * @brief Reads and parses every file, blocking until all are done.
+   *
+   * Files are started in the order given, but may finish in any order.
+   *
+   * @param paths The files to load.
+   * @param parse Called once per file read successfully.
+   * @param on_error Called once per file that failed (optional); must be
+   * thread-safe, like `parse`.
+   * @return How many files were loaded and how many failed.
+   * @throws std::runtime_error If a file cannot be read and there is no
+   * error callback.
+   * @throws Any exception thrown by `parse` if there is no error callback.
+   */
+  BatchLoadResult load(std::span<const std::string> paths,
+                       const parse_callback& parse,
+                       const error_callback& on_error = {});
+
+  /**
+   * @brief Reads a whole file into a buffer, resizing it to the file's size.
+   *
+   * @param filename Path to the file to read.
+   * @param buffer Destination; its capacity is reused when large enough.
+   * @throws std::runtime_error If the file cannot be opened or read.
+   */
+  static void read_file(const std::string& filename,
+                        std::vector<uint8_t>& buffer);
+
+ private:
+  BatchLoadOptions options_;  ///< Thread count and pooling settings.
+
+  // Read buffers, kept across load() calls
+  memory::ObjectPool<std::vector<uint8_t>> buffers_;
+};
+
+}  // namespace intns::io
+
+#endif  // INTNS_IO_BATCH_LOADER_HPP
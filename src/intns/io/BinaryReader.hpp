@@ -1,16 +1,28 @@
 #ifndef INTNS_IO_BINARY_READER_HPP
 #define INTNS_IO_BINARY_READER_HPP
 
+#include <array>
 #include <bit>
 #include <cstdint>
 #include <cstring>
 #include <fstream>
+#include <memory>
+#include <new>
 #include <span>
 #include <stdexcept>
 #include <string>
+#include <string_view>
 #include <vector>
 
+#include "../memory/MemoryResource.hpp"
+#include "BufferedReader.hpp"
+#include "ByteSwap.hpp"
 #include "IoTypes.hpp"
+#include "ReadAhead.hpp"
+#include "ReadCursor.hpp"
+#include "Schema.hpp"
+#include "StringTable.hpp"
+#include "Varint.hpp"
 
 namespace intns::io {
 
@@ -117,6 +129,21 @@ class MemoryReader {
     position_ = std::min(position_ + bytes, size_);
   }
 
+  /**
+   * @brief Validates that `bytes` bytes remain and consumes them, returning
+   * an unchecked cursor over them.
+   *
+   * One bounds check covers every read from the cursor, e.g. a whole
+   * fixed-size header. The cursor stays valid as long as the buffer does.
+   *
+   * @param bytes Number of bytes to reserve.
+   * @return A cursor over the next `bytes` bytes.
+   * @throws std::out_of_range If insufficient bytes remain in the buffer.
+   */
+  [[nodiscard]] ReadCursor<E> reserve(size_t bytes) {
+    return ReadCursor<E>(read_view(bytes).data(), bytes);
+  }
+
   /**
    * @brief Reads an unsigned 8-bit integer.
    *
@@ -234,6 +261,41 @@ class MemoryReader {
    */
   [[nodiscard]] double read_f64() { return std::bit_cast<double>(read_u64()); }
 
+  /**
+   * @brief Reads an unsigned LEB128 variable-length integer.
+   *
+   * Values of up to 8 bytes are decoded from a single 8-byte load.
+   *
+   * @return The value read from the buffer.
+   * @throws std::out_of_range If the buffer ends within the value.
+   * @throws std::runtime_error If the value is longer than 10 bytes or does
+   * not fit in 64 bits.
+   */
+  [[nodiscard]] uint64_t read_uleb128() { return read_leb128<false>(); }
+
+  /**
+   * @brief Reads a signed LEB128 variable-length integer.
+   *
+   * @return The value read from the buffer.
+   * @throws std::out_of_range If the buffer ends within the value.
+   * @throws std::runtime_error If the value is longer than 10 bytes or does
+   * not fit in 64 bits.
+   */
+  [[nodiscard]] int64_t read_sleb128() {
+    return static_cast<int64_t>(read_leb128<true>());
+  }
+
+  /**
+   * @brief Reads a zigzag-encoded signed integer stored as unsigned LEB128,
+   * as used by Protocol Buffers.
+   *
+   * @return The value read from the buffer.
+   * @throws std::out_of_range If the buffer ends within the value.
+   * @throws std::runtime_error If the value is longer than 10 bytes or does
+   * not fit in 64 bits.
+   */
+  [[nodiscard]] int64_t read_zigzag() { return zigzag_decode(read_uleb128()); }
+
   /**
    * @brief Reads raw bytes into a destination buffer.
    *
@@ -265,15 +327,7 @@ class MemoryReader {
    * @throws std::out_of_range If insufficient bytes remain in the buffer.
    */
   void read_u16_array(uint16_t* array, size_t count) {
-    if (!array) {
-      throw std::invalid_argument("Array pointer cannot be null");
-    }
-    read_bytes(array, count * 2);
-    if constexpr (E != native_endian()) {
-      for (size_t i = 0; i < count; ++i) {
-        array[i] = bswap_16(array[i]);
-      }
-    }
+    read_swapped_array(array, count);
   }
 
   /**
@@ -286,15 +340,46 @@ class MemoryReader {
    * @throws std::out_of_range If insufficient bytes remain in the buffer.
    */
   void read_u32_array(uint32_t* array, size_t count) {
-    if (!array) {
-      throw std::invalid_argument("Array pointer cannot be null");
-    }
-    read_bytes(array, count * 4);
-    if constexpr (E != native_endian()) {
-      for (size_t i = 0; i < count; ++i) {
-        array[i] = bswap_32(array[i]);
-      }
-    }
+    read_swapped_array(array, count);
+  }
+
+  /**
+   * @brief Reads an array of unsigned 64-bit integers with endianness
+   * conversion.
+   *
+   * @param array Pointer to the destination array.
+   * @param count Number of elements to read.
+   * @throws std::invalid_argument If array is nullptr.
+   * @throws std::out_of_range If insufficient bytes remain in the buffer.
+   */
+  void read_u64_array(uint64_t* array, size_t count) {
+    read_swapped_array(array, count);
+  }
+
+  /**
+   * @brief Reads an array of 32-bit floating-point values with endianness
+   * conversion.
+   *
+   * @param array Pointer to the destination array.
+   * @param count Number of elements to read.
+   * @throws std::invalid_argument If array is nullptr.
+   * @throws std::out_of_range If insufficient bytes remain in the buffer.
+   */
+  void read_f32_array(float* array, size_t count) {
+    read_swapped_array(array, count);
+  }
+
+  /**
+   * @brief Reads an array of 64-bit floating-point values with endianness
+   * conversion.
+   *
+   * @param array Pointer to the destination array.
+   * @param count Number of elements to read.
+   * @throws std::invalid_argument If array is nullptr.
+   * @throws std::out_of_range If insufficient bytes remain in the buffer.
+   */
+  void read_f64_array(double* array, size_t count) {
+    read_swapped_array(array, count);
   }
 
   /**
@@ -305,27 +390,76 @@ class MemoryReader {
    * @throws std::out_of_range If insufficient bytes remain in the buffer.
    */
   [[nodiscard]] std::string read_string(size_t length) {
-    if (position_ + length > size_) {
+    return std::string(read_string_view(length));
+  }
+
+  /**
+   * @brief Reads a null-terminated C-style string from the buffer.
+   *
+   * Reads until a null terminator is found or the end of buffer is reached.
+   * If no null terminator is found, reads all remaining bytes.
+   *
+   * @return The string read from the buffer (without null terminator).
+   * @note This method never throws.
+   */
+  [[nodiscard]] std::string read_cstring() {
+    return std::string(read_cstring_view());
+  }
+
+  /**
+   * @brief Reads raw bytes without copying them.
+   *
+   * @param bytes Number of bytes to read.
+   * @return A view of the bytes within the buffer, valid as long as the
+   * buffer is.
+   * @throws std::out_of_range If insufficient bytes remain in the buffer.
+   */
+  [[nodiscard]] std::span<const uint8_t> read_view(size_t bytes) {
+    if (bytes > remaining()) {
+      throw std::out_of_range("Cannot view " + std::to_string(bytes) +
+                              " bytes: only " + std::to_string(remaining()) +
+                              " available");
+    }
+    std::span<const uint8_t> view(data_ + position_, bytes);
+    position_ += bytes;
+    return view;
+  }
+
+  /**
+   * @brief Reads a fixed-length string without copying it.
+   *
+   * @param length Number of bytes to read.
+   * @return A view of the string within the buffer, valid as long as the
+   * buffer is.
+   * @throws std::out_of_range If insufficient bytes remain in the buffer.
+   */
+  [[nodiscard]] std::string_view read_string_view(size_t length) {
+    if (length > remaining()) {
       throw std::out_of_range("Cannot read string of length " +
                               std::to_string(length) + ": only " +
                               std::to_string(remaining()) + " bytes available");
     }
-    std::string result(reinterpret_cast<const char*>(data_ + position_),
-                       length);
+    std::string_view view(reinterpret_cast<const char*>(data_ + position_),
+                          length);
     position_ += length;
-    return result;
+    return view;
   }
 
   /**
-   * @brief Reads a null-terminated C-style string from the buffer.
+   * @brief Reads a null-terminated C-style string without copying it.
    *
    * Reads until a null terminator is found or the end of buffer is reached.
    * If no null terminator is found, reads all remaining bytes.
    *
-   * @return The string read from the buffer (without null terminator).
+   * @return A view of the string within the buffer (without null
+   * terminator), valid as long as the buffer is.
    * @note This method never throws.
    */
-  [[nodiscard]] std::string read_cstring() {
+  [[nodiscard]] std::string_view read_cstring_view() noexcept {
+    if (position_ == size_) {
+      return {};
+    }
+
     const uint8_t* start = data_ + position_;
     const uint8_t* end =
         static_cast<const uint8_t*>(std::memchr(start, 0, remaining()));
@@ -336,9 +470,78 @@ class MemoryReader {
     }
 
     size_t length = end - start;
-    std::string result(reinterpret_cast<const char*>(start), length);
     position_ += length + (end < data_ + size_ ? 1 : 0);
-    return result;
+    return std::string_view(reinterpret_cast<const char*>(start), length);
+  }
+
+  /**
+   * @brief Reads `count` consecutive null-terminated strings without copying
+   * them.
+   *
+   * As with read_cstring_view(), the last string may end at the end of the
+   * buffer instead of a terminator.
+   *
+   * @param count Number of strings to read.
+   * @return A table of views into the buffer, valid as long as the buffer is.
+   * @throws std::out_of_range If the buffer ends before `count` strings, in
+   * which case the position is unchanged.
+   */
+  [[nodiscard]] StringTable read_cstring_table(size_t count) {
+    std::vector<std::string_view> views;
+    views.reserve(checked_table_count(count));
+    scan_cstring_table(count, [&](std::string_view s) { views.push_back(s); });
+    return StringTable(std::move(views));
+  }
+
+  /**
+   * @brief Reads `count` consecutive null-terminated strings without copying
+   * them, placing the table of views in an allocator's storage, e.g. a
+   * StackAllocator frame.
+   *
+   * @param count Number of strings to read.
+   * @param allocator Allocator for the `count` views.
+   * @return The views into the buffer, valid as long as both the buffer and
+   * the allocation are.
+   * @throws std::out_of_range If the buffer ends before `count` strings, in
+   * which case the position is unchanged.
+   * @throws std::bad_alloc If the allocator is out of space.
+   */
+  template <memory::RawAllocator Allocator>
+  [[nodiscard]] std::span<std::string_view> read_cstring_table(
+      size_t count, Allocator& allocator) {
+    checked_table_count(count);
+    auto* views = static_cast<std::string_view*>(allocator.alloc(
+        count * sizeof(std::string_view), alignof(std::string_view)));
+    if (!views && count > 0) {
+      throw std::bad_alloc();
+    }
+
+    size_t index = 0;
+    scan_cstring_table(count, [&](std::string_view s) {
+      new (&views[index++]) std::string_view(s);
+    });
+    return std::span<std::string_view>(views, count);
+  }
+
+  /**
+   * @brief Creates a reader bounded to part of this reader's buffer.
+   *
+   * The child shares the buffer without copying and has its own position,
+   * starting at 0; this reader's position is unchanged.
+   *
+   * @param offset Start of the child's range, from the start of the buffer.
+   * @param length Size of the child's range in bytes.
+   * @return A reader over bytes [offset, offset + length).
+   * @throws std::out_of_range If the range extends beyond the buffer.
+   */
+  [[nodiscard]] MemoryReader subreader(size_t offset, size_t length) const {
+    if (offset > size_ || length > size_ - offset) {
+      throw std::out_of_range("Cannot create subreader at offset " +
+                              std::to_string(offset) + " of length " +
+                              std::to_string(length) + ": buffer size is " +
+                              std::to_string(size_));
+    }
+    return MemoryReader(std::span<const uint8_t>(data_ + offset, length));
   }
 
   /**
@@ -373,7 +576,111 @@ class MemoryReader {
     return value;
   }
 
+  /**
+   * @brief Reads a record or other WireType laid out as described in
+   * Schema.hpp.
+   *
+   * Collapses to a single memcpy when T's memory layout matches the wire.
+   *
+   * @tparam T The type to read.
+   * @return The value read from the buffer.
+   * @throws std::out_of_range If insufficient bytes remain in the buffer.
+   */
+  template <WireType T>
+  [[nodiscard]] T read() {
+    const uint8_t* src = read_view(wire_size<T>()).data();
+    T value{};
+    detail::decode<E>(src, value);
+    return value;
+  }
+
+  /**
+   * @brief Reads consecutive records or other WireTypes.
+   *
+   * Collapses to a single memcpy when T's memory layout matches the wire,
+   * and uses the bulk swap kernels for arithmetic types.
+   *
+   * @param values Destination for the values; its size is the count read.
+   * @throws std::out_of_range If insufficient bytes remain in the buffer.
+   */
+  template <WireType T>
+  void read_array(std::span<T> values) {
+    if constexpr (has_native_layout<T, E>()) {
+      read_bytes(values.data(), values.size_bytes());
+    } else if constexpr (std::is_arithmetic_v<T>) {
+      read_swapped_array(values.data(), values.size());
+    } else {
+      const uint8_t* src = read_view(wire_size<T>() * values.size()).data();
+      for (T& value : values) {
+        detail::decode<E>(src, value);
+      }
+    }
+  }
+
  private:
+  /**
+   * @brief Reads `count` elements into `array`, swapping them in bulk if the
+   * endianness differs from native.
+   */
+  template <typename T>
+  void read_swapped_array(T* array, size_t count) {
+    if (!array) {
+      throw std::invalid_argument("Array pointer cannot be null");
+    }
+    read_bytes(array, count * sizeof(T));
+    if constexpr (E != native_endian()) {
+      bswap_inplace(std::span<T>(array, count));
+    }
+  }
+
+  /**
+   * @brief Decodes a LEB128 value at the current position.
+   */
+  template <bool Signed>
+  uint64_t read_leb128() {
+    uint64_t value;
+    const size_t used =
+        detail::decode_leb128<Signed>(data_ + position_, remaining(), value);
+    if (used == 0) {
+      detail::throw_bad_leb128(remaining());
+    }
+    position_ += used;
+    return value;
+  }
+
+  /**
+   * @brief Rejects a string table that cannot fit in the rest of the
+   * buffer, since every string takes at least one byte.
+   *
+   * @return `count`, now safe to reserve storage for.
+   */
+  size_t checked_table_count(size_t count) const {
+    if (count > remaining()) {
+      throw std::out_of_range("Cannot read " + std::to_string(count) +
+                              " strings: only " + std::to_string(remaining()) +
+                              " bytes available");
+    }
+    return count;
+  }
+
+  /**
+   * @brief Passes the next `count` null-terminated strings to `emit`,
+   * restoring the position if the buffer ends first.
+   */
+  template <typename Emit>
+  void scan_cstring_table(size_t count, Emit&& emit) {
+    const size_t start = position_;
+    for (size_t i = 0; i < count; ++i) {
+      if (position_ == size_) {
+        position_ = start;
+        throw std::out_of_range("Cannot read " + std::to_string(count) +
+                                " strings: buffer ends after " +
+                                std::to_string(i));
+      }
+      emit(read_cstring_view());
+    }
+  }
+
   /**
    * @brief Determines the native endianness of the system.
    *
@@ -394,7 +701,8 @@ class MemoryReader {
  *
  * FileReader provides efficient reading of binary data from files with
  * automatic buffering and endianness conversion. It supports the same
- * operations as MemoryReader but reads data from a file stream.
+ * operations as MemoryReader, through BufferedReader, but reads data from a
+ * file stream.
  *
  * @tparam E The endianness for data interpretation (default: little endian).
  *
@@ -406,28 +714,32 @@ class MemoryReader {
  * std::string header = reader.read_string(16);
  * @endcode
  *
+ * @section Read-Ahead
+ * Passing a ReadAhead with a non-zero buffer count makes a background thread
+ * read the file ahead of the parser, so I/O overlaps parsing. The interface
+ * is unchanged; set_position() discards what was read ahead.
+ *
  * @section Exception Safety
  * Constructor throws std::runtime_error if file cannot be opened.
  * Read operations throw std::out_of_range if attempting to read beyond EOF.
  * File operations may throw std::ios_base::failure based on stream state.
  */
 template <Endianness E = Endianness::kLittle>
-class FileReader {
+class FileReader : public BufferedReader<FileReader<E>, E> {
  public:
   /**
    * @brief Constructs a FileReader and opens the specified file.
    *
    * @param filename Path to the file to read.
    * @param buffer_size Size of the internal buffer (default: 8192 bytes).
+   * @param read_ahead Background read-ahead settings (default: disabled).
    * @throws std::runtime_error If the file cannot be opened.
-   * @throws std::invalid_argument If buffer_size is 0.
+   * @throws std::invalid_argument If buffer_size is 0, or read-ahead is
+   * enabled with a buffer size of 0.
    */
-  explicit FileReader(const std::string& filename, size_t buffer_size = 8192)
-      : buffer_(buffer_size) {
-    if (buffer_size == 0) {
-      throw std::invalid_argument("Buffer size cannot be zero");
-    }
-
+  explicit FileReader(const std::string& filename, size_t buffer_size = 8192,
+                      const ReadAhead& read_ahead = {})
+      : BufferedReader<FileReader<E>, E>(buffer_size) {
     file_.open(filename, std::ios::binary);
     if (!file_) {
       throw std::runtime_error("Failed to open file: " + filename);
@@ -437,24 +749,30 @@ class FileReader {
     file_size_ = file_.tellg();
     file_.seekg(0);
 
-    fill_buffer();
+    // The background thread reads through its own stream
+    if (read_ahead.buffer_count > 0) {
+      file_.close();
+      read_ahead_ = std::make_unique<ReadAheadStream>(filename, read_ahead);
+    }
+
+    this->restart(0);
   }
 
   /**
-   * @brief Returns the total size of the file.
+   * @brief Checks whether a background thread reads ahead of the parser.
    *
-   * @return The size of the file in bytes.
+   * @return true if constructed with read-ahead enabled.
    */
-  [[nodiscard]] size_t size() const noexcept { return file_size_; }
+  [[nodiscard]] bool reads_ahead() const noexcept {
+    return read_ahead_ != nullptr;
+  }
 
   /**
-   * @brief Returns the current read position in the file.
+   * @brief Returns the total size of the file.
    *
-   * @return The current position within the file.
+   * @return The size of the file in bytes.
    */
-  [[nodiscard]] size_t position() const noexcept {
-    return file_pos_ - buffer_remaining();
-  }
+  [[nodiscard]] size_t size() const noexcept { return file_size_; }
 
   /**
    * @brief Returns the number of bytes remaining to be read.
@@ -462,7 +780,7 @@ class FileReader {
    * @return The number of bytes from current position to end of file.
    */
   [[nodiscard]] size_t remaining() const noexcept {
-    return file_size_ - position();
+    return file_size_ - this->position();
   }
 
   /**
@@ -474,13 +792,17 @@ class FileReader {
    */
   void set_position(size_t pos) {
     if (pos > file_size_) pos = file_size_;
-    file_.seekg(pos);
-    if (!file_) {
-      throw std::runtime_error("Failed to seek to position " +
-                               std::to_string(pos));
+    if (read_ahead_) {
+      read_ahead_->seek(pos);
+    } else {
+      file_.clear();  // Reaching EOF must not prevent seeking back
+      file_.seekg(pos);
+      if (!file_) {
+        throw std::runtime_error("Failed to seek to position " +
+                                 std::to_string(pos));
+      }
     }
-    file_pos_ = pos;
-    fill_buffer();
+    this->restart(pos);
   }
 
   /**
@@ -489,240 +811,37 @@ class FileReader {
    * @param bytes The number of bytes to skip.
    * @throws std::runtime_error If seeking fails.
    */
-  void skip(size_t bytes) { set_position(position() + bytes); }
-
-  /**
-   * @brief Reads an unsigned 8-bit integer.
-   *
-   * @return The value read from the file.
-   * @throws std::out_of_range If at end of file.
-   */
-  [[nodiscard]] uint8_t read_u8() {
-    ensure_available(1);
-    return buffer_[buffer_pos_++];
-  }
-
-  /**
-   * @brief Reads an unsigned 16-bit integer with endianness conversion.
-   *
-   * @return The value read from the file.
-   * @throws std::out_of_range If insufficient bytes remain in the file.
-   */
-  [[nodiscard]] uint16_t read_u16() {
-    ensure_available(2);
-    uint16_t value;
-    std::memcpy(&value, &buffer_[buffer_pos_], 2);
-    buffer_pos_ += 2;
-    if constexpr (E != native_endian()) value = bswap_16(value);
-    return value;
-  }
-
-  /**
-   * @brief Reads an unsigned 32-bit integer with endianness conversion.
-   *
-   * @return The value read from the file.
-   * @throws std::out_of_range If insufficient bytes remain in the file.
-   */
-  [[nodiscard]] uint32_t read_u32() {
-    ensure_available(4);
-    uint32_t value;
-    std::memcpy(&value, &buffer_[buffer_pos_], 4);
-    buffer_pos_ += 4;
-    if constexpr (E != native_endian()) value = bswap_32(value);
-    return value;
-  }
-
-  /**
-   * @brief Reads an unsigned 64-bit integer with endianness conversion.
-   *
-   * @return The value read from the file.
-   * @throws std::out_of_range If insufficient bytes remain in the file.
-   */
-  [[nodiscard]] uint64_t read_u64() {
-    ensure_available(8);
-    uint64_t value;
-    std::memcpy(&value, &buffer_[buffer_pos_], 8);
-    buffer_pos_ += 8;
-    if constexpr (E != native_endian()) value = bswap_64(value);
-    return value;
-  }
-
-  /**
-   * @brief Reads a signed 8-bit integer.
-   *
-   * @return The value read from the file.
-   * @throws std::out_of_range If at end of file.
-   */
-  [[nodiscard]] int8_t read_s8() { return static_cast<int8_t>(read_u8()); }
-
-  /**
-   * @brief Reads a signed 16-bit integer with endianness conversion.
-   *
-   * @return The value read from the file.
-   * @throws std::out_of_range If insufficient bytes remain in the file.
-   */
-  [[nodiscard]] int16_t read_s16() { return static_cast<int16_t>(read_u16()); }
-
-  /**
-   * @brief Reads a signed 32-bit integer with endianness conversion.
-   *
-   * @return The value read from the file.
-   * @throws std::out_of_range If insufficient bytes remain in the file.
-   */
-  [[nodiscard]] int32_t read_s32() { return static_cast<int32_t>(read_u32()); }
-
-  /**
-   * @brief Reads a signed 64-bit integer with endianness conversion.
-   *
-   * @return The value read from the file.
-   * @throws std::out_of_range If insufficient bytes remain in the file.
-   */
-  [[nodiscard]] int64_t read_s64() { return static_cast<int64_t>(read_u64()); }
-
-  /**
-   * @brief Reads a 32-bit floating-point value with endianness conversion.
-   *
-   * @return The value read from the file.
-   * @throws std::out_of_range If insufficient bytes remain in the file.
-   */
-  [[nodiscard]] float read_f32() { return std::bit_cast<float>(read_u32()); }
-
-  /**
-   * @brief Reads a 64-bit floating-point value with endianness conversion.
-   *
-   * @return The value read from the file.
-   * @throws std::out_of_range If insufficient bytes remain in the file.
-   */
-  [[nodiscard]] double read_f64() { return std::bit_cast<double>(read_u64()); }
-
-  /**
-   * @brief Reads raw bytes into a destination buffer.
-   *
-   * @param dest Pointer to the destination buffer.
-   * @param bytes Number of bytes to read.
-   * @throws std::invalid_argument If dest is nullptr.
-   * @throws std::out_of_range If insufficient bytes remain in the file.
-   */
-  void read_bytes(void* dest, size_t bytes) {
-    if (!dest) {
-      throw std::invalid_argument("Destination pointer cannot be null");
-    }
-
-    uint8_t* out = static_cast<uint8_t*>(dest);
-    while (bytes > 0) {
-      ensure_available(1);
-      size_t chunk = std::min(bytes, buffer_remaining());
-      std::memcpy(out, &buffer_[buffer_pos_], chunk);
-      buffer_pos_ += chunk;
-      out += chunk;
-      bytes -= chunk;
-    }
-  }
-
-  /**
-   * @brief Reads a fixed-length string from the file.
-   *
-   * @param length Number of bytes to read.
-   * @return The string read from the file.
-   * @throws std::out_of_range If insufficient bytes remain in the file.
-   */
-  [[nodiscard]] std::string read_string(size_t length) {
-    std::string result(length, '\0');
-    read_bytes(result.data(), length);
-    return result;
-  }
-
-  /**
-   * @brief Reads a null-terminated C-style string from the file.
-   *
-   * @return The string read from the file (without null terminator).
-   * @throws std::out_of_range If at end of file before null terminator.
-   * @note This implementation reads byte-by-byte for simplicity with buffering.
-   */
-  [[nodiscard]] std::string read_cstring() {
-    std::string result;
-    uint8_t ch;
-    while ((ch = read_u8()) != 0) {
-      result.push_back(static_cast<char>(ch));
-    }
-    return result;
-  }
+  void skip(size_t bytes) { set_position(this->position() + bytes); }
 
  private:
-  /**
-   * @brief Returns the number of bytes remaining in the buffer.
-   *
-   * @return Number of unread bytes in the current buffer.
-   */
-  [[nodiscard]] size_t buffer_remaining() const noexcept {
-    return buffer_end_ - buffer_pos_;
-  }
+  friend class BufferedReader<FileReader<E>, E>;
 
-  /**
-   * @brief Fills the internal buffer from the file.
-   *
-   * @throws std::runtime_error If read operation fails.
-   */
-  void fill_buffer() {
-    file_.read(reinterpret_cast<char*>(buffer_.data()), buffer_.size());
-    buffer_end_ = file_.gcount();
-    buffer_pos_ = 0;
-    file_pos_ = file_.tellg();
-
-    if (file_.bad()) {
-      throw std::runtime_error("Failed to read from file");
-    }
-  }
+  static constexpr const char* kSourceName = "file";
 
   /**
-   * @brief Ensures the specified number of bytes are available in the buffer.
+   * @brief Reads the next bytes of the file, from the read-ahead stream if
+   * enabled.
    *
-   * @param bytes Number of bytes required.
-   * @throws std::out_of_range If insufficient bytes remain in the file.
+   * @return The number of bytes read, less than `bytes` only at EOF.
    * @throws std::runtime_error If read operation fails.
    */
-  void ensure_available(size_t bytes) {
-    if (buffer_remaining() < bytes) {
-      // Move remaining bytes to start of buffer
-      if (buffer_remaining() > 0) {
-        std::memmove(buffer_.data(), &buffer_[buffer_pos_], buffer_remaining());
-      }
-      buffer_end_ = buffer_remaining();
-      buffer_pos_ = 0;
-
-      // Fill rest of buffer
-      file_.read(reinterpret_cast<char*>(&buffer_[buffer_end_]),
-                 buffer_.size() - buffer_end_);
-      buffer_end_ += file_.gcount();
-      file_pos_ = file_.tellg();
-
-      if (file_.bad()) {
-        throw std::runtime_error("Failed to read from file");
-      }
+  size_t read_source(uint8_t* dest, size_t bytes) {
+    if (read_ahead_) {
+      return read_ahead_->read(dest, bytes);
     }
 
-    if (buffer_remaining() < bytes) {
-      throw std::out_of_range("Cannot read " + std::to_string(bytes) +
-                              " bytes: reached end of file");
+    file_.read(reinterpret_cast<char*>(dest), bytes);
+    if (file_.bad()) {
+      throw std::runtime_error("Failed to read from file");
     }
+    return static_cast<size_t>(file_.gcount());
   }
 
-  /**
-   * @brief Determines the native endianness of the system.
-   *
-   * @return The system's native endianness.
-   */
-  static constexpr Endianness native_endian() noexcept {
-    return std::endian::native == std::endian::little ? Endianness::kLittle
-                                                      : Endianness::kBig;
-  }
+  std::ifstream file_;    ///< The underlying file stream.
+  size_t file_size_ = 0;  ///< Total size of the file in bytes.
 
-  std::ifstream file_;           ///< The underlying file stream.
-  std::vector<uint8_t> buffer_;  ///< Internal buffer for efficient reading.
-  size_t file_size_ = 0;         ///< Total size of the file in bytes.
-  size_t file_pos_ = 0;          ///< Current position in the file.
-  size_t buffer_pos_ = 0;        ///< Current position within the buffer.
-  size_t buffer_end_ = 0;        ///< Number of valid bytes in the buffer.
+  /// Background reader replacing file_, if read-ahead is enabled.
+  std::unique_ptr<ReadAheadStream> read_ahead_;
 };
 
 /**
@@ -0,0 +1,140 @@
+#include "BinaryWriter.hpp"
+
+#if defined(_WIN32)
+#ifndef NOMINMAX
+#define NOMINMAX
+#endif
+#ifndef WIN32_LEAN_AND_MEAN
+#define WIN32_LEAN_AND_MEAN
+#endif
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/uio.h>
+#include <unistd.h>
+
+#include <cerrno>
+#endif
+
+namespace intns::io::detail {
+
+#if defined(_WIN32)
+
+namespace {
+
+void write_all(HANDLE file, const void* data, size_t size) {
+  const auto* bytes = static_cast<const uint8_t*>(data);
+  while (size > 0) {
+    const DWORD chunk = static_cast<DWORD>(std::min<size_t>(size, 1u << 30));
+    DWORD written = 0;
+    if (!WriteFile(file, bytes, chunk, &written, nullptr) || written == 0) {
+      throw std::runtime_error("Failed to write to file");
+    }
+    bytes += written;
+    size -= written;
+  }
+}
+
+}  // namespace
+
+OutputFile::OutputFile(const std::string& filename) {
+  HANDLE file = CreateFileA(filename.c_str(), GENERIC_WRITE, 0, nullptr,
+                            CREATE_ALWAYS, FILE_ATTRIBUTE_NORMAL, nullptr);
+  if (file == INVALID_HANDLE_VALUE) {
+    throw std::runtime_error("Failed to open file: " + filename);
+  }
+  handle_ = file;
+}
+
+void OutputFile::write(const void* first, size_t first_size,
+                       const void* second, size_t second_size) {
+  // No gathered writes on plain handles, but still no intermediate copy
+  write_all(handle_, first, first_size);
+  write_all(handle_, second, second_size);
+}
+
+void OutputFile::write_at(size_t offset, const void* data, size_t size) {
+  LARGE_INTEGER end{};
+  LARGE_INTEGER target{};
+  target.QuadPart = static_cast<LONGLONG>(offset);
+  if (!SetFilePointerEx(handle_, LARGE_INTEGER{}, &end, FILE_CURRENT) ||
+      !SetFilePointerEx(handle_, target, nullptr, FILE_BEGIN)) {
+    throw std::runtime_error("Failed to seek in file");
+  }
+
+  write_all(handle_, data, size);
+  if (!SetFilePointerEx(handle_, end, nullptr, FILE_BEGIN)) {
+    throw std::runtime_error("Failed to seek in file");
+  }
+}
+
+void OutputFile::close() noexcept {
+  if (handle_) {
+    CloseHandle(handle_);
+    handle_ = nullptr;
+  }
+}
+
+#else
+
+OutputFile::OutputFile(const std::string& filename) {
+  fd_ = ::open(filename.c_str(), O_WRONLY | O_CREAT | O_TRUNC | O_CLOEXEC,
+               0644);
+  if (fd_ < 0) {
+    throw std::runtime_error("Failed to open file: " + filename);
+  }
+}
+
+void OutputFile::write(const void* first, size_t first_size,
+                       const void* second, size_t second_size) {
+  iovec parts[2] = {{const_cast<void*>(first), first_size},
+                    {const_cast<void*>(second), second_size}};
+  iovec* iov = parts;
+  int count = second_size > 0 ? 2 : 1;
+
+  // Resubmit whatever a short write left over
+  while (count > 0) {
+    const ssize_t written = ::writev(fd_, iov, count);
+    if (written < 0) {
+      if (errno == EINTR) continue;
+      throw std::runtime_error("Failed to write to file");
+    }
+
+    auto left = static_cast<size_t>(written);
+    while (count > 0 && left >= iov->iov_len) {
+      left -= iov->iov_len;
+      ++iov;
+      --count;
+    }
+    if (count > 0) {
+      iov->iov_base = static_cast<uint8_t*>(iov->iov_base) + left;
+      iov->iov_len -= left;
+    }
+  }
+}
+
+void OutputFile::write_at(size_t offset, const void* data, size_t size) {
+  const auto* bytes = static_cast<const uint8_t*>(data);
+  while (size > 0) {
+    const ssize_t written =
+        ::pwrite(fd_, bytes, size, static_cast<off_t>(offset));
+    if (written < 0) {
+      if (errno == EINTR) continue;
+      throw std::runtime_error("Failed to write to file");
+    }
+    bytes += written;
+    offset += static_cast<size_t>(written);
+    size -= static_cast<size_t>(written);
+  }
+}
+
+void OutputFile::close() noexcept {
+  if (fd_ >= 0) {
+    ::close(fd_);
+    fd_ = -1;
+  }
+}
+
+#endif
+
+}  // namespace intns::io::detail
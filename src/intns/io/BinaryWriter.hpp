@@ -0,0 +1,1015 @@
+#ifndef INTNS_IO_BINARY_WRITER_HPP
+#define INTNS_IO_BINARY_WRITER_HPP
+
+#include <algorithm>
+#include <array>
+#include <bit>
+#include <cstdint>
+#include <cstring>
+#include <span>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <type_traits>
+#include <vector>
+
+#include "../memory/MemoryResource.hpp"
+#include "ByteSwap.hpp"
+#include "IoTypes.hpp"
+#include "Schema.hpp"
+
+namespace intns::io {
+
+/**
+ * @brief A memory-based binary writer with configurable endianness.
+ *
+ * MemoryWriter is the counterpart of MemoryReader: every read_* call has a
+ * matching write_* call producing bytes it reads back. The output either
+ * grows as needed, or goes into a fixed buffer such as a span or a block
+ * taken from a StackAllocator.
+ *
+ * Writes happen at position(), so earlier bytes can be overwritten, and
+ * patch_* calls fill in offsets or lengths once they are known.
+ *
+ * @tparam E The endianness for data conversion (default: little endian).
+ *
+ * @section Usage
+ * Write a header with a length filled in afterwards:
+ * @code
+ * MemoryWriter<Endianness::kBig> writer;
+ * writer.write_u32(0x50414B31);
+ * const size_t length_at = writer.position();
+ * writer.write_u32(0);
+ * writer.write_cstring("name");
+ * writer.patch_u32(length_at, writer.size());
+ * @endcode
+ *
+ * @section Exception Safety
+ * Writes into a fixed buffer throw std::out_of_range if the buffer is too
+ * small, leaving it unchanged. Growable writers throw std::bad_alloc if out
+ * of memory.
+ */
+template <Endianness E = Endianness::kLittle>
+class MemoryWriter {
+ public:
+  /**
+   * @brief Constructs a growable MemoryWriter.
+   *
+   * @param initial_capacity Bytes to allocate up front (default: 256).
+   */
+  explicit MemoryWriter(size_t initial_capacity = 256)
+      : storage_(std::max<size_t>(initial_capacity, 1)),
+        data_(storage_.data()),
+        capacity_(storage_.size()),
+        growable_(true) {}
+
+  /**
+   * @brief Constructs a MemoryWriter writing into a fixed buffer.
+   *
+   * @param buffer The destination buffer, which must outlive the writer.
+   */
+  explicit MemoryWriter(std::span<uint8_t> buffer) noexcept
+      : data_(buffer.data()), capacity_(buffer.size()) {}
+
+  /**
+   * @brief Constructs a MemoryWriter writing into a fixed buffer taken from
+   * an allocator, e.g. a StackAllocator or ScratchFrame.
+   *
+   * @param allocator The allocator, whose block must outlive the writer.
+   * @param capacity Size of the buffer in bytes.
+   * @throws std::bad_alloc If the allocator is out of space.
+   */
+  template <memory::RawAllocator Allocator>
+  MemoryWriter(Allocator& allocator, size_t capacity)
+      : data_(static_cast<uint8_t*>(allocator.alloc(capacity, 1))),
+        capacity_(capacity) {
+    if (!data_) {
+      throw std::bad_alloc();
+    }
+  }
+
+  // Fixed buffers would be shared, growable ones would dangle
+  MemoryWriter(const MemoryWriter&) = delete;
+  MemoryWriter& operator=(const MemoryWriter&) = delete;
+
+  /**
+   * @brief Returns the number of bytes written.
+   *
+   * @return The size of the output, the furthest position written to.
+   */
+  [[nodiscard]] size_t size() const noexcept { return size_; }
+
+  /**
+   * @brief Returns the current write position.
+   *
+   * @return The position the next write goes to.
+   */
+  [[nodiscard]] size_t position() const noexcept { return position_; }
+
+  /**
+   * @brief Returns the number of bytes the buffer holds before it must grow.
+   *
+   * @return The buffer capacity in bytes.
+   */
+  [[nodiscard]] size_t capacity() const noexcept { return capacity_; }
+
+  /**
+   * @brief Checks whether the writer grows its buffer as needed.
+   *
+   * @return true for growable writers, false for fixed buffers.
+   */
+  [[nodiscard]] bool growable() const noexcept { return growable_; }
+
+  /**
+   * @brief Returns the bytes written so far.
+   *
+   * @return A view of the output, invalidated if the buffer grows.
+   */
+  [[nodiscard]] std::span<const uint8_t> data() const noexcept {
+    return {data_, size_};
+  }
+
+  /**
+   * @brief Moves the write position, to overwrite earlier output.
+   *
+   * If the specified position exceeds the size, it is clamped to the size.
+   *
+   * @param pos The new position to set.
+   * @note This method never throws.
+   */
+  void set_position(size_t pos) noexcept { position_ = std::min(pos, size_); }
+
+  /**
+   * @brief Moves the output out of a growable writer, leaving it empty.
+   *
+   * @return The bytes written.
+   * @throws std::logic_error If the writer uses a fixed buffer.
+   */
+  [[nodiscard]] std::vector<uint8_t> take() {
+    if (!growable_) {
+      throw std::logic_error("Cannot take the buffer of a fixed writer");
+    }
+    storage_.resize(size_);
+    std::vector<uint8_t> result = std::move(storage_);
+    storage_.assign(1, 0);
+    data_ = storage_.data();
+    capacity_ = storage_.size();
+    size_ = 0;
+    position_ = 0;
+    return result;
+  }
+
+  /**
+   * @brief Writes an unsigned 8-bit integer.
+   *
+   * @param value The value to write.
+   * @throws std::out_of_range If a fixed buffer is full.
+   */
+  void write_u8(uint8_t value) { put(value); }
+
+  /**
+   * @brief Writes an unsigned 16-bit integer with endianness conversion.
+   *
+   * @param value The value to write.
+   * @throws std::out_of_range If a fixed buffer is full.
+   */
+  void write_u16(uint16_t value) { put(value); }
+
+  /**
+   * @brief Writes an unsigned 32-bit integer with endianness conversion.
+   *
+   * @param value The value to write.
+   * @throws std::out_of_range If a fixed buffer is full.
+   */
+  void write_u32(uint32_t value) { put(value); }
+
+  /**
+   * @brief Writes an unsigned 64-bit integer with endianness conversion.
+   *
+   * @param value The value to write.
+   * @throws std::out_of_range If a fixed buffer is full.
+   */
+  void write_u64(uint64_t value) { put(value); }
+
+  /**
+   * @brief Writes a signed 8-bit integer.
+   *
+   * @param value The value to write.
+   * @throws std::out_of_range If a fixed buffer is full.
+   */
+  void write_s8(int8_t value) { put(value); }
+
+  /**
+   * @brief Writes a signed 16-bit integer with endianness conversion.
+   *
+   * @param value The value to write.
+   * @throws std::out_of_range If a fixed buffer is full.
+   */
+  void write_s16(int16_t value) { put(value); }
+
+  /**
+   * @brief Writes a signed 32-bit integer with endianness conversion.
+   *
+   * @param value The value to write.
+   * @throws std::out_of_range If a fixed buffer is full.
+   */
+  void write_s32(int32_t value) { put(value); }
+
+  /**
+   * @brief Writes a signed 64-bit integer with endianness conversion.
+   *
+   * @param value The value to write.
+   * @throws std::out_of_range If a fixed buffer is full.
+   */
+  void write_s64(int64_t value) { put(value); }
+
+  /**
+   * @brief Writes a 32-bit floating-point value with endianness conversion.
+   *
+   * @param value The value to write.
+   * @throws std::out_of_range If a fixed buffer is full.
+   */
+  void write_f32(float value) { put(value); }
+
+  /**
+   * @brief Writes a 64-bit floating-point value with endianness conversion.
+   *
+   * @param value The value to write.
+   * @throws std::out_of_range If a fixed buffer is full.
+   */
+  void write_f64(double value) { put(value); }
+
+  /**
+   * @brief Writes raw bytes.
+   *
+   * @param src Pointer to the source bytes.
+   * @param bytes Number of bytes to write.
+   * @throws std::invalid_argument If src is nullptr and bytes is non-zero.
+   * @throws std::out_of_range If a fixed buffer is too small.
+   */
+  void write_bytes(const void* src, size_t bytes) {
+    if (!src && bytes != 0) {
+      throw std::invalid_argument("Source pointer cannot be null");
+    }
+    std::memcpy(claim(bytes), src, bytes);
+  }
+
+  /**
+   * @brief Writes an array of unsigned 16-bit integers with endianness
+   * conversion.
+   *
+   * @param array Pointer to the source array.
+   * @param count Number of elements to write.
+   * @throws std::invalid_argument If array is nullptr.
+   * @throws std::out_of_range If a fixed buffer is too small.
+   */
+  void write_u16_array(const uint16_t* array, size_t count) {
+    write_swapped_array(array, count);
+  }
+
+  /**
+   * @brief Writes an array of unsigned 32-bit integers with endianness
+   * conversion.
+   *
+   * @param array Pointer to the source array.
+   * @param count Number of elements to write.
+   * @throws std::invalid_argument If array is nullptr.
+   * @throws std::out_of_range If a fixed buffer is too small.
+   */
+  void write_u32_array(const uint32_t* array, size_t count) {
+    write_swapped_array(array, count);
+  }
+
+  /**
+   * @brief Writes an array of unsigned 64-bit integers with endianness
+   * conversion.
+   *
+   * @param array Pointer to the source array.
+   * @param count Number of elements to write.
+   * @throws std::invalid_argument If array is nullptr.
+   * @throws std::out_of_range If a fixed buffer is too small.
+   */
+  void write_u64_array(const uint64_t* array, size_t count) {
+    write_swapped_array(array, count);
+  }
+
+  /**
+   * @brief Writes an array of 32-bit floating-point values with endianness
+   * conversion.
+   *
+   * @param array Pointer to the source array.
+   * @param count Number of elements to write.
+   * @throws std::invalid_argument If array is nullptr.
+   * @throws std::out_of_range If a fixed buffer is too small.
+   */
+  void write_f32_array(const float* array, size_t count) {
+    write_swapped_array(array, count);
+  }
+
+  /**
+   * @brief Writes an array of 64-bit floating-point values with endianness
+   * conversion.
+   *
+   * @param array Pointer to the source array.
+   * @param count Number of elements to write.
+   * @throws std::invalid_argument If array is nullptr.
+   * @throws std::out_of_range If a fixed buffer is too small.
+   */
+  void write_f64_array(const double* array, size_t count) {
+    write_swapped_array(array, count);
+  }
+
+  /**
+   * @brief Writes a string's bytes, without a terminator.
+   *
+   * @param str The string to write.
+   * @throws std::out_of_range If a fixed buffer is too small.
+   */
+  void write_string(std::string_view str) {
+    write_bytes(str.data(), str.size());
+  }
+
+  /**
+   * @brief Writes a string followed by a null terminator.
+   *
+   * @param str The string to write, which should not contain nulls.
+   * @throws std::out_of_range If a fixed buffer is too small.
+   */
+  void write_cstring(std::string_view str) {
+    uint8_t* dest = claim(str.size() + 1);
+    std::memcpy(dest, str.data(), str.size());
+    dest[str.size()] = 0;
+  }
+
+  /**
+   * @brief Writes a record or other WireType laid out as described in
+   * Schema.hpp.
+   *
+   * Collapses to a single memcpy when T's memory layout matches the wire.
+   *
+   * @param value The value to write.
+   * @throws std::out_of_range If a fixed buffer is too small.
+   */
+  template <WireType T>
+  void write(const T& value) {
+    uint8_t* dest = claim(wire_size<T>());
+    detail::encode<E>(dest, value);
+  }
+
+  /**
+   * @brief Writes consecutive records or other WireTypes.
+   *
+   * @param values The values to write.
+   * @throws std::out_of_range If a fixed buffer is too small.
+   */
+  template <WireType T>
+  void write_array(std::span<const T> values) {
+    if constexpr (has_native_layout<T, E>()) {
+      write_bytes(values.data(), values.size_bytes());
+    } else if constexpr (std::is_arithmetic_v<T>) {
+      write_swapped_array(values.data(), values.size());
+    } else {
+      uint8_t* dest = claim(wire_size<T>() * values.size());
+      for (const T& value : values) {
+        detail::encode<E>(dest, value);
+      }
+    }
+  }
+
+  /**
+   * @brief Overwrites an unsigned 16-bit integer written earlier.
+   *
+   * @param offset Position of the value.
+   * @param value The new value.
+   * @throws std::out_of_range If the value isn't within the output.
+   */
+  void patch_u16(size_t offset, uint16_t value) { patch(offset, value); }
+
+  /**
+   * @brief Overwrites an unsigned 32-bit integer written earlier.
+   *
+   * @param offset Position of the value.
+   * @param value The new value.
+   * @throws std::out_of_range If the value isn't within the output.
+   */
+  void patch_u32(size_t offset, uint32_t value) { patch(offset, value); }
+
+  /**
+   * @brief Overwrites an unsigned 64-bit integer written earlier.
+   *
+   * @param offset Position of the value.
+   * @param value The new value.
+   * @throws std::out_of_range If the value isn't within the output.
+   */
+  void patch_u64(size_t offset, uint64_t value) { patch(offset, value); }
+
+  /**
+   * @brief Overwrites a WireType written earlier, e.g. a whole header.
+   *
+   * @param offset Position of the value.
+   * @param value The new value.
+   * @throws std::out_of_range If the value isn't within the output.
+   */
+  template <WireType T>
+  void patch(size_t offset, const T& value) {
+    if (offset > size_ || wire_size<T>() > size_ - offset) {
+      throw std::out_of_range("Cannot patch " +
+                              std::to_string(wire_size<T>()) +
+                              " bytes at offset " + std::to_string(offset) +
+                              ": size is " + std::to_string(size_));
+    }
+    uint8_t* dest = data_ + offset;
+    detail::encode<E>(dest, value);
+  }
+
+ private:
+  /**
+   * @brief Writes one arithmetic value with endianness conversion.
+   */
+  template <typename T>
+  void put(T value) {
+    uint8_t* dest = claim(sizeof(T));
+    detail::encode<E>(dest, value);
+  }
+
+  /**
+   * @brief Copies `count` elements to the output and swaps them there in
+   * bulk if the endianness differs from native.
+   */
+  template <typename T>
+  void write_swapped_array(const T* array, size_t count) {
+    if (!array) {
+      throw std::invalid_argument("Array pointer cannot be null");
+    }
+    uint8_t* dest = claim(count * sizeof(T));
+    std::memcpy(dest, array, count * sizeof(T));
+    if constexpr (E != native_endianness()) {
+      detail::bswap_array<sizeof(T)>(dest, count);
+    }
+  }
+
+  /**
+   * @brief Makes room for `bytes` bytes at the write position and advances
+   * past them.
+   *
+   * @return Where to write the bytes.
+   * @throws std::out_of_range If a fixed buffer is too small.
+   */
+  [[nodiscard]] uint8_t* claim(size_t bytes) {
+    if (bytes > capacity_ - position_) [[unlikely]] {
+      grow(bytes);
+    }
+    uint8_t* dest = data_ + position_;
+    position_ += bytes;
+    size_ = std::max(size_, position_);
+    return dest;
+  }
+
+  /**
+   * @brief Grows the buffer geometrically to fit `bytes` more bytes.
+   *
+   * @throws std::out_of_range If the writer uses a fixed buffer.
+   */
+  void grow(size_t bytes) {
+    if (!growable_) {
+      throw std::out_of_range("Cannot write " + std::to_string(bytes) +
+                              " bytes: only " +
+                              std::to_string(capacity_ - position_) +
+                              " available");
+    }
+    storage_.resize(std::max(capacity_ * 2, position_ + bytes));
+    data_ = storage_.data();
+    capacity_ = storage_.size();
+  }
+
+  std::vector<uint8_t> storage_;  ///< Buffer of a growable writer.
+  uint8_t* data_ = nullptr;       ///< Start of the buffer.
+  size_t capacity_ = 0;           ///< Size of the buffer in bytes.
+  size_t size_ = 0;               ///< Furthest position written to.
+  size_t position_ = 0;           ///< Current write position.
+  bool growable_ = false;         ///< Whether the buffer may grow.
+};
+
+namespace detail {
+
+/**
+ * @brief A write-only file handle with gathered and positioned writes.
+ *
+ * Uses the OS file API directly, so FileWriter can submit its buffer and a
+ * large write in one writev call.
+ */
+class OutputFile {
+ public:
+  /**
+   * @brief Creates or truncates a file for writing.
+   *
+   * @param filename Path to the file.
+   * @throws std::runtime_error If the file cannot be opened.
+   */
+  explicit OutputFile(const std::string& filename);
+
+  ~OutputFile() { close(); }
+
+  // Owns the handle
+  OutputFile(const OutputFile&) = delete;
+  OutputFile& operator=(const OutputFile&) = delete;
+
+  /**
+   * @brief Writes two ranges, one after the other, at the end of the file.
+   * @throws std::runtime_error If the write fails.
+   */
+  void write(const void* first, size_t first_size, const void* second = nullptr,
+             size_t second_size = 0);
+
+  /**
+   * @brief Writes at an offset, without moving the end of the file.
+   * @throws std::runtime_error If the write fails.
+   */
+  void write_at(size_t offset, const void* data, size_t size);
+
+  /**
+   * @brief Closes the file; safe to call more than once.
+   */
+  void close() noexcept;
+
+ private:
+#if defined(_WIN32)
+  void* handle_ = nullptr;  ///< The Windows file HANDLE.
+#else
+  int fd_ = -1;  ///< The file descriptor.
+#endif
+};
+
+}  // namespace detail
+
+/**
+ * @brief A buffered file-based binary writer with configurable endianness.
+ *
+ * FileWriter is the counterpart of FileReader, with the same write_* calls
+ * as MemoryWriter. Writes collect in a large buffer that is written out when
+ * full; writes bigger than the buffer go out together with it in a single
+ * gathered (writev) call instead of being copied.
+ *
+ * @tparam E The endianness for data conversion (default: little endian).
+ *
+ * @section Exception Safety
+ * Constructor throws std::runtime_error if the file cannot be opened. Writes
+ * and flush() throw std::runtime_error if the OS write fails. The destructor
+ * flushes and swallows errors; call flush() first to see them.
+ */
+template <Endianness E = Endianness::kLittle>
+class FileWriter {
+ public:
+  /**
+   * @brief Creates or truncates the specified file for writing.
+   *
+   * @param filename Path to the file to write.
+   * @param buffer_size Size of the internal buffer (default: 64 KiB).
+   * @throws std::runtime_error If the file cannot be opened.
+   * @throws std::invalid_argument If buffer_size is 0.
+   */
+  explicit FileWriter(const std::string& filename,
+                      size_t buffer_size = 64 * 1024)
+      : file_(filename), buffer_(buffer_size) {
+    if (buffer_size == 0) {
+      throw std::invalid_argument("Buffer size cannot be zero");
+    }
+  }
+
+  /**
+   * @brief Flushes any buffered output, ignoring errors.
+   */
+  ~FileWriter() {
+    try {
+      flush();
+    } catch (...) {
+      // Destructors can't report errors, flush() explicitly to see them
+    }
+  }
+
+  // Owns the file and its buffered output
+  FileWriter(const FileWriter&) = delete;
+  FileWriter& operator=(const FileWriter&) = delete;
+
+  /**
+   * @brief Returns the current write position in the file.
+   *
+   * @return The number of bytes written, flushed or not.
+   */
+  [[nodiscard]] size_t position() const noexcept {
+    return file_pos_ + buffer_used_;
+  }
+
+  /**
+   * @brief Returns the number of bytes written, flushed or not.
+   *
+   * @return The size the file will have once flushed.
+   */
+  [[nodiscard]] size_t size() const noexcept { return position(); }
+
+  /**
+   * @brief Writes out any buffered bytes.
+   *
+   * @throws std::runtime_error If the write fails.
+   */
+  void flush() {
+    if (buffer_used_ > 0) {
+      file_.write(buffer_.data(), buffer_used_);
+      file_pos_ += buffer_used_;
+      buffer_used_ = 0;
+    }
+  }
+
+  /**
+   * @brief Writes an unsigned 8-bit integer.
+   *
+   * @param value The value to write.
+   * @throws std::runtime_error If a flush fails.
+   */
+  void write_u8(uint8_t value) { put(value); }
+
+  /**
+   * @brief Writes an unsigned 16-bit integer with endianness conversion.
+   *
+   * @param value The value to write.
+   * @throws std::runtime_error If a flush fails.
+   */
+  void write_u16(uint16_t value) { put(value); }
+
+  /**
+   * @brief Writes an unsigned 32-bit integer with endianness conversion.
+   *
+   * @param value The value to write.
+   * @throws std::runtime_error If a flush fails.
+   */
+  void write_u32(uint32_t value) { put(value); }
+
+  /**
+   * @brief Writes an unsigned 64-bit integer with endianness conversion.
+   *
+   * @param value The value to write.
+   * @throws std::runtime_error If a flush fails.
+   */
+  void write_u64(uint64_t value) { put(value); }
+
+  /**
+   * @brief Writes a signed 8-bit integer.
+   *
+   * @param value The value to write.
+   * @throws std::runtime_error If a flush fails.
+   */
+  void write_s8(int8_t value) { put(value); }
+
+  /**
+   * @brief Writes a signed 16-bit integer with endianness conversion.
+   *
+   * @param value The value to write.
+   * @throws std::runtime_error If a flush fails.
+   */
+  void write_s16(int16_t value) { put(value); }
+
+  /**
+   * @brief Writes a signed 32-bit integer with endianness conversion.
+   *
+   * @param value The value to write.
+   * @throws std::runtime_error If a flush fails.
+   */
+  void write_s32(int32_t value) { put(value); }
+
+  /**
+   * @brief Writes a signed 64-bit integer with endianness conversion.
+   *
+   * @param value The value to write.
+   * @throws std::runtime_error If a flush fails.
+   */
+  void write_s64(int64_t value) { put(value); }
+
+  /**
+   * @brief Writes a 32-bit floating-point value with endianness conversion.
+   *
+   * @param value The value to write.
+   * @throws std::runtime_error If a flush fails.
+   */
+  void write_f32(float value) { put(value); }
+
+  /**
+   * @brief Writes a 64-bit floating-point value with endianness conversion.
+   *
+   * @param value The value to write.
+   * @throws std::runtime_error If a flush fails.
+   */
+  void write_f64(double value) { put(value); }
+
+  /**
+   * @brief Writes raw bytes.
+   *
+   * Bytes that fit are buffered; larger writes are submitted together with
+   * the buffer in one gathered write, without copying.
+   *
+   * @param src Pointer to the source bytes.
+   * @param bytes Number of bytes to write.
+   * @throws std::invalid_argument If src is nullptr and bytes is non-zero.
+   * @throws std::runtime_error If the write fails.
+   */
+  void write_bytes(const void* src, size_t bytes) {
+    if (!src && bytes != 0) {
+      throw std::invalid_argument("Source pointer cannot be null");
+    }
+
+    if (bytes <= buffer_free()) {
+      std::memcpy(buffer_.data() + buffer_used_, src, bytes);
+      buffer_used_ += bytes;
+      return;
+    }
+
+    const auto* in = static_cast<const uint8_t*>(src);
+    if (bytes >= buffer_.size()) {
+      file_.write(buffer_.data(), buffer_used_, in, bytes);
+      file_pos_ += buffer_used_ + bytes;
+      buffer_used_ = 0;
+      return;
+    }
+
+    // Top the buffer up, write it out and buffer the rest
+    const size_t head = buffer_free();
+    std::memcpy(buffer_.data() + buffer_used_, in, head);
+    buffer_used_ += head;
+    flush();
+    std::memcpy(buffer_.data(), in + head, bytes - head);
+    buffer_used_ = bytes - head;
+  }
+
+  /**
+   * @brief Writes an array of unsigned 16-bit integers with endianness
+   * conversion.
+   *
+   * @param array Pointer to the source array.
+   * @param count Number of elements to write.
+   * @throws std::invalid_argument If array is nullptr.
+   * @throws std::runtime_error If the write fails.
+   */
+  void write_u16_array(const uint16_t* array, size_t count) {
+    write_swapped_array(array, count);
+  }
+
+  /**
+   * @brief Writes an array of unsigned 32-bit integers with endianness
+   * conversion.
+   *
+   * @param array Pointer to the source array.
+   * @param count Number of elements to write.
+   * @throws std::invalid_argument If array is nullptr.
+   * @throws std::runtime_error If the write fails.
+   */
+  void write_u32_array(const uint32_t* array, size_t count) {
+    write_swapped_array(array, count);
+  }
+
+  /**
+   * @brief Writes an array of unsigned 64-bit integers with endianness
+   * conversion.
+   *
+   * @param array Pointer to the source array.
+   * @param count Number of elements to write.
+   * @throws std::invalid_argument If array is nullptr.
+   * @throws std::runtime_error If the write fails.
+   */
+  void write_u64_array(const uint64_t* array, size_t count) {
+    write_swapped_array(array, count);
+  }
+
+  /**
+   * @brief Writes an array of 32-bit floating-point values with endianness
+   * conversion.
+   *
+   * @param array Pointer to the source array.
+   * @param count Number of elements to write.
+   * @throws std::invalid_argument If array is nullptr.
+   * @throws std::runtime_error If the write fails.
+   */
+  void write_f32_array(const float* array, size_t count) {
+    write_swapped_array(array, count);
+  }
+
+  /**
+   * @brief Writes an array of 64-bit floating-point values with endianness
+   * conversion.
+   *
+   * @param array Pointer to the source array.
+   * @param count Number of elements to write.
+   * @throws std::invalid_argument If array is nullptr.
+   * @throws std::runtime_error If the write fails.
+   */
+  void write_f64_array(const double* array, size_t count) {
+    write_swapped_array(array, count);
+  }
+
+  /**
+   * @brief Writes a string's bytes, without a terminator.
+   *
+   * @param str The string to write.
+   * @throws std::runtime_error If the write fails.
+   */
+  void write_string(std::string_view str) {
+    write_bytes(str.data(), str.size());
+  }
+
+  /**
+   * @brief Writes a string followed by a null terminator.
+   *
+   * @param str The string to write, which should not contain nulls.
+   * @throws std::runtime_error If the write fails.
+   */
+  void write_cstring(std::string_view str) {
+    write_bytes(str.data(), str.size());
+    write_u8(0);
+  }
+
+  /**
+   * @brief Writes a record or other WireType laid out as described in
+   * Schema.hpp, encoding it straight into the buffer where it fits.
+   *
+   * @param value The value to write.
+   * @throws std::runtime_error If the write fails.
+   */
+  template <WireType T>
+  void write(const T& value) {
+    constexpr size_t kSize = wire_size<T>();
+    if (kSize > buffer_free()) {
+      if (kSize > buffer_.size()) {
+        std::array<uint8_t, kSize> bytes;
+        uint8_t* dest = bytes.data();
+        detail::encode<E>(dest, value);
+        write_bytes(bytes.data(), kSize);
+        return;
+      }
+      flush();
+    }
+
+    uint8_t* dest = buffer_.data() + buffer_used_;
+    detail::encode<E>(dest, value);
+    buffer_used_ += kSize;
+  }
+
+  /**
+   * @brief Writes consecutive records or other WireTypes.
+   *
+   * @param values The values to write.
+   * @throws std::runtime_error If the write fails.
+   */
+  template <WireType T>
+  void write_array(std::span<const T> values) {
+    if constexpr (has_native_layout<T, E>()) {
+      write_bytes(values.data(), values.size_bytes());
+    } else if constexpr (std::is_arithmetic_v<T>) {
+      write_swapped_array(values.data(), values.size());
+    } else {
+      for (const T& value : values) {
+        write(value);
+      }
+    }
+  }
+
+  /**
+   * @brief Overwrites an unsigned 16-bit integer written earlier.
+   *
+   * @param offset Position of the value.
+   * @param value The new value.
+   * @throws std::out_of_range If the value isn't within the output.
+   * @throws std::runtime_error If the write fails.
+   */
+  void patch_u16(size_t offset, uint16_t value) { patch(offset, value); }
+
+  /**
+   * @brief Overwrites an unsigned 32-bit integer written earlier.
+   *
+   * @param offset Position of the value.
+   * @param value The new value.
+   * @throws std::out_of_range If the value isn't within the output.
+   * @throws std::runtime_error If the write fails.
+   */
+  void patch_u32(size_t offset, uint32_t value) { patch(offset, value); }
+
+  /**
+   * @brief Overwrites an unsigned 64-bit integer written earlier.
+   *
+   * @param offset Position of the value.
+   * @param value The new value.
+   * @throws std::out_of_range If the value isn't within the output.
+   * @throws std::runtime_error If the write fails.
+   */
+  void patch_u64(size_t offset, uint64_t value) { patch(offset, value); }
+
+  /**
+   * @brief Overwrites a WireType written earlier, in the buffer if it is
+   * still there or in the file otherwise.
+   *
+   * @param offset Position of the value.
+   * @param value The new value.
+   * @throws std::out_of_range If the value isn't within the output.
+   * @throws std::runtime_error If the write fails.
+   */
+  template <WireType T>
+  void patch(size_t offset, const T& value) {
+    constexpr size_t kSize = wire_size<T>();
+    if (offset > position() || kSize > position() - offset) {
+      throw std::out_of_range("Cannot patch " + std::to_string(kSize) +
+                              " bytes at offset " + std::to_string(offset) +
+                              ": size is " + std::to_string(position()));
+    }
+
+    std::array<uint8_t, kSize> bytes;
+    uint8_t* dest = bytes.data();
+    detail::encode<E>(dest, value);
+
+    // The patch may straddle the flushed part and the buffer
+    size_t done = 0;
+    if (offset < file_pos_) {
+      done = std::min(kSize, file_pos_ - offset);
+      file_.write_at(offset, bytes.data(), done);
+    }
+    if (done < kSize) {
+      std::memcpy(buffer_.data() + (offset + done - file_pos_),
+                  bytes.data() + done, kSize - done);
+    }
+  }
+
+ private:
+  /**
+   * @brief Returns the number of bytes the buffer can take before flushing.
+   */
+  [[nodiscard]] size_t buffer_free() const noexcept {
+    return buffer_.size() - buffer_used_;
+  }
+
+  /**
+   * @brief Writes one arithmetic value with endianness conversion.
+   */
+  template <typename T>
+  void put(T value) {
+    if (sizeof(T) > buffer_free()) [[unlikely]] {
+      flush();
+    }
+    uint8_t* dest = buffer_.data() + buffer_used_;
+    detail::encode<E>(dest, value);
+    buffer_used_ += sizeof(T);
+  }
+
+  /**
+   * @brief Copies `count` elements into the buffer a buffer at a time,
+   * swapping them there in bulk if the endianness differs from native.
+   */
+  template <typename T>
+  void write_swapped_array(const T* array, size_t count) {
+    if (!array) {
+      throw std::invalid_argument("Array pointer cannot be null");
+    }
+
+    if constexpr (E == native_endianness()) {
+      write_bytes(array, count * sizeof(T));
+    } else {
+      while (count > 0) {
+        if (buffer_free() < sizeof(T)) {
+          flush();
+        }
+
+        const size_t n = std::min(count, buffer_free() / sizeof(T));
+        uint8_t* dest = buffer_.data() + buffer_used_;
+        std::memcpy(dest, array, n * sizeof(T));
+        detail::bswap_array<sizeof(T)>(dest, n);
+        buffer_used_ += n * sizeof(T);
+        array += n;
+        count -= n;
+      }
+    }
+  }
+
+  detail::OutputFile file_;      ///< The underlying file.
+  std::vector<uint8_t> buffer_;  ///< Output waiting to be written.
+  size_t buffer_used_ = 0;       ///< Number of bytes in the buffer.
+  size_t file_pos_ = 0;          ///< Number of bytes already written.
+};
+
+/**
+ * @brief Type alias for little-endian memory writer.
+ */
+using LEMemoryWriter = MemoryWriter<Endianness::kLittle>;
+
+/**
+ * @brief Type alias for big-endian memory writer.
+ */
+using BEMemoryWriter = MemoryWriter<Endianness::kBig>;
+
+/**
+ * @brief Type alias for little-endian file writer.
+ */
+using LEFileWriter = FileWriter<Endianness::kLittle>;
+
+/**
+ * @brief Type alias for big-endian file writer.
+ */
+using BEFileWriter = FileWriter<Endianness::kBig>;
+
+}  // namespace intns::io
+
+#endif  // INTNS_IO_BINARY_WRITER_HPP
@@ -0,0 +1,232 @@
+#ifndef INTNS_IO_BIT_READER_HPP
+#define INTNS_IO_BIT_READER_HPP
+
+#include <algorithm>
+#include <array>
+#include <concepts>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <stdexcept>
+#include <string>
+
+#include "IoTypes.hpp"
+
+namespace intns::io {
+
+/**
+ * @brief Order in which BitReader takes the bits of each byte.
+ */
+enum class BitOrder : uint8_t {
+  kMsbFirst = 0,  // Highest bit first, as in JPEG, MPEG and most bitstreams
+  kLsbFirst       // Lowest bit first, as in Deflate
+};
+
+/**
+ * @brief Readers a BitReader can pull bytes from, i.e. MemoryReader and
+ * FileReader.
+ */
+template <typename Reader>
+concept ByteSource = requires(Reader& r, const Reader& cr, void* dest,
+                              size_t bytes) {
+  r.read_bytes(dest, bytes);
+  r.set_position(bytes);
+  { cr.position() } -> std::convertible_to<size_t>;
+  { cr.remaining() } -> std::convertible_to<size_t>;
+};
+
+/**
+ * @brief Reads bit fields of up to 64 bits from a byte reader.
+ *
+ * Bits are kept in a 64-bit buffer refilled up to 8 bytes at a time, so a
+ * field costs a shift and a mask and the reader is only called once per
+ * several fields.
+ *
+ * @tparam Reader The reader to pull bytes from, e.g. LEMemoryReader.
+ * @tparam Order Whether each byte is read from its highest or lowest bit.
+ *
+ * @section Usage
+ * @code
+ * LEMemoryReader bytes(buffer);
+ * BitReader<LEMemoryReader> bits(bytes);
+ * bool flag = bits.read_bit();
+ * uint64_t length = bits.read_bits(12);
+ * bits.sync();  // Back to byte reads after the last field
+ * uint32_t crc = bytes.read_u32();
+ * @endcode
+ *
+ * @warning The reader is ahead of the bits consumed by up to 8 bytes until
+ * sync() is called.
+ */
+template <ByteSource Reader, BitOrder Order = BitOrder::kMsbFirst>
+class BitReader {
+ public:
+  /**
+   * @brief Creates a bit reader starting at the reader's position.
+   *
+   * @param reader The byte reader, which must outlive the bit reader.
+   */
+  explicit BitReader(Reader& reader) noexcept : reader_(&reader) {}
+
+  /**
+   * @brief Returns the number of bits left in the buffer and the reader.
+   *
+   * @return The bits that can still be read.
+   */
+  [[nodiscard]] size_t bits_remaining() const noexcept {
+    return count_ + 8 * reader_->remaining();
+  }
+
+  /**
+   * @brief Reads a field of `count` bits.
+   *
+   * @param count Width of the field, from 0 to 64.
+   * @return The field, in the low `count` bits.
+   * @throws std::invalid_argument If count is greater than 64.
+   * @throws std::out_of_range If fewer than `count` bits remain.
+   */
+  [[nodiscard]] uint64_t read_bits(unsigned count) {
+    if (count > 64) {
+      throw std::invalid_argument("Cannot read " + std::to_string(count) +
+                                  " bits: at most 64 per field");
+    }
+
+    // A refill always leaves at least 57 bits, so wider fields take two
+    if (count > 56) {
+      const uint64_t first = take(32);
+      const uint64_t second = take(count - 32);
+      if constexpr (Order == BitOrder::kMsbFirst) {
+        return (first << (count - 32)) | second;
+      } else {
+        return first | (second << 32);
+      }
+    }
+    return take(count);
+  }
+
+  /**
+   * @brief Reads a single bit.
+   *
+   * @return The bit read.
+   * @throws std::out_of_range If no bits remain.
+   */
+  [[nodiscard]] bool read_bit() { return take(1) != 0; }
+
+  /**
+   * @brief Returns the next `count` bits without consuming them.
+   *
+   * @param count Width of the field, from 0 to 56.
+   * @return The field, in the low `count` bits.
+   * @throws std::invalid_argument If count is greater than 56.
+   * @throws std::out_of_range If fewer than `count` bits remain.
+   */
+  [[nodiscard]] uint64_t peek_bits(unsigned count) {
+    if (count > 56) {
+      throw std::invalid_argument("Cannot peek " + std::to_string(count) +
+                                  " bits: at most 56 per field");
+    }
+    ensure(count);
+    return extract(count);
+  }
+
+  /**
+   * @brief Discards bits up to the next byte boundary.
+   */
+  void align_to_byte() noexcept { consume(count_ % 8); }
+
+  /**
+   * @brief Aligns to the next byte boundary and moves the reader back over
+   * buffered bytes, so byte reads resume after the last field.
+   *
+   * @throws std::runtime_error If the reader fails to seek.
+   */
+  void sync() {
+    align_to_byte();
+    reader_->set_position(reader_->position() - count_ / 8);
+    buffer_ = 0;
+    count_ = 0;
+  }
+
+ private:
+  /**
+   * @brief Consumes and returns the next `count` bits, at most 56.
+   */
+  uint64_t take(unsigned count) {
+    ensure(count);
+    const uint64_t value = extract(count);
+    consume(count);
+    return value;
+  }
+
+  /**
+   * @brief Refills the buffer if it holds fewer than `count` bits.
+   */
+  void ensure(unsigned count) {
+    if (count_ >= count) {
+      return;
+    }
+
+    // Top up with whole bytes, as many as fit in the free bits
+    const size_t bytes = std::min<size_t>((64 - count_) / 8,
+                                          reader_->remaining());
+    std::array<uint8_t, 8> loaded{};
+    reader_->read_bytes(loaded.data(), bytes);
+
+    uint64_t word;
+    std::memcpy(&word, loaded.data(), 8);
+    if constexpr (Order == BitOrder::kMsbFirst) {
+      // First byte in the top bits, below the bits already buffered
+      if constexpr (native_endianness() == Endianness::kLittle) {
+        word = bswap_64(word);
+      }
+      buffer_ |= word >> count_;
+    } else {
+      // First byte in the low bits, above the bits already buffered
+      if constexpr (native_endianness() == Endianness::kBig) {
+        word = bswap_64(word);
+      }
+      buffer_ |= word << count_;
+    }
+    count_ += static_cast<unsigned>(bytes) * 8;
+
+    if (count_ < count) {
+      throw std::out_of_range("Cannot read " + std::to_string(count) +
+                              " bits: only " + std::to_string(count_) +
+                              " available");
+    }
+  }
+
+  /**
+   * @brief Returns the next `count` buffered bits, at most 56.
+   */
+  uint64_t extract(unsigned count) const noexcept {
+    if (count == 0) {
+      return 0;
+    }
+    if constexpr (Order == BitOrder::kMsbFirst) {
+      return buffer_ >> (64 - count);
+    } else {
+      return buffer_ & ((uint64_t{1} << count) - 1);
+    }
+  }
+
+  /**
+   * @brief Drops the next `count` buffered bits, at most 56.
+   */
+  void consume(unsigned count) noexcept {
+    if constexpr (Order == BitOrder::kMsbFirst) {
+      buffer_ <<= count;
+    } else {
+      buffer_ >>= count;
+    }
+    count_ -= count;
+  }
+
+  Reader* reader_;       ///< The byte reader bits are pulled from.
+  uint64_t buffer_ = 0;  ///< Buffered bits, next bit at the read end.
+  unsigned count_ = 0;   ///< Number of valid bits in buffer_.
+};
+
+}  // namespace intns::io
+
+#endif  // INTNS_IO_BIT_READER_HPP
@@ -0,0 +1,689 @@
+#ifndef INTNS_IO_BUFFERED_READER_HPP
+#define INTNS_IO_BUFFERED_READER_HPP
+
+#include <algorithm>
+#include <array>
+#include <bit>
+#include <cstdint>
+#include <cstring>
+#include <new>
+#include <span>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "../memory/MemoryResource.hpp"
+#include "../trace/Trace.hpp"
+#include "ByteSwap.hpp"
+#include "IoTypes.hpp"
+#include "ReadCursor.hpp"
+#include "Schema.hpp"
+#include "StringTable.hpp"
+#include "Varint.hpp"
+
+namespace intns::io {
+
+/**
+ * @brief The read operations of the buffered readers, FileReader and
+ * StreamReader, over a source of bytes supplied by the derived class.
+ *
+ * Data is pulled from the source into an internal buffer, so values are
+ * decoded from memory and the source is only called once per buffer.
+ *
+ * @tparam Derived The reader, providing
+ * `size_t read_source(uint8_t* dest, size_t bytes)`, which returns fewer
+ * than `bytes` bytes only at the end of the source, and `kSourceName`, the
+ * name used in error messages. If it has `remaining()`, string tables use it
+ * to reject impossible counts up front.
+ * @tparam E The endianness for data interpretation.
+ *
+ * @section Exception Safety
+ * Read operations throw std::out_of_range if attempting to read beyond the
+ * end of the source, and pass on any exception the source throws.
+ */
+template <typename Derived, Endianness E>
+class BufferedReader {
+ public:
+  /**
+   * @brief Returns the current read position in the source.
+   *
+   * @return The number of bytes before the next one read.
+   */
+  [[nodiscard]] size_t position() const noexcept {
+    return source_pos_ - buffer_remaining();
+  }
+
+  /**
+   * @brief Validates that `bytes` bytes remain and consumes them, returning
+   * an unchecked cursor over them.
+   *
+   * One bounds check and at most one refill cover every read from the
+   * cursor, e.g. a whole fixed-size header.
+   *
+   * @param bytes Number of bytes to reserve, at most the buffer size.
+   * @return A cursor over the next `bytes` bytes, valid until the next call
+   * on this reader.
+   * @throws std::invalid_argument If bytes exceeds the buffer size.
+   * @throws std::out_of_range If insufficient bytes remain.
+   */
+  [[nodiscard]] ReadCursor<E> reserve(size_t bytes) {
+    if (bytes > buffer_.size()) {
+      throw std::invalid_argument("Cannot reserve " + std::to_string(bytes) +
+                                  " bytes: buffer size is " +
+                                  std::to_string(buffer_.size()));
+    }
+    ensure_available(bytes);
+    ReadCursor<E> cursor(buffer_.data() + buffer_pos_, bytes);
+    buffer_pos_ += bytes;
+    return cursor;
+  }
+
+  /**
+   * @brief Reads an unsigned 8-bit integer.
+   *
+   * @return The value read.
+   * @throws std::out_of_range If at the end of the source.
+   */
+  [[nodiscard]] uint8_t read_u8() {
+    ensure_available(1);
+    return buffer_[buffer_pos_++];
+  }
+
+  /**
+   * @brief Reads an unsigned 16-bit integer with endianness conversion.
+   *
+   * @return The value read.
+   * @throws std::out_of_range If insufficient bytes remain.
+   */
+  [[nodiscard]] uint16_t read_u16() { return load<uint16_t>(); }
+
+  /**
+   * @brief Reads an unsigned 32-bit integer with endianness conversion.
+   *
+   * @return The value read.
+   * @throws std::out_of_range If insufficient bytes remain.
+   */
+  [[nodiscard]] uint32_t read_u32() { return load<uint32_t>(); }
+
+  /**
+   * @brief Reads an unsigned 64-bit integer with endianness conversion.
+   *
+   * @return The value read.
+   * @throws std::out_of_range If insufficient bytes remain.
+   */
+  [[nodiscard]] uint64_t read_u64() { return load<uint64_t>(); }
+
+  /**
+   * @brief Reads a signed 8-bit integer.
+   *
+   * @return The value read.
+   * @throws std::out_of_range If at the end of the source.
+   */
+  [[nodiscard]] int8_t read_s8() { return static_cast<int8_t>(read_u8()); }
+
+  /**
+   * @brief Reads a signed 16-bit integer with endianness conversion.
+   *
+   * @return The value read.
+   * @throws std::out_of_range If insufficient bytes remain.
+   */
+  [[nodiscard]] int16_t read_s16() { return static_cast<int16_t>(read_u16()); }
+
+  /**
+   * @brief Reads a signed 32-bit integer with endianness conversion.
+   *
+   * @return The value read.
+   * @throws std::out_of_range If insufficient bytes remain.
+   */
+  [[nodiscard]] int32_t read_s32() { return static_cast<int32_t>(read_u32()); }
+
+  /**
+   * @brief Reads a signed 64-bit integer with endianness conversion.
+   *
+   * @return The value read.
+   * @throws std::out_of_range If insufficient bytes remain.
+   */
+  [[nodiscard]] int64_t read_s64() { return static_cast<int64_t>(read_u64()); }
+
+  /**
+   * @brief Reads a 32-bit floating-point value with endianness conversion.
+   *
+   * @return The value read.
+   * @throws std::out_of_range If insufficient bytes remain.
+   */
+  [[nodiscard]] float read_f32() { return std::bit_cast<float>(read_u32()); }
+
+  /**
+   * @brief Reads a 64-bit floating-point value with endianness conversion.
+   *
+   * @return The value read.
+   * @throws std::out_of_range If insufficient bytes remain.
+   */
+  [[nodiscard]] double read_f64() { return std::bit_cast<double>(read_u64()); }
+
+  /**
+   * @brief Reads an unsigned LEB128 variable-length integer.
+   *
+   * Values of up to 8 bytes are decoded from a single 8-byte load.
+   *
+   * @return The value read.
+   * @throws std::out_of_range If the source ends within the value.
+   * @throws std::runtime_error If the value is longer than 10 bytes or does
+   * not fit in 64 bits.
+   */
+  [[nodiscard]] uint64_t read_uleb128() { return read_leb128<false>(); }
+
+  /**
+   * @brief Reads a signed LEB128 variable-length integer.
+   *
+   * @return The value read.
+   * @throws std::out_of_range If the source ends within the value.
+   * @throws std::runtime_error If the value is longer than 10 bytes or does
+   * not fit in 64 bits.
+   */
+  [[nodiscard]] int64_t read_sleb128() {
+    return static_cast<int64_t>(read_leb128<true>());
+  }
+
+  /**
+   * @brief Reads a zigzag-encoded signed integer stored as unsigned LEB128,
+   * as used by Protocol Buffers.
+   *
+   * @return The value read.
+   * @throws std::out_of_range If the source ends within the value.
+   * @throws std::runtime_error If the value is longer than 10 bytes or does
+   * not fit in 64 bits.
+   */
+  [[nodiscard]] int64_t read_zigzag() { return zigzag_decode(read_uleb128()); }
+
+  /**
+   * @brief Reads raw bytes into a destination buffer.
+   *
+   * Reads larger than the buffer go straight from the source to `dest`
+   * once the buffered bytes are used up.
+   *
+   * @param dest Pointer to the destination buffer.
+   * @param bytes Number of bytes to read.
+   * @throws std::invalid_argument If dest is nullptr.
+   * @throws std::out_of_range If insufficient bytes remain.
+   */
+  void read_bytes(void* dest, size_t bytes) {
+    if (!dest) {
+      throw std::invalid_argument("Destination pointer cannot be null");
+    }
+
+    auto* out = static_cast<uint8_t*>(dest);
+    const size_t buffered = std::min(bytes, buffer_remaining());
+    std::memcpy(out, buffer_.data() + buffer_pos_, buffered);
+    buffer_pos_ += buffered;
+    out += buffered;
+    bytes -= buffered;
+
+    if (bytes >= buffer_.size()) {
+      const size_t got = derived().read_source(out, bytes);
+      source_pos_ += got;
+      if (got < bytes) {
+        throw_end_reached(bytes);
+      }
+      return;
+    }
+
+    if (bytes > 0) {
+      ensure_available(bytes);
+      std::memcpy(out, buffer_.data() + buffer_pos_, bytes);
+      buffer_pos_ += bytes;
+    }
+  }
+
+  /**
+   * @brief Reads an array of unsigned 16-bit integers with endianness
+   * conversion.
+   *
+   * @param array Pointer to the destination array.
+   * @param count Number of elements to read.
+   * @throws std::invalid_argument If array is nullptr.
+   * @throws std::out_of_range If insufficient bytes remain.
+   */
+  void read_u16_array(uint16_t* array, size_t count) {
+    read_swapped_array(array, count);
+  }
+
+  /**
+   * @brief Reads an array of unsigned 32-bit integers with endianness
+   * conversion.
+   *
+   * @param array Pointer to the destination array.
+   * @param count Number of elements to read.
+   * @throws std::invalid_argument If array is nullptr.
+   * @throws std::out_of_range If insufficient bytes remain.
+   */
+  void read_u32_array(uint32_t* array, size_t count) {
+    read_swapped_array(array, count);
+  }
+
+  /**
+   * @brief Reads an array of unsigned 64-bit integers with endianness
+   * conversion.
+   *
+   * @param array Pointer to the destination array.
+   * @param count Number of elements to read.
+   * @throws std::invalid_argument If array is nullptr.
+   * @throws std::out_of_range If insufficient bytes remain.
+   */
+  void read_u64_array(uint64_t* array, size_t count) {
+    read_swapped_array(array, count);
+  }
+
+  /**
+   * @brief Reads an array of 32-bit floating-point values with endianness
+   * conversion.
+   *
+   * @param array Pointer to the destination array.
+   * @param count Number of elements to read.
+   * @throws std::invalid_argument If array is nullptr.
+   * @throws std::out_of_range If insufficient bytes remain.
+   */
+  void read_f32_array(float* array, size_t count) {
+    read_swapped_array(array, count);
+  }
+
+  /**
+   * @brief Reads an array of 64-bit floating-point values with endianness
+   * conversion.
+   *
+   * @param array Pointer to the destination array.
+   * @param count Number of elements to read.
+   * @throws std::invalid_argument If array is nullptr.
+   * @throws std::out_of_range If insufficient bytes remain.
+   */
+  void read_f64_array(double* array, size_t count) {
+    read_swapped_array(array, count);
+  }
+
+  /**
+   * @brief Reads a fixed-length string.
+   *
+   * @param length Number of bytes to read.
+   * @return The string read.
+   * @throws std::out_of_range If insufficient bytes remain.
+   */
+  [[nodiscard]] std::string read_string(size_t length) {
+    std::string result(length, '\0');
+    read_bytes(result.data(), length);
+    return result;
+  }
+
+  /**
+   * @brief Reads a null-terminated C-style string.
+   *
+   * The terminator is found with a memchr scan over the buffer, refilling it
+   * as needed, so strings are copied out once rather than byte by byte.
+   *
+   * @return The string read (without null terminator).
+   * @throws std::out_of_range If the source ends before the terminator.
+   */
+  [[nodiscard]] std::string read_cstring() {
+    std::string spill;
+    const std::string_view view = next_cstring(spill);
+    if (view.data() == spill.data()) {
+      return spill;
+    }
+    return std::string(view);
+  }
+
+  /**
+   * @brief Reads `count` consecutive null-terminated strings in one pass.
+   *
+   * The strings are copied back to back, terminators included, into a
+   * single block owned by the returned table.
+   *
+   * @param count Number of strings to read.
+   * @return The table of strings.
+   * @throws std::out_of_range If the source ends before `count`
+   * terminators.
+   */
+  [[nodiscard]] StringTable read_cstring_table(size_t count) {
+    std::vector<char> storage;
+    std::vector<size_t> lengths;
+    if constexpr (knows_remaining()) {
+      lengths.reserve(std::min(count, derived().remaining()));
+    }
+
+    std::string spill;
+    for (size_t i = 0; i < count; ++i) {
+      const std::string_view view = next_cstring(spill);
+      storage.insert(storage.end(), view.begin(), view.end());
+      storage.push_back('\0');
+      lengths.push_back(view.size());
+    }
+    return StringTable(std::move(storage), lengths);
+  }
+
+  /**
+   * @brief Reads `count` consecutive null-terminated strings in one pass,
+   * copying them and their table of views into an allocator's storage, e.g.
+   * a StackAllocator frame.
+   *
+   * Each string is kept null-terminated, so its data() can be passed to C
+   * APIs.
+   *
+   * @param count Number of strings to read.
+   * @param allocator Allocator for the views and the strings.
+   * @return The views, valid as long as the allocations are.
+   * @throws std::out_of_range If the source ends before `count`
+   * terminators.
+   * @throws std::bad_alloc If the allocator is out of space.
+   */
+  template <memory::RawAllocator Allocator>
+  [[nodiscard]] std::span<std::string_view> read_cstring_table(
+      size_t count, Allocator& allocator) {
+    if constexpr (knows_remaining()) {
+      const size_t remaining = derived().remaining();
+      if (count > remaining) {
+        throw std::out_of_range("Cannot read " + std::to_string(count) +
+                                " strings: only " + std::to_string(remaining) +
+                                " bytes left in " + Derived::kSourceName);
+      }
+    }
+    auto* views = static_cast<std::string_view*>(allocator.alloc(
+        count * sizeof(std::string_view), alignof(std::string_view)));
+    if (!views && count > 0) {
+      throw std::bad_alloc();
+    }
+
+    std::string spill;
+    for (size_t i = 0; i < count; ++i) {
+      const std::string_view view = next_cstring(spill);
+      auto* copy = static_cast<char*>(allocator.alloc(view.size() + 1, 1));
+      if (!copy) {
+        throw std::bad_alloc();
+      }
+      std::memcpy(copy, view.data(), view.size());
+      copy[view.size()] = '\0';
+      new (&views[i]) std::string_view(copy, view.size());
+    }
+    return std::span<std::string_view>(views, count);
+  }
+
+  /**
+   * @brief Reads a record or other WireType laid out as described in
+   * Schema.hpp.
+   *
+   * Collapses to a single copy when T's memory layout matches the wire.
+   *
+   * @tparam T The type to read.
+   * @return The value read.
+   * @throws std::out_of_range If insufficient bytes remain.
+   */
+  template <WireType T>
+  [[nodiscard]] T read() {
+    T value{};
+    if constexpr (has_native_layout<T, E>()) {
+      read_bytes(&value, sizeof(T));
+    } else {
+      std::array<uint8_t, wire_size<T>()> bytes;
+      read_bytes(bytes.data(), bytes.size());
+      const uint8_t* src = bytes.data();
+      detail::decode<E>(src, value);
+    }
+    return value;
+  }
+
+  /**
+   * @brief Reads consecutive records or other WireTypes.
+   *
+   * Collapses to a single copy when T's memory layout matches the wire, and
+   * uses the bulk swap kernels for arithmetic types.
+   *
+   * @param values Destination for the values; its size is the count read.
+   * @throws std::out_of_range If insufficient bytes remain.
+   */
+  template <WireType T>
+  void read_array(std::span<T> values) {
+    if constexpr (has_native_layout<T, E>()) {
+      read_bytes(values.data(), values.size_bytes());
+    } else if constexpr (std::is_arithmetic_v<T>) {
+      read_swapped_array(values.data(), values.size());
+    } else {
+      for (T& value : values) {
+        value = read<T>();
+      }
+    }
+  }
+
+ protected:
+  /**
+   * @brief Allocates the buffer; nothing is read until the first call.
+   *
+   * @param buffer_size Size of the internal buffer.
+   * @param min_size Smallest buffer used, if buffer_size is smaller.
+   * @throws std::invalid_argument If buffer_size is 0.
+   */
+  explicit BufferedReader(size_t buffer_size, size_t min_size = 1)
+      : buffer_(std::max(buffer_size, min_size)) {
+    if (buffer_size == 0) {
+      throw std::invalid_argument("Buffer size cannot be zero");
+    }
+  }
+
+  ~BufferedReader() = default;
+
+  /**
+   * @brief Returns the number of bytes remaining in the buffer.
+   */
+  [[nodiscard]] size_t buffer_remaining() const noexcept {
+    return buffer_end_ - buffer_pos_;
+  }
+
+  /**
+   * @brief Drops the buffered bytes after the source moved to `position`,
+   * and fills the buffer from there.
+   *
+   * @param position The source's new position.
+   */
+  void restart(size_t position) {
+    buffer_pos_ = 0;
+    buffer_end_ = 0;
+    source_pos_ = position;
+    refill();
+  }
+
+  /**
+   * @brief Reads and discards bytes through the buffer.
+   *
+   * @param bytes The number of bytes to discard.
+   * @throws std::out_of_range If the source ends first.
+   */
+  void discard(size_t bytes) {
+    while (bytes > 0) {
+      ensure_available(1);
+      const size_t chunk = std::min(bytes, buffer_remaining());
+      buffer_pos_ += chunk;
+      bytes -= chunk;
+    }
+  }
+
+  /**
+   * @brief Moves the unread bytes to the start of the buffer and fills the
+   * rest from the source.
+   *
+   * @return The number of bytes read, 0 at the end of the source or if the
+   * buffer is full.
+   */
+  size_t refill() {
+    INTNS_TRACE_ZONE("BufferedReader::refill");
+
+    if (buffer_remaining() > 0 && buffer_pos_ > 0) {
+      std::memmove(buffer_.data(), &buffer_[buffer_pos_], buffer_remaining());
+    }
+    buffer_end_ = buffer_remaining();
+    buffer_pos_ = 0;
+
+    const size_t got = derived().read_source(&buffer_[buffer_end_],
+                                             buffer_.size() - buffer_end_);
+    buffer_end_ += got;
+    source_pos_ += got;
+    return got;
+  }
+
+  /**
+   * @brief Ensures the specified number of bytes are available in the buffer.
+   *
+   * @param bytes Number of bytes required, at most the buffer size.
+   * @throws std::out_of_range If insufficient bytes remain in the source.
+   */
+  void ensure_available(size_t bytes) {
+    if (buffer_remaining() < bytes) {
+      refill();
+    }
+
+    if (buffer_remaining() < bytes) {
+      throw_end_reached(bytes);
+    }
+  }
+
+ private:
+  // Whether Derived has remaining(); checked once Derived is complete
+  static constexpr bool knows_remaining() noexcept {
+    return requires(const Derived& reader) { reader.remaining(); };
+  }
+
+  Derived& derived() noexcept { return static_cast<Derived&>(*this); }
+
+  [[noreturn]] static void throw_end_reached(size_t bytes) {
+    throw std::out_of_range("Cannot read " + std::to_string(bytes) +
+                            " bytes: reached end of " + Derived::kSourceName);
+  }
+
+  /**
+   * @brief Reads a T from the buffer with endianness conversion.
+   */
+  template <typename T>
+  [[nodiscard]] T load() {
+    ensure_available(sizeof(T));
+    T value;
+    std::memcpy(&value, buffer_.data() + buffer_pos_, sizeof(T));
+    buffer_pos_ += sizeof(T);
+    if constexpr (E != native_endianness()) {
+      if constexpr (sizeof(T) == 2) {
+        value = bswap_16(value);
+      } else if constexpr (sizeof(T) == 4) {
+        value = bswap_32(value);
+      } else {
+        value = bswap_64(value);
+      }
+    }
+    return value;
+  }
+
+  /**
+   * @brief Reads `count` elements into `array`, swapping them in bulk if the
+   * endianness differs from native.
+   */
+  template <typename T>
+  void read_swapped_array(T* array, size_t count) {
+    if (!array) {
+      throw std::invalid_argument("Array pointer cannot be null");
+    }
+    read_bytes(array, count * sizeof(T));
+    if constexpr (E != native_endianness()) {
+      bswap_inplace(std::span<T>(array, count));
+    }
+  }
+
+  /**
+   * @brief Decodes a LEB128 value from the buffer, refilling it first if a
+   * whole value might not be buffered.
+   */
+  template <bool Signed>
+  uint64_t read_leb128() {
+    if (buffer_remaining() < kMaxLeb128Bytes) {
+      refill();
+    }
+
+    uint64_t value;
+    size_t used = detail::decode_leb128<Signed>(buffer_.data() + buffer_pos_,
+                                                buffer_remaining(), value);
+    if (used == 0 && buffer_.size() < kMaxLeb128Bytes &&
+        buffer_remaining() == buffer_.size()) {
+      // The buffer is too small to hold the value, gather it byte by byte
+      std::array<uint8_t, kMaxLeb128Bytes> bytes;
+      size_t count = 0;
+      do {
+        bytes[count] = read_u8();
+      } while ((bytes[count++] & 0x80) && count < bytes.size());
+
+      used = detail::decode_leb128<Signed>(bytes.data(), count, value);
+      if (used == 0) {
+        detail::throw_bad_leb128(count);
+      }
+      return value;
+    }
+
+    if (used == 0) {
+      detail::throw_bad_leb128(buffer_remaining());
+    }
+    buffer_pos_ += used;
+    return value;
+  }
+
+  /**
+   * @brief Consumes the next null-terminated string and its terminator.
+   *
+   * Each byte is scanned once: after a refill, only the newly read bytes
+   * are searched. A string longer than the buffer is gathered in `spill`.
+   *
+   * @param spill Scratch storage for strings that do not fit the buffer.
+   * @return A view of the string, into the buffer and valid until the next
+   * read, or into `spill`.
+   * @throws std::out_of_range If the source ends before the terminator.
+   */
+  std::string_view next_cstring(std::string& spill) {
+    bool spilled = false;
+    size_t scanned = 0;  // Unread bytes already known to hold no terminator
+    for (;;) {
+      const auto* start =
+          reinterpret_cast<const char*>(buffer_.data() + buffer_pos_);
+      const auto* end = static_cast<const char*>(
+          std::memchr(start + scanned, 0, buffer_remaining() - scanned));
+
+      if (end) {
+        const std::string_view view(start, static_cast<size_t>(end - start));
+        buffer_pos_ += view.size() + 1;
+        if (!spilled) {
+          return view;
+        }
+        spill.append(view);
+        return spill;
+      }
+      scanned = buffer_remaining();
+
+      // The string fills the whole buffer, so move it out to make room
+      if (scanned == buffer_.size()) {
+        if (!spilled) {
+          spill.clear();
+          spilled = true;
+        }
+        spill.append(start, scanned);
+        buffer_pos_ = buffer_end_;
+        scanned = 0;
+      }
+
+      if (refill() == 0) {
+        throw std::out_of_range(
+            std::string("Cannot read C string: reached end of ") +
+            Derived::kSourceName + " before terminator");
+      }
+    }
+  }
+
+  std::vector<uint8_t> buffer_;  ///< Internal buffer for efficient reading.
+  size_t source_pos_ = 0;        ///< Bytes pulled from the source so far.
+  size_t buffer_pos_ = 0;        ///< Current position within the buffer.
+  size_t buffer_end_ = 0;        ///< Number of valid bytes in the buffer.
+};
+
+}  // namespace intns::io
+
+#endif  // INTNS_IO_BUFFERED_READER_HPP
@@ -0,0 +1,232 @@
+#include "ByteSwap.hpp"
+
+#include <array>
+#include <cstdint>
+#include <cstring>
+
+#if defined(__x86_64__) || defined(_M_X64) || defined(__i386__) || \
+    defined(_M_IX86)
+#define INTNS_BSWAP_X86 1
+#include <immintrin.h>
+#if defined(_MSC_VER) && !defined(__clang__)
+#include <intrin.h>
+#endif
+#elif defined(__ARM_NEON) || defined(_M_ARM64)
+#define INTNS_BSWAP_NEON 1
+#include <arm_neon.h>
+#endif
+
+// GCC and Clang only emit instructions the build enables, unless told to
+#if defined(INTNS_BSWAP_X86) && (defined(__GNUC__) || defined(__clang__))
+#define INTNS_BSWAP_TARGET(isa) __attribute__((target(isa)))
+#else
+#define INTNS_BSWAP_TARGET(isa)
+#endif
+
+namespace intns::io {
+
+namespace {
+
+enum class Kernel : uint8_t {
+  kScalar = 0,  // Portable loop
+  kSsse3,       // 16 bytes per pshufb
+  kAvx2,        // 32 bytes per vpshufb
+  kNeon         // 16 bytes per vrev
+};
+
+// Byte shuffle reversing each `Width` byte element, repeated to fill 32 bytes
+template <size_t Width>
+constexpr std::array<uint8_t, 32> make_mask() noexcept {
+  std::array<uint8_t, 32> mask{};
+  for (size_t i = 0; i < mask.size(); ++i) {
+    mask[i] = static_cast<uint8_t>((i % 16) / Width * Width +
+                                   (Width - 1 - i % Width));
+  }
+  return mask;
+}
+
+template <size_t Width>
+constexpr std::array<uint8_t, 32> kMask = make_mask<Width>();
+
+template <typename U>
+U swap_value(U value) noexcept {
+  if constexpr (sizeof(U) == 2) {
+    return bswap_16(value);
+  } else if constexpr (sizeof(U) == 4) {
+    return bswap_32(value);
+  } else {
+    return bswap_64(value);
+  }
+}
+
+// Elements may be floats or unaligned, so go through memcpy
+template <typename U>
+void scalar_swap(unsigned char* bytes, size_t count) noexcept {
+  for (size_t i = 0; i < count; ++i) {
+    U value;
+    std::memcpy(&value, bytes + i * sizeof(U), sizeof(U));
+    value = swap_value(value);
+    std::memcpy(bytes + i * sizeof(U), &value, sizeof(U));
+  }
+}
+
+#if defined(INTNS_BSWAP_X86)
+
+// Each SIMD kernel swaps whole vectors and returns the bytes it covered
+
+INTNS_BSWAP_TARGET("ssse3")
+size_t ssse3_swap(unsigned char* bytes, size_t size,
+                  const uint8_t* mask_bytes) noexcept {
+  const __m128i mask =
+      _mm_loadu_si128(reinterpret_cast<const __m128i*>(mask_bytes));
+
+  size_t i = 0;
+  for (; i + 16 <= size; i += 16) {
+    auto* p = reinterpret_cast<__m128i*>(bytes + i);
+    _mm_storeu_si128(p, _mm_shuffle_epi8(_mm_loadu_si128(p), mask));
+  }
+  return i;
+}
+
+INTNS_BSWAP_TARGET("avx2")
+size_t avx2_swap(unsigned char* bytes, size_t size,
+                 const uint8_t* mask_bytes) noexcept {
+  const __m256i mask =
+      _mm256_loadu_si256(reinterpret_cast<const __m256i*>(mask_bytes));
+
+  // Two vectors per iteration hides the shuffle latency
+  size_t i = 0;
+  for (; i + 64 <= size; i += 64) {
+    auto* p = reinterpret_cast<__m256i*>(bytes + i);
+    const __m256i a = _mm256_loadu_si256(p);
+    const __m256i b = _mm256_loadu_si256(p + 1);
+    _mm256_storeu_si256(p, _mm256_shuffle_epi8(a, mask));
+    _mm256_storeu_si256(p + 1, _mm256_shuffle_epi8(b, mask));
+  }
+  for (; i + 32 <= size; i += 32) {
+    auto* p = reinterpret_cast<__m256i*>(bytes + i);
+    _mm256_storeu_si256(p, _mm256_shuffle_epi8(_mm256_loadu_si256(p), mask));
+  }
+  return i;
+}
+
+Kernel detect_kernel() noexcept {
+#if defined(__AVX2__)
+  return Kernel::kAvx2;
+#elif defined(__GNUC__) || defined(__clang__)
+  __builtin_cpu_init();
+  if (__builtin_cpu_supports("avx2")) return Kernel::kAvx2;
+  if (__builtin_cpu_supports("ssse3")) return Kernel::kSsse3;
+  return Kernel::kScalar;
+#elif defined(_MSC_VER)
+  int info[4];
+  __cpuid(info, 0);
+  const int max_leaf = info[0];
+
+  __cpuid(info, 1);
+  const bool ssse3 = (info[2] & (1 << 9)) != 0;
+  const bool osxsave = (info[2] & (1 << 27)) != 0;
+  const bool avx = (info[2] & (1 << 28)) != 0;
+
+  // AVX2 also needs the OS to save the upper halves of the YMM registers
+  if (max_leaf >= 7 && osxsave && avx && (_xgetbv(0) & 0x6) == 0x6) {
+    __cpuidex(info, 7, 0);
+    if (info[1] & (1 << 5)) return Kernel::kAvx2;
+  }
+  return ssse3 ? Kernel::kSsse3 : Kernel::kScalar;
+#else
+  return Kernel::kScalar;
+#endif
+}
+
+#elif defined(INTNS_BSWAP_NEON)
+
+template <size_t Width>
+size_t neon_swap(unsigned char* bytes, size_t size) noexcept {
+  size_t i = 0;
+  for (; i + 16 <= size; i += 16) {
+    const uint8x16_t v = vld1q_u8(bytes + i);
+    if constexpr (Width == 2) {
+      vst1q_u8(bytes + i, vrev16q_u8(v));
+    } else if constexpr (Width == 4) {
+      vst1q_u8(bytes + i, vrev32q_u8(v));
+    } else {
+      vst1q_u8(bytes + i, vrev64q_u8(v));
+    }
+  }
+  return i;
+}
+
+Kernel detect_kernel() noexcept { return Kernel::kNeon; }
+
+#else
+
+Kernel detect_kernel() noexcept { return Kernel::kScalar; }
+
+#endif
+
+Kernel active_kernel() noexcept {
+  static const Kernel kernel = detect_kernel();
+  return kernel;
+}
+
+template <typename U>
+void swap_array(void* data, size_t count) noexcept {
+  auto* bytes = static_cast<unsigned char*>(data);
+  const size_t size = count * sizeof(U);
+
+  size_t done = 0;
+  switch (active_kernel()) {
+#if defined(INTNS_BSWAP_X86)
+    case Kernel::kAvx2:
+      done = avx2_swap(bytes, size, kMask<sizeof(U)>.data());
+      break;
+    case Kernel::kSsse3:
+      done = ssse3_swap(bytes, size, kMask<sizeof(U)>.data());
+      break;
+#elif defined(INTNS_BSWAP_NEON)
+    case Kernel::kNeon:
+      done = neon_swap<sizeof(U)>(bytes, size);
+      break;
+#endif
+    default:
+      break;
+  }
+
+  // Vectors cover whole elements, the tail is done one at a time
+  scalar_swap<U>(bytes + done, (size - done) / sizeof(U));
+}
+
+}  // namespace
+
+namespace detail {
+
+void bswap_16_array(void* data, size_t count) noexcept {
+  swap_array<uint16_t>(data, count);
+}
+
+void bswap_32_array(void* data, size_t count) noexcept {
+  swap_array<uint32_t>(data, count);
+}
+
+void bswap_64_array(void* data, size_t count) noexcept {
+  swap_array<uint64_t>(data, count);
+}
+
+}  // namespace detail
+
+std::string_view bswap_kernel() noexcept {
+  switch (active_kernel()) {
+    case Kernel::kAvx2:
+      return "avx2";
+    case Kernel::kSsse3:
+      return "ssse3";
+    case Kernel::kNeon:
+      return "neon";
+    case Kernel::kScalar:
+    default:
+      return "scalar";
+  }
+}
+
+}  // namespace intns::io
@@ -0,0 +1,69 @@
+#ifndef INTNS_IO_BYTE_SWAP_HPP
+#define INTNS_IO_BYTE_SWAP_HPP
+
+#include <cstddef>
+#include <span>
+#include <string_view>
+#include <type_traits>
+
+#include "IoTypes.hpp"
+
+namespace intns::io {
+
+namespace detail {
+
+// Bulk kernels, each swapping `count` elements of that width in place. The
+// widest instruction set available is picked on first use: AVX2 or SSSE3 on
+// x86 (checked at runtime), NEON on ARM, or a scalar loop otherwise.
+void bswap_16_array(void* data, size_t count) noexcept;
+void bswap_32_array(void* data, size_t count) noexcept;
+void bswap_64_array(void* data, size_t count) noexcept;
+
+// Swaps `count` elements of `Width` bytes, where `data` need not be aligned
+template <size_t Width>
+void bswap_array(void* data, size_t count) noexcept {
+  if constexpr (Width == 2) {
+    bswap_16_array(data, count);
+  } else if constexpr (Width == 4) {
+    bswap_32_array(data, count);
+  } else if constexpr (Width == 8) {
+    bswap_64_array(data, count);
+  }
+}
+
+}  // namespace detail
+
+/**
+ * @brief Types whose byte order bswap_inplace() can reverse.
+ */
+template <typename T>
+concept Swappable = std::is_trivially_copyable_v<T> &&
+                    (sizeof(T) == 1 || sizeof(T) == 2 || sizeof(T) == 4 ||
+                     sizeof(T) == 8);
+
+/**
+ * @brief Reverses the byte order of every element, using SIMD kernels where
+ * available.
+ *
+ * @tparam T A 1, 2, 4 or 8 byte trivially copyable type, e.g. uint32_t or
+ * float; 1 byte types are left as they are.
+ * @param values The elements to convert.
+ */
+template <Swappable T>
+void bswap_inplace(std::span<T> values) noexcept {
+  static_assert(!std::is_const_v<T>, "Cannot swap const elements");
+
+  detail::bswap_array<sizeof(T)>(values.data(), values.size());
+}
+
+/**
+ * @brief Returns the name of the kernel set bswap_inplace() uses on this
+ * machine.
+ *
+ * @return One of "avx2", "ssse3", "neon" or "scalar".
+ */
+[[nodiscard]] std::string_view bswap_kernel() noexcept;
+
+}  // namespace intns::io
+
+#endif  // INTNS_IO_BYTE_SWAP_HPP
@@ -0,0 +1,163 @@
+#include "Checksum.hpp"
+
+#include <array>
+#include <cstddef>
+#include <cstring>
+
+#include "IoTypes.hpp"
+
+#if defined(__x86_64__) || defined(_M_X64)
+#define INTNS_CRC_X86 1
+#include <nmmintrin.h>
+#if defined(_MSC_VER) && !defined(__clang__)
+#include <intrin.h>
+#endif
+#elif defined(__ARM_FEATURE_CRC32)
+#define INTNS_CRC_ARM 1
+#include <arm_acle.h>
+#endif
+
+// GCC and Clang only emit instructions the build enables, unless told to
+#if defined(INTNS_CRC_X86) && (defined(__GNUC__) || defined(__clang__))
+#define INTNS_CRC_TARGET __attribute__((target("sse4.2")))
+#else
+#define INTNS_CRC_TARGET
+#endif
+
+namespace intns::io {
+
+namespace {
+
+// Reflected Castagnoli polynomial
+constexpr uint32_t kPolynomial = 0x82f63b78;
+
+// Table k advances a CRC by a byte followed by k zero bytes
+constexpr std::array<std::array<uint32_t, 256>, 8> make_tables() noexcept {
+  std::array<std::array<uint32_t, 256>, 8> tables{};
+  for (uint32_t i = 0; i < 256; ++i) {
+    uint32_t crc = i;
+    for (int bit = 0; bit < 8; ++bit) {
+      crc = (crc >> 1) ^ ((crc & 1) ? kPolynomial : 0);
+    }
+    tables[0][i] = crc;
+  }
+  for (size_t k = 1; k < tables.size(); ++k) {
+    for (size_t i = 0; i < 256; ++i) {
+      const uint32_t prev = tables[k - 1][i];
+      tables[k][i] = (prev >> 8) ^ tables[0][prev & 0xff];
+    }
+  }
+  return tables;
+}
+
+constexpr auto kTables = make_tables();
+
+// Loads 4 bytes in little-endian order, as the reflected CRC consumes them
+uint32_t load_le32(const uint8_t* p) noexcept {
+  uint32_t value;
+  std::memcpy(&value, p, 4);
+  if constexpr (native_endianness() == Endianness::kBig) {
+    value = bswap_32(value);
+  }
+  return value;
+}
+
+uint32_t table_crc(const uint8_t* p, size_t size, uint32_t crc) noexcept {
+  const auto& t = kTables;
+  for (; size >= 8; p += 8, size -= 8) {
+    const uint32_t lo = load_le32(p) ^ crc;
+    const uint32_t hi = load_le32(p + 4);
+    crc = t[7][lo & 0xff] ^ t[6][(lo >> 8) & 0xff] ^ t[5][(lo >> 16) & 0xff] ^
+          t[4][lo >> 24] ^ t[3][hi & 0xff] ^ t[2][(hi >> 8) & 0xff] ^
+          t[1][(hi >> 16) & 0xff] ^ t[0][hi >> 24];
+  }
+  for (; size > 0; ++p, --size) {
+    crc = (crc >> 8) ^ t[0][(crc ^ *p) & 0xff];
+  }
+  return crc;
+}
+
+#if defined(INTNS_CRC_X86)
+
+INTNS_CRC_TARGET
+uint32_t hardware_crc(const uint8_t* p, size_t size, uint32_t crc) noexcept {
+  uint64_t wide = crc;
+  for (; size >= 8; p += 8, size -= 8) {
+    uint64_t word;
+    std::memcpy(&word, p, 8);
+    wide = _mm_crc32_u64(wide, word);
+  }
+  crc = static_cast<uint32_t>(wide);
+  for (; size > 0; ++p, --size) {
+    crc = _mm_crc32_u8(crc, *p);
+  }
+  return crc;
+}
+
+bool detect_hardware() noexcept {
+#if defined(__SSE4_2__)
+  return true;
+#elif defined(__GNUC__) || defined(__clang__)
+  __builtin_cpu_init();
+  return __builtin_cpu_supports("sse4.2");
+#elif defined(_MSC_VER)
+  int info[4];
+  __cpuid(info, 1);
+  return (info[2] & (1 << 20)) != 0;
+#else
+  return false;
+#endif
+}
+
+#elif defined(INTNS_CRC_ARM)
+
+uint32_t hardware_crc(const uint8_t* p, size_t size, uint32_t crc) noexcept {
+  for (; size >= 8; p += 8, size -= 8) {
+    uint64_t word;
+    std::memcpy(&word, p, 8);
+    crc = __crc32cd(crc, word);
+  }
+  for (; size > 0; ++p, --size) {
+    crc = __crc32cb(crc, *p);
+  }
+  return crc;
+}
+
+bool detect_hardware() noexcept { return true; }
+
+#else
+
+uint32_t hardware_crc(const uint8_t* p, size_t size, uint32_t crc) noexcept {
+  return table_crc(p, size, crc);
+}
+
+bool detect_hardware() noexcept { return false; }
+
+#endif
+
+bool use_hardware() noexcept {
+  static const bool hardware = detect_hardware();
+  return hardware;
+}
+
+}  // namespace
+
+uint32_t crc32c(std::span<const uint8_t> data, uint32_t crc) noexcept {
+  crc = ~crc;
+  crc = use_hardware() ? hardware_crc(data.data(), data.size(), crc)
+                       : table_crc(data.data(), data.size(), crc);
+  return ~crc;
+}
+
+std::string_view crc32c_kernel() noexcept {
+  if (!use_hardware()) {
+    return "table";
+  }
+#if defined(INTNS_CRC_X86)
+  return "sse4.2";
+#else
+  return "armv8-crc";
+#endif
+}
+
+}  // namespace intns::io
@@ -0,0 +1,35 @@
+#ifndef INTNS_IO_CHECKSUM_HPP
+#define INTNS_IO_CHECKSUM_HPP
+
+#include <cstdint>
+#include <span>
+#include <string_view>
+
+namespace intns::io {
+
+/**
+ * @brief Computes the CRC-32C (Castagnoli) checksum of a buffer.
+ *
+ * Uses the SSE4.2 crc32 instruction on x86-64 (checked at runtime) or the
+ * ARMv8 CRC extension where the build enables it, and a slice-by-8 table
+ * otherwise.
+ *
+ * @param data The bytes to checksum.
+ * @param crc The checksum of the preceding bytes, to checksum a buffer in
+ * pieces (default: 0, for the first piece).
+ * @return The checksum of the bytes so far.
+ */
+[[nodiscard]] uint32_t crc32c(std::span<const uint8_t> data,
+                              uint32_t crc = 0) noexcept;
+
+/**
+ * @brief Returns the name of the implementation crc32c() uses on this
+ * machine.
+ *
+ * @return One of "sse4.2", "armv8-crc" or "table".
+ */
+[[nodiscard]] std::string_view crc32c_kernel() noexcept;
+
+}  // namespace intns::io
+
+#endif  // INTNS_IO_CHECKSUM_HPP
@@ -0,0 +1,232 @@
+#include "ChunkFile.hpp"
+
+#include <algorithm>
+#include <bit>
+#include <stdexcept>
+
+#include "Checksum.hpp"
+
+namespace intns::io {
+
+namespace {
+
+[[noreturn]] void throw_invalid(const std::string& reason) {
+  throw std::runtime_error("Invalid chunk file: " + reason);
+}
+
+detail::DirectoryEntry to_entry(const ChunkInfo& info) noexcept {
+  detail::DirectoryEntry entry{};
+  entry.tag = info.tag;
+  entry.compression = info.compression;
+  entry.checksum = info.checksum;
+  entry.offset = info.offset;
+  entry.stored_size = info.stored_size;
+  entry.size = info.size;
+  return entry;
+}
+
+ChunkInfo to_info(const detail::DirectoryEntry& entry) noexcept {
+  ChunkInfo info;
+  info.tag = entry.tag;
+  info.compression = entry.compression;
+  info.checksum = entry.checksum;
+  info.offset = entry.offset;
+  info.stored_size = entry.stored_size;
+  info.size = entry.size;
+  return info;
+}
+
+}  // namespace
+
+// ChunkFileWriter
+
+ChunkFileWriter::ChunkFileWriter(const std::string& filename,
+                                 size_t alignment)
+    : out_(filename), alignment_(alignment) {
+  if (!std::has_single_bit(alignment)) {
+    throw std::invalid_argument("Chunk alignment must be a power of two");
+  }
+
+  // Completed by finish()
+  out_.write(detail::ChunkFileHeader{});
+}
+
+ChunkFileWriter::~ChunkFileWriter() {
+  try {
+    finish();
+  } catch (...) {
+    // Destructors can't report errors, finish() explicitly to see them
+  }
+}
+
+size_t ChunkFileWriter::add_chunk(uint32_t tag, std::span<const uint8_t> data,
+                                  Compression compression, int level) {
+  if (finished_) {
+    throw std::logic_error("Cannot add a chunk to a finished chunk file");
+  }
+
+  ChunkInfo info;
+  info.tag = tag;
+  info.checksum = crc32c(data);
+  info.size = data.size();
+
+  std::vector<uint8_t> compressed;
+  std::span<const uint8_t> stored = data;
+  if (compression != Compression::kNone) {
+    compressed = compress_block(data, compression, level);
+    if (compressed.size() < data.size()) {
+      stored = compressed;
+      info.compression = compression;
+    }
+  }
+
+  align();
+  info.offset = out_.position();
+  info.stored_size = stored.size();
+  if (!stored.empty()) {
+    out_.write_bytes(stored.data(), stored.size());
+  }
+
+  chunks_.push_back(info);
+  return chunks_.size() - 1;
+}
+
+void ChunkFileWriter::finish() {
+  if (finished_) {
+    return;
+  }
+  finished_ = true;
+
+  // Build the directory in memory to checksum it
+  LEMemoryWriter directory(chunks_.size() *
+                           wire_size<detail::DirectoryEntry>());
+  for (const ChunkInfo& info : chunks_) {
+    directory.write(to_entry(info));
+  }
+
+  align();
+  detail::ChunkFileHeader header{};
+  header.magic = detail::kChunkFileMagic;
+  header.version = detail::kChunkFileVersion;
+  header.chunk_count = static_cast<uint32_t>(chunks_.size());
+  header.directory_checksum = crc32c(directory.data());
+  header.directory_offset = out_.position();
+
+  if (directory.size() > 0) {
+    out_.write_bytes(directory.data().data(), directory.size());
+  }
+  out_.patch(0, header);
+  out_.flush();
+}
+
+void ChunkFileWriter::align() {
+  static constexpr std::array<uint8_t, 64> kZeros{};
+  size_t padding = (alignment_ - out_.position() % alignment_) % alignment_;
+  while (padding > 0) {
+    const size_t chunk = std::min(padding, kZeros.size());
+    out_.write_bytes(kZeros.data(), chunk);
+    padding -= chunk;
+  }
+}
+
+// ChunkFile
+
+ChunkFile::ChunkFile(const std::string& filename) : file_(filename) {
+  open();
+}
+
+ChunkFile::ChunkFile(MappedFile file) : file_(std::move(file)) { open(); }
+
+void ChunkFile::open() {
+  LEMemoryReader reader(file_.bytes());
+  if (reader.size() < wire_size<detail::ChunkFileHeader>()) {
+    throw_invalid("too small for a header");
+  }
+
+  const auto header = reader.read<detail::ChunkFileHeader>();
+  if (header.magic != detail::kChunkFileMagic) {
+    throw_invalid("bad magic number");
+  }
+  if (header.version != detail::kChunkFileVersion) {
+    throw_invalid("unsupported version " + std::to_string(header.version));
+  }
+
+  const uint64_t directory_size =
+      uint64_t{header.chunk_count} * wire_size<detail::DirectoryEntry>();
+  if (header.directory_offset > file_.size() ||
+      directory_size > file_.size() - header.directory_offset) {
+    throw_invalid("directory extends past the end of the file");
+  }
+
+  const auto directory = file_.bytes().subspan(
+      static_cast<size_t>(header.directory_offset),
+      static_cast<size_t>(directory_size));
+  if (crc32c(directory) != header.directory_checksum) {
+    throw_invalid("directory checksum mismatch");
+  }
+
+  reader.set_position(static_cast<size_t>(header.directory_offset));
+  chunks_.reserve(header.chunk_count);
+  for (uint32_t i = 0; i < header.chunk_count; ++i) {
+    const ChunkInfo info = to_info(reader.read<detail::DirectoryEntry>());
+    if (info.offset > file_.size() ||
+        info.stored_size > file_.size() - info.offset) {
+      throw_invalid("chunk " + std::to_string(i) +
+                    " extends past the end of the file");
+    }
+    if (info.compression == Compression::kNone &&
+        info.stored_size != info.size) {
+      throw_invalid("uncompressed chunk " + std::to_string(i) +
+                    " has mismatched sizes");
+    }
+    chunks_.push_back(info);
+  }
+}
+
+std::optional<size_t> ChunkFile::find(uint32_t tag) const noexcept {
+  for (size_t i = 0; i < chunks_.size(); ++i) {
+    if (chunks_[i].tag == tag) {
+      return i;
+    }
+  }
+  return std::nullopt;
+}
+
+std::span<const uint8_t> ChunkFile::stored_bytes(size_t index) const noexcept {
+  const ChunkInfo& info = chunks_[index];
+  return file_.bytes().subspan(static_cast<size_t>(info.offset),
+                               static_cast<size_t>(info.stored_size));
+}
+
+ChunkData ChunkFile::load(size_t index, bool verify) const {
+  if (index >= chunks_.size()) {
+    throw std::out_of_range("Chunk " + std::to_string(index) +
+                            " out of range: file has " +
+                            std::to_string(chunks_.size()) + " chunks");
+  }
+
+  const ChunkInfo& info = chunks_[index];
+  ChunkData data = [&] {
+    if (info.compression == Compression::kNone) {
+      return ChunkData(stored_bytes(index));
+    }
+    std::vector<uint8_t> contents(static_cast<size_t>(info.size));
+    decompress_block(stored_bytes(index), info.compression, contents);
+    return ChunkData(std::move(contents));
+  }();
+
+  if (verify && crc32c(data.bytes()) != info.checksum) {
+    throw std::runtime_error("Chunk " + std::to_string(index) +
+                             " does not match its checksum");
+  }
+  return data;
+}
+
+bool ChunkFile::prefetch(size_t index) const noexcept {
+  const ChunkInfo& info = chunks_[index];
+  return file_.advise(static_cast<size_t>(info.offset),
+                      static_cast<size_t>(info.stored_size),
+                      PageAdvice::kWillNeed);
+}
+
+}  // namespace intns::io
@@ -0,0 +1,341 @@
+#ifndef INTNS_IO_CHUNK_FILE_HPP
+#define INTNS_IO_CHUNK_FILE_HPP
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+#include <span>
+#include <string>
+#include <vector>
+
+#include "BinaryReader.hpp"
+#include "BinaryWriter.hpp"
+#include "Decompress.hpp"
+#include "IoTypes.hpp"
+#include "MappedFile.hpp"
+
+namespace intns::io {
+
+/**
+ * @brief Builds a chunk tag from four characters, e.g. chunk_tag("MESH").
+ *
+ * @param name Four characters; the first is stored first in the file.
+ * @return The tag.
+ */
+[[nodiscard]] constexpr uint32_t chunk_tag(const char (&name)[5]) noexcept {
+  return static_cast<uint32_t>(static_cast<uint8_t>(name[0])) |
+         static_cast<uint32_t>(static_cast<uint8_t>(name[1])) << 8 |
+         static_cast<uint32_t>(static_cast<uint8_t>(name[2])) << 16 |
+         static_cast<uint32_t>(static_cast<uint8_t>(name[3])) << 24;
+}
+
+/**
+ * @brief Describes one chunk of a chunk file.
+ */
+struct ChunkInfo {
+  // User-defined chunk type
+  uint32_t tag = 0;
+
+  // How the chunk is stored
+  Compression compression = Compression::kNone;
+
+  uint32_t checksum = 0;     // CRC-32C of the decompressed contents
+  uint64_t offset = 0;       // Start of the stored bytes in the file
+  uint64_t stored_size = 0;  // Bytes stored in the file
+  uint64_t size = 0;         // Bytes once decompressed
+};
+
+namespace detail {
+
+// On-disk layout, little-endian throughout:
+//
+//   header     magic, version, chunk count, directory checksum and offset
+//   chunks     each starting at a multiple of the writer's alignment
+//   directory  one DirectoryEntry per chunk
+struct ChunkFileHeader {
+  uint32_t magic;
+  uint16_t version;
+  uint16_t reserved;
+  uint32_t chunk_count;
+  uint32_t directory_checksum;  // CRC-32C of the directory
+  uint64_t directory_offset;
+  uint64_t reserved2;
+};
+
+struct DirectoryEntry {
+  uint32_t tag;
+  Compression compression;
+  std::array<uint8_t, 3> reserved;
+  uint32_t checksum;
+  uint32_t reserved2;
+  uint64_t offset;
+  uint64_t stored_size;
+  uint64_t size;
+};
+
+inline constexpr uint32_t kChunkFileMagic = 0x4b484349;  // "ICHK"
+inline constexpr uint16_t kChunkFileVersion = 1;
+
+}  // namespace detail
+
+/**
+ * @brief Writes a chunk file: independent chunks, each optionally
+ * compressed, followed by a directory of their offsets, sizes and
+ * checksums.
+ *
+ * Chunks can be read back in any order, and in parallel, with ChunkFile.
+ *
+ * @section Usage
+ * @code
+ * ChunkFileWriter out("level.ichk");
+ * out.add_chunk(chunk_tag("MESH"), mesh_bytes, Compression::kZstd);
+ * out.add_chunk(chunk_tag("TEXT"), texture_bytes);
+ * out.finish();
+ * @endcode
+ *
+ * @section Exception Safety
+ * I/O failures throw std::runtime_error. The destructor finishes the file if
+ * finish() was not called, swallowing errors; call finish() to see them.
+ */
+class ChunkFileWriter {
+ public:
+  /**
+   * @brief Creates or truncates a chunk file.
+   *
+   * @param filename Path to the file to write.
+   * @param alignment Alignment of each chunk in the file (default: 64 bytes),
+   * a power of two; chunks stored uncompressed keep it when mapped.
+   * @throws std::runtime_error If the file cannot be opened.
+   * @throws std::invalid_argument If alignment is not a power of two.
+   */
+  explicit ChunkFileWriter(const std::string& filename, size_t alignment = 64);
+
+  ~ChunkFileWriter();
+
+  ChunkFileWriter(const ChunkFileWriter&) = delete;
+  ChunkFileWriter& operator=(const ChunkFileWriter&) = delete;
+
+  /**
+   * @brief Appends a chunk.
+   *
+   * If compressing does not make the chunk smaller, it is stored
+   * uncompressed.
+   *
+   * @param tag User-defined chunk type, see chunk_tag().
+   * @param data The chunk's contents.
+   * @param compression How to store the chunk (default: uncompressed).
+   * @param level Compression level, 0 for the codec's default.
+   * @return The index of the chunk.
+   * @throws std::logic_error If finish() has been called.
+   * @throws std::runtime_error If compression or writing fails.
+   */
+  size_t add_chunk(uint32_t tag, std::span<const uint8_t> data,
+                   Compression compression = Compression::kNone,
+                   int level = 0);
+
+  /**
+   * @brief Writes the directory and completes the header.
+   *
+   * Does nothing if already finished.
+   *
+   * @throws std::runtime_error If writing fails.
+   */
+  void finish();
+
+  /**
+   * @brief Returns the chunks added so far.
+   */
+  [[nodiscard]] std::span<const ChunkInfo> chunks() const noexcept {
+    return chunks_;
+  }
+
+ private:
+  // Pads the file to the next multiple of alignment_
+  void align();
+
+  LEFileWriter out_;               ///< The file being written.
+  size_t alignment_;               ///< Alignment of each chunk.
+  std::vector<ChunkInfo> chunks_;  ///< Directory, written by finish().
+  bool finished_ = false;          ///< Whether finish() has run.
+};
+
+/**
+ * @brief The contents of one chunk, either viewed in place in the mapping
+ * or decompressed into a buffer it owns.
+ *
+ * Move-only; moving keeps bytes() at the same address.
+ */
+class ChunkData {
+ public:
+  /**
+   * @brief Views bytes owned elsewhere, e.g. in a ChunkFile's mapping.
+   */
+  explicit ChunkData(std::span<const uint8_t> bytes) noexcept
+      : bytes_(bytes) {}
+
+  /**
+   * @brief Owns its bytes, e.g. a decompressed chunk.
+   */
+  explicit ChunkData(std::vector<uint8_t> owned) noexcept
+      : owned_(std::move(owned)), bytes_(owned_) {}
+
+  ChunkData(ChunkData&&) noexcept = default;
+  ChunkData& operator=(ChunkData&&) noexcept = default;
+  ChunkData(const ChunkData&) = delete;
+  ChunkData& operator=(const ChunkData&) = delete;
+
+  /**
+   * @brief Returns the chunk's contents.
+   */
+  [[nodiscard]] std::span<const uint8_t> bytes() const noexcept {
+    return bytes_;
+  }
+
+  /**
+   * @brief Returns the size of the chunk's contents in bytes.
+   */
+  [[nodiscard]] size_t size() const noexcept { return bytes_.size(); }
+
+  /**
+   * @brief Checks whether the contents were decompressed into a buffer
+   * owned by this object rather than viewed in place.
+   */
+  [[nodiscard]] bool owns_bytes() const noexcept { return !owned_.empty(); }
+
+  /**
+   * @brief Creates a reader over the contents, valid as long as this object
+   * and its ChunkFile are.
+   *
+   * @tparam E The endianness of the chunk's contents.
+   */
+  template <Endianness E = Endianness::kLittle>
+  [[nodiscard]] MemoryReader<E> reader() const noexcept {
+    return MemoryReader<E>(bytes_);
+  }
+
+ private:
+  std::vector<uint8_t> owned_;      ///< Decompressed contents, if any.
+  std::span<const uint8_t> bytes_;  ///< The contents.
+};
+
+/**
+ * @brief Reads a chunk file written by ChunkFileWriter through a memory
+ * mapping.
+ *
+ * Opening maps the file and validates the header and directory; chunks are
+ * only touched when loaded. load() is const and safe to call from several
+ * threads at once, so chunks can be handed to workers and parsed in
+ * parallel: uncompressed chunks are views into the mapping, compressed ones
+ * are decompressed by the calling thread.
+ *
+ * @section Usage
+ * @code
+ * ChunkFile file("level.ichk");
+ * for (size_t i = 0; i < file.chunk_count(); ++i) {
+ *   pool.submit([&file, i] {
+ *     ChunkData chunk = file.load(i);
+ *     auto reader = chunk.reader();
+ *     parse(reader);
+ *   });
+ * }
+ * @endcode
+ *
+ * @section Exception Safety
+ * The constructor throws std::runtime_error if the file cannot be mapped or
+ * is not a valid chunk file. load() throws std::runtime_error if a chunk is
+ * corrupt.
+ */
+class ChunkFile {
+ public:
+  /**
+   * @brief Maps and validates a chunk file.
+   *
+   * @param filename Path to the file to read.
+   * @throws std::runtime_error If the file cannot be mapped, or its header
+   * or directory is invalid.
+   */
+  explicit ChunkFile(const std::string& filename);
+
+  /**
+   * @brief Validates an already mapped chunk file.
+   *
+   * @param file The mapping, taken over by the ChunkFile.
+   * @throws std::runtime_error If the header or directory is invalid.
+   */
+  explicit ChunkFile(MappedFile file);
+
+  /**
+   * @brief Returns the number of chunks.
+   */
+  [[nodiscard]] size_t chunk_count() const noexcept { return chunks_.size(); }
+
+  /**
+   * @brief Returns the directory entry of every chunk.
+   */
+  [[nodiscard]] std::span<const ChunkInfo> chunks() const noexcept {
+    return chunks_;
+  }
+
+  /**
+   * @brief Returns the directory entry of a chunk.
+   *
+   * @param index The chunk, less than chunk_count().
+   */
+  [[nodiscard]] const ChunkInfo& chunk(size_t index) const noexcept {
+    return chunks_[index];
+  }
+
+  /**
+   * @brief Finds the first chunk with a tag.
+   *
+   * @param tag The tag to look for.
+   * @return The index of the chunk, or std::nullopt if there is none.
+   */
+  [[nodiscard]] std::optional<size_t> find(uint32_t tag) const noexcept;
+
+  /**
+   * @brief Returns a chunk's bytes as stored, compressed or not.
+   *
+   * @param index The chunk, less than chunk_count().
+   */
+  [[nodiscard]] std::span<const uint8_t> stored_bytes(
+      size_t index) const noexcept;
+
+  /**
+   * @brief Loads a chunk's contents, decompressing it if needed.
+   *
+   * @param index The chunk.
+   * @param verify Whether to check the contents against the stored
+   * checksum (default: true).
+   * @return The contents.
+   * @throws std::out_of_range If index is not less than chunk_count().
+   * @throws std::runtime_error If the chunk fails to decompress or does not
+   * match its checksum.
+   */
+  [[nodiscard]] ChunkData load(size_t index, bool verify = true) const;
+
+  /**
+   * @brief Asks the OS to start reading a chunk's pages in the background.
+   *
+   * @param index The chunk, less than chunk_count().
+   * @return true if the hint was accepted.
+   */
+  bool prefetch(size_t index) const noexcept;
+
+  /**
+   * @brief Returns the underlying mapping.
+   */
+  [[nodiscard]] const MappedFile& file() const noexcept { return file_; }
+
+ private:
+  // Parses and validates the header and directory
+  void open();
+
+  MappedFile file_;                ///< The mapped file.
+  std::vector<ChunkInfo> chunks_;  ///< The parsed directory.
+};
+
+}  // namespace intns::io
+
+#endif  // INTNS_IO_CHUNK_FILE_HPP
@@ -0,0 +1,375 @@
+#include "Decompress.hpp"
+
+#include <algorithm>
+#include <climits>
+#include <fstream>
+#include <stdexcept>
+
+#if defined(INTNS_HAS_ZLIB)
+#include <zlib.h>
+#endif
+#if defined(INTNS_HAS_ZSTD)
+#include <zstd.h>
+#endif
+#if defined(INTNS_HAS_LZ4)
+#include <lz4frame.h>
+#endif
+
+namespace intns::io {
+
+class DecompressStream::Decoder {
+ public:
+  virtual ~Decoder() = default;
+
+  // Decodes from [in, in + in_size) into [out, out + out_size), reporting the
+  // bytes consumed and produced. Returns whether a frame ended and its output
+  // has been fully flushed.
+  virtual bool step(const uint8_t* in, size_t in_size, size_t& consumed,
+                    uint8_t* out, size_t out_size, size_t& produced) = 0;
+};
+
+namespace {
+
+[[noreturn, maybe_unused]] void throw_unsupported(const char* name) {
+  throw std::runtime_error(std::string("Cannot decompress ") + name +
+                           ": intnslib was built without it");
+}
+
+#if defined(INTNS_HAS_ZLIB)
+
+class ZlibDecoder final : public DecompressStream::Decoder {
+ public:
+  ZlibDecoder() {
+    // 15 bit window, +32 to accept both zlib and gzip headers
+    if (inflateInit2(&stream_, 15 + 32) != Z_OK) {
+      throw std::runtime_error("Failed to create zlib decoder");
+    }
+  }
+
+  ~ZlibDecoder() override { inflateEnd(&stream_); }
+
+  bool step(const uint8_t* in, size_t in_size, size_t& consumed, uint8_t* out,
+            size_t out_size, size_t& produced) override {
+    const auto avail_in =
+        static_cast<uInt>(std::min<size_t>(in_size, UINT_MAX));
+    const auto avail_out =
+        static_cast<uInt>(std::min<size_t>(out_size, UINT_MAX));
+    stream_.next_in = const_cast<Bytef*>(in);
+    stream_.avail_in = avail_in;
+    stream_.next_out = out;
+    stream_.avail_out = avail_out;
+
+    const int result = inflate(&stream_, Z_NO_FLUSH);
+    consumed = avail_in - stream_.avail_in;
+    produced = avail_out - stream_.avail_out;
+
+    if (result == Z_STREAM_END) {
+      inflateReset(&stream_);  // Ready for the next gzip member
+      return true;
+    }
+    if (result != Z_OK && result != Z_BUF_ERROR) {
+      throw std::runtime_error(std::string("zlib: ") +
+                               (stream_.msg ? stream_.msg : "corrupt data"));
+    }
+    return false;
+  }
+
+ private:
+  z_stream stream_{};
+};
+
+#endif
+
+#if defined(INTNS_HAS_ZSTD)
+
+class ZstdDecoder final : public DecompressStream::Decoder {
+ public:
+  ZstdDecoder() : stream_(ZSTD_createDStream()) {
+    if (!stream_) {
+      throw std::runtime_error("Failed to create zstd decoder");
+    }
+  }
+
+  ~ZstdDecoder() override { ZSTD_freeDStream(stream_); }
+
+  bool step(const uint8_t* in, size_t in_size, size_t& consumed, uint8_t* out,
+            size_t out_size, size_t& produced) override {
+    ZSTD_inBuffer input{in, in_size, 0};
+    ZSTD_outBuffer output{out, out_size, 0};
+    const size_t result = ZSTD_decompressStream(stream_, &output, &input);
+    if (ZSTD_isError(result)) {
+      throw std::runtime_error(std::string("zstd: ") +
+                               ZSTD_getErrorName(result));
+    }
+    consumed = input.pos;
+    produced = output.pos;
+    return result == 0;
+  }
+
+ private:
+  ZSTD_DStream* stream_;
+};
+
+#endif
+
+#if defined(INTNS_HAS_LZ4)
+
+class Lz4Decoder final : public DecompressStream::Decoder {
+ public:
+  Lz4Decoder() {
+    if (LZ4F_isError(
+            LZ4F_createDecompressionContext(&context_, LZ4F_VERSION))) {
+      throw std::runtime_error("Failed to create LZ4 decoder");
+    }
+  }
+
+  ~Lz4Decoder() override { LZ4F_freeDecompressionContext(context_); }
+
+  bool step(const uint8_t* in, size_t in_size, size_t& consumed, uint8_t* out,
+            size_t out_size, size_t& produced) override {
+    consumed = in_size;
+    produced = out_size;
+    const size_t result =
+        LZ4F_decompress(context_, out, &produced, in, &consumed, nullptr);
+    if (LZ4F_isError(result)) {
+      throw std::runtime_error(std::string("LZ4: ") +
+                               LZ4F_getErrorName(result));
+    }
+    return result == 0;
+  }
+
+ private:
+  LZ4F_dctx* context_ = nullptr;
+};
+
+#endif
+
+std::unique_ptr<DecompressStream::Decoder> make_decoder(
+    Compression compression) {
+  switch (compression) {
+    case Compression::kZlib:
+#if defined(INTNS_HAS_ZLIB)
+      return std::make_unique<ZlibDecoder>();
+#else
+      throw_unsupported("zlib");
+#endif
+    case Compression::kZstd:
+#if defined(INTNS_HAS_ZSTD)
+      return std::make_unique<ZstdDecoder>();
+#else
+      throw_unsupported("zstd");
+#endif
+    case Compression::kLz4:
+#if defined(INTNS_HAS_LZ4)
+      return std::make_unique<Lz4Decoder>();
+#else
+      throw_unsupported("LZ4");
+#endif
+    case Compression::kNone:
+      break;
+  }
+  throw std::invalid_argument("DecompressStream needs a compressed format");
+}
+
+}  // namespace
+
+bool compression_supported(Compression compression) noexcept {
+  switch (compression) {
+    case Compression::kNone:
+      return true;
+    case Compression::kZlib:
+#if defined(INTNS_HAS_ZLIB)
+      return true;
+#else
+      return false;
+#endif
+    case Compression::kZstd:
+#if defined(INTNS_HAS_ZSTD)
+      return true;
+#else
+      return false;
+#endif
+    case Compression::kLz4:
+#if defined(INTNS_HAS_LZ4)
+      return true;
+#else
+      return false;
+#endif
+  }
+  return false;
+}
+
+Compression detect_compression(std::span<const uint8_t> header) noexcept {
+  if (header.size() >= 4) {
+    if (header[0] == 0x28 && header[1] == 0xb5 && header[2] == 0x2f &&
+        header[3] == 0xfd) {
+      return Compression::kZstd;
+    }
+    if (header[0] == 0x04 && header[1] == 0x22 && header[2] == 0x4d &&
+        header[3] == 0x18) {
+      return Compression::kLz4;
+    }
+  }
+
+  if (header.size() >= 2) {
+    // gzip magic, or a zlib header with a 32 KiB window, no preset
+    // dictionary and a valid check value
+    if (header[0] == 0x1f && header[1] == 0x8b) {
+      return Compression::kZlib;
+    }
+    if (header[0] == 0x78 && (header[1] & 0x20) == 0 &&
+        ((header[0] << 8) | header[1]) % 31 == 0) {
+      return Compression::kZlib;
+    }
+  }
+  return Compression::kNone;
+}
+
+DecompressStream::DecompressStream(std::unique_ptr<InputStream> compressed,
+                                   Compression compression,
+                                   size_t input_buffer_size)
+    : compressed_(std::move(compressed)) {
+  if (input_buffer_size == 0) {
+    throw std::invalid_argument("Input buffer size cannot be zero");
+  }
+  decoder_ = make_decoder(compression);
+  input_.resize(input_buffer_size);
+}
+
+DecompressStream::~DecompressStream() = default;
+
+size_t DecompressStream::read(void* dest, size_t bytes) {
+  auto* out = static_cast<uint8_t*>(dest);
+  size_t total = 0;
+
+  while (total < bytes) {
+    if (input_pos_ == input_end_ && !input_done_) {
+      input_end_ = compressed_->read(input_.data(), input_.size());
+      input_pos_ = 0;
+      input_done_ = input_end_ == 0;
+    }
+
+    const size_t available = input_end_ - input_pos_;
+    if (available == 0 && frame_complete_) {
+      break;  // Every frame decoded and flushed
+    }
+
+    size_t consumed = 0;
+    size_t produced = 0;
+    frame_complete_ =
+        decoder_->step(input_.data() + input_pos_, available, consumed,
+                       out + total, bytes - total, produced);
+    input_pos_ += consumed;
+    total += produced;
+
+    if (consumed == 0 && produced == 0 && !frame_complete_) {
+      throw std::runtime_error(available == 0
+                                   ? "Compressed stream ends within a frame"
+                                   : "Compressed stream is corrupt");
+    }
+  }
+
+  return total;
+}
+
+std::vector<uint8_t> compress_block(std::span<const uint8_t> data,
+                                    Compression compression, int level) {
+  std::vector<uint8_t> out;
+  switch (compression) {
+    case Compression::kZlib: {
+#if defined(INTNS_HAS_ZLIB)
+      if (data.size() > static_cast<uLong>(-1)) {
+        throw std::invalid_argument("Block too large for zlib");
+      }
+      uLongf size = compressBound(static_cast<uLong>(data.size()));
+      out.resize(size);
+      if (compress2(out.data(), &size, data.data(),
+                    static_cast<uLong>(data.size()),
+                    level == 0 ? Z_DEFAULT_COMPRESSION : level) != Z_OK) {
+        throw std::runtime_error("zlib: compression failed");
+      }
+      out.resize(size);
+      return out;
+#else
+      throw_unsupported("zlib");
+#endif
+    }
+    case Compression::kZstd: {
+#if defined(INTNS_HAS_ZSTD)
+      out.resize(ZSTD_compressBound(data.size()));
+      const size_t size = ZSTD_compress(out.data(), out.size(), data.data(),
+                                        data.size(), level);
+      if (ZSTD_isError(size)) {
+        throw std::runtime_error(std::string("zstd: ") +
+                                 ZSTD_getErrorName(size));
+      }
+      out.resize(size);
+      return out;
+#else
+      throw_unsupported("zstd");
+#endif
+    }
+    case Compression::kLz4: {
+#if defined(INTNS_HAS_LZ4)
+      LZ4F_preferences_t preferences{};
+      preferences.compressionLevel = level;
+      preferences.frameInfo.contentSize = data.size();
+      out.resize(LZ4F_compressFrameBound(data.size(), &preferences));
+      const size_t size = LZ4F_compressFrame(
+          out.data(), out.size(), data.data(), data.size(), &preferences);
+      if (LZ4F_isError(size)) {
+        throw std::runtime_error(std::string("LZ4: ") +
+                                 LZ4F_getErrorName(size));
+      }
+      out.resize(size);
+      return out;
+#else
+      throw_unsupported("LZ4");
+#endif
+    }
+    case Compression::kNone:
+      break;
+  }
+  throw std::invalid_argument("compress_block needs a compressed format");
+}
+
+void decompress_block(std::span<const uint8_t> data, Compression compression,
+                      std::span<uint8_t> out) {
+  DecompressStream stream(std::make_unique<MemoryInputStream>(data),
+                          compression, std::max<size_t>(data.size(), 1));
+  uint8_t extra = 0;
+  if (stream.read(out.data(), out.size()) != out.size() ||
+      stream.read(&extra, 1) != 0) {
+    throw std::runtime_error("Compressed block does not match its size");
+  }
+}
+
+std::unique_ptr<InputStream> open_input_stream(const std::string& filename,
+                                               const ReadAhead& read_ahead) {
+  uint8_t header[4] = {};
+  size_t header_size = 0;
+  {
+    std::ifstream file(filename, std::ios::binary);
+    if (!file) {
+      throw std::runtime_error("Failed to open file: " + filename);
+    }
+    file.read(reinterpret_cast<char*>(header), sizeof(header));
+    header_size = static_cast<size_t>(file.gcount());
+  }
+
+  std::unique_ptr<InputStream> file;
+  if (read_ahead.buffer_count > 0) {
+    file = std::make_unique<ReadAheadStream>(filename, read_ahead);
+  } else {
+    file = std::make_unique<FileInputStream>(filename);
+  }
+
+  const Compression compression =
+      detect_compression(std::span<const uint8_t>(header, header_size));
+  if (compression == Compression::kNone) {
+    return file;
+  }
+  return std::make_unique<DecompressStream>(std::move(file), compression);
+}
+
+}  // namespace intns::io
@@ -0,0 +1,152 @@
+#ifndef INTNS_IO_DECOMPRESS_HPP
+#define INTNS_IO_DECOMPRESS_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <span>
+#include <string>
+#include <vector>
+
+#include "InputStream.hpp"
+#include "ReadAhead.hpp"
+
+namespace intns::io {
+
+/**
+ * @brief Compressed formats DecompressStream can decode.
+ */
+enum class Compression : uint8_t {
+  kNone = 0,  // Stored as is
+  kZlib,      // zlib or gzip, told apart by their headers
+  kZstd,      // Zstandard frames
+  kLz4        // LZ4 frames, not the raw block format
+};
+
+/**
+ * @brief Checks whether the library was built with a decoder for a format.
+ *
+ * Each decoder is compiled in when CMake finds its library, see
+ * CMakeLists.txt.
+ *
+ * @param compression The format to check.
+ * @return true if DecompressStream can decode `compression`.
+ */
+[[nodiscard]] bool compression_supported(Compression compression) noexcept;
+
+/**
+ * @brief Identifies a compressed format from the first bytes of a stream.
+ *
+ * @param header The first bytes of the stream, at least 4 for every format
+ * to be recognized.
+ * @return The format whose magic number `header` starts with, or kNone.
+ */
+[[nodiscard]] Compression detect_compression(
+    std::span<const uint8_t> header) noexcept;
+
+/**
+ * @brief Compresses a buffer in one call, e.g. a chunk of a ChunkFile.
+ *
+ * zlib output uses the zlib header, zstd and LZ4 output is a single frame,
+ * so DecompressStream and decompress_block() can read all of them.
+ *
+ * @param data The bytes to compress.
+ * @param compression The format to produce.
+ * @param level Format-specific compression level, 0 for the library's
+ * default.
+ * @return The compressed bytes.
+ * @throws std::invalid_argument If compression is kNone.
+ * @throws std::runtime_error If the library was built without a codec for
+ * `compression`, or compression fails.
+ */
+[[nodiscard]] std::vector<uint8_t> compress_block(
+    std::span<const uint8_t> data, Compression compression, int level = 0);
+
+/**
+ * @brief Decompresses a buffer whose decompressed size is known.
+ *
+ * @param data The compressed bytes.
+ * @param compression The format of `data`.
+ * @param out Destination, exactly the decompressed size.
+ * @throws std::invalid_argument If compression is kNone.
+ * @throws std::runtime_error If the library was built without a codec for
+ * `compression`, or `data` is corrupt or does not decompress to exactly
+ * out.size() bytes.
+ */
+void decompress_block(std::span<const uint8_t> data, Compression compression,
+                      std::span<uint8_t> out);
+
+/**
+ * @brief An InputStream decompressing another InputStream as it is read.
+ *
+ * Compressed input is pulled in blocks of `input_buffer_size` and decoded
+ * straight into the caller's buffer, so memory use is bounded by the input
+ * buffer and the decoder's window rather than the decompressed size.
+ * Concatenated frames (or gzip members) are decoded one after another.
+ */
+class DecompressStream final : public InputStream {
+ public:
+  /**
+   * @brief Creates a stream decompressing `compressed`.
+   *
+   * @param compressed The compressed input.
+   * @param compression The format of the input.
+   * @param input_buffer_size Bytes of compressed input read at a time.
+   * @throws std::invalid_argument If input_buffer_size is 0 or compression
+   * is kNone.
+   * @throws std::runtime_error If the library was built without a decoder
+   * for `compression`, or the decoder cannot be created.
+   */
+  DecompressStream(std::unique_ptr<InputStream> compressed,
+                   Compression compression,
+                   size_t input_buffer_size = 64 * 1024);
+
+  ~DecompressStream() override;
+
+  DecompressStream(const DecompressStream&) = delete;
+  DecompressStream& operator=(const DecompressStream&) = delete;
+
+  /**
+   * @brief Decompresses the next bytes of the stream.
+   *
+   * @param dest Destination buffer.
+   * @param bytes Number of bytes wanted.
+   * @return The number of bytes produced, less than `bytes` only once every
+   * frame has been decoded.
+   * @throws std::runtime_error If the input is corrupt or ends within a
+   * frame.
+   */
+  size_t read(void* dest, size_t bytes) override;
+
+  /**
+   * @brief Decodes one compressed format, implemented per library.
+   */
+  class Decoder;
+
+ private:
+  std::unique_ptr<InputStream> compressed_;  ///< The compressed input.
+  std::unique_ptr<Decoder> decoder_;         ///< Format-specific state.
+  std::vector<uint8_t> input_;               ///< Compressed input buffer.
+  size_t input_pos_ = 0;                     ///< Next compressed byte.
+  size_t input_end_ = 0;                     ///< Valid bytes in input_.
+  bool input_done_ = false;     ///< Whether compressed_ is exhausted.
+  bool frame_complete_ = true;  ///< Whether the decoder is between frames.
+};
+
+/**
+ * @brief Opens a file as an InputStream, decompressing it if it starts with
+ * a supported format's magic number.
+ *
+ * @param filename Path to the file to read.
+ * @param read_ahead Background read-ahead for the file itself (default:
+ * disabled), so that reading overlaps decompression.
+ * @return A stream over the file's decompressed contents.
+ * @throws std::runtime_error If the file cannot be opened, or is compressed
+ * in a format the library was built without.
+ */
+[[nodiscard]] std::unique_ptr<InputStream> open_input_stream(
+    const std::string& filename, const ReadAhead& read_ahead = {});
+
+}  // namespace intns::io
+
+#endif  // INTNS_IO_DECOMPRESS_HPP
@@ -0,0 +1,99 @@
+#ifndef INTNS_IO_INPUT_STREAM_HPP
+#define INTNS_IO_INPUT_STREAM_HPP
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <fstream>
+#include <span>
+#include <stdexcept>
+#include <string>
+
+namespace intns::io {
+
+/**
+ * @brief A forward-only source of bytes for StreamReader, e.g. a file or a
+ * decompressor.
+ *
+ * Sources can be stacked: a DecompressStream reads its compressed input
+ * from another InputStream.
+ */
+class InputStream {
+ public:
+  virtual ~InputStream() = default;
+
+  /**
+   * @brief Copies the next bytes of the stream.
+   *
+   * @param dest Destination buffer.
+   * @param bytes Number of bytes wanted.
+   * @return The number of bytes copied, less than `bytes` only at the end of
+   * the stream.
+   * @throws std::runtime_error If the underlying read fails or the data is
+   * malformed.
+   */
+  virtual size_t read(void* dest, size_t bytes) = 0;
+};
+
+/**
+ * @brief An InputStream reading a file on the calling thread.
+ */
+class FileInputStream final : public InputStream {
+ public:
+  /**
+   * @brief Opens a file for reading.
+   *
+   * @param filename Path to the file to read.
+   * @throws std::runtime_error If the file cannot be opened.
+   */
+  explicit FileInputStream(const std::string& filename)
+      : file_(filename, std::ios::binary) {
+    if (!file_) {
+      throw std::runtime_error("Failed to open file: " + filename);
+    }
+  }
+
+  size_t read(void* dest, size_t bytes) override {
+    file_.read(static_cast<char*>(dest), static_cast<std::streamsize>(bytes));
+    if (file_.bad()) {
+      throw std::runtime_error("Failed to read from file");
+    }
+    return static_cast<size_t>(file_.gcount());
+  }
+
+ private:
+  std::ifstream file_;  ///< The underlying file stream.
+};
+
+/**
+ * @brief An InputStream over a buffer in memory, e.g. a compressed section
+ * of a larger file.
+ */
+class MemoryInputStream final : public InputStream {
+ public:
+  /**
+   * @brief Creates a stream over a buffer.
+   *
+   * @param data The bytes to read, which must outlive the stream.
+   */
+  explicit MemoryInputStream(std::span<const uint8_t> data) noexcept
+      : data_(data) {}
+
+  size_t read(void* dest, size_t bytes) override {
+    const size_t count = std::min(bytes, data_.size() - position_);
+    if (count > 0) {
+      std::memcpy(dest, data_.data() + position_, count);
+    }
+    position_ += count;
+    return count;
+  }
+
+ private:
+  std::span<const uint8_t> data_;  ///< The bytes to read.
+  size_t position_ = 0;            ///< Bytes already read.
+};
+
+}  // namespace intns::io
+
+#endif  // INTNS_IO_INPUT_STREAM_HPP
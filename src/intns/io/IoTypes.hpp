@@ -1,6 +1,7 @@
 #ifndef INTNS_IO_IOTYPES_HPP
 #define INTNS_IO_IOTYPES_HPP
 
+#include <bit>
 #include <cstdint>
 
 #if defined(_MSC_VER)
@@ -14,6 +15,11 @@ enum class Endianness : uint8_t {
   kBig          // Big-endian byte order
 };
 
+constexpr Endianness native_endianness() noexcept {
+  return std::endian::native == std::endian::little ? Endianness::kLittle
+                                                    : Endianness::kBig;
+}
+
 inline uint16_t bswap_16(uint16_t x) noexcept {
 #if defined(__GNUC__) || defined(__clang__)
   return __builtin_bswap16(x);
@@ -0,0 +1,112 @@
+#include "MappedFile.hpp"
+
+#include <stdexcept>
+
+#if defined(_WIN32)
+#ifndef NOMINMAX
+#define NOMINMAX
+#endif
+#ifndef WIN32_LEAN_AND_MEAN
+#define WIN32_LEAN_AND_MEAN
+#endif
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+namespace intns::io {
+
+#if defined(_WIN32)
+
+MappedFile::MappedFile(const std::string& filename) {
+  HANDLE file = CreateFileA(filename.c_str(), GENERIC_READ, FILE_SHARE_READ,
+                            nullptr, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL,
+                            nullptr);
+  if (file == INVALID_HANDLE_VALUE) {
+    throw std::runtime_error("Failed to open file: " + filename);
+  }
+
+  LARGE_INTEGER size;
+  if (!GetFileSizeEx(file, &size)) {
+    CloseHandle(file);
+    throw std::runtime_error("Failed to query size of file: " + filename);
+  }
+
+  // Windows can't map empty files
+  if (size.QuadPart == 0) {
+    CloseHandle(file);
+    return;
+  }
+
+  HANDLE mapping =
+      CreateFileMappingA(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+  CloseHandle(file);
+  if (!mapping) {
+    throw std::runtime_error("Failed to map file: " + filename);
+  }
+
+  // The view keeps the mapping alive
+  void* view = MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0);
+  CloseHandle(mapping);
+  if (!view) {
+    throw std::runtime_error("Failed to map file: " + filename);
+  }
+
+  data_ = static_cast<const uint8_t*>(view);
+  size_ = static_cast<size_t>(size.QuadPart);
+}
+
+void MappedFile::reset() noexcept {
+  if (data_) {
+    UnmapViewOfFile(data_);
+  }
+  data_ = nullptr;
+  size_ = 0;
+}
+
+#else
+
+MappedFile::MappedFile(const std::string& filename) {
+  const int fd = ::open(filename.c_str(), O_RDONLY | O_CLOEXEC);
+  if (fd < 0) {
+    throw std::runtime_error("Failed to open file: " + filename);
+  }
+
+  struct stat info;
+  if (::fstat(fd, &info) != 0) {
+    ::close(fd);
+    throw std::runtime_error("Failed to query size of file: " + filename);
+  }
+
+  // mmap rejects zero-length mappings
+  if (info.st_size == 0) {
+    ::close(fd);
+    return;
+  }
+
+  // The mapping stays valid after the descriptor is closed
+  const size_t size = static_cast<size_t>(info.st_size);
+  void* view = ::mmap(nullptr, size, PROT_READ, MAP_PRIVATE, fd, 0);
+  ::close(fd);
+  if (view == MAP_FAILED) {
+    throw std::runtime_error("Failed to map file: " + filename);
+  }
+
+  data_ = static_cast<const uint8_t*>(view);
+  size_ = size;
+}
+
+void MappedFile::reset() noexcept {
+  if (data_) {
+    ::munmap(const_cast<uint8_t*>(data_), size_);
+  }
+  data_ = nullptr;
+  size_ = 0;
+}
+
+#endif
+
+}  // namespace intns::io
@@ -0,0 +1,118 @@
+#ifndef INTNS_IO_MAPPED_FILE_HPP
+#define INTNS_IO_MAPPED_FILE_HPP
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <string>
+
+#include "../memory/PageMemory.hpp"
+
+namespace intns::io {
+
+using memory::PageAdvice;
+
+/**
+ * @brief A read-only memory mapping of an entire file.
+ *
+ * Maps the file with mmap on POSIX systems and CreateFileMapping on Windows,
+ * so its contents can be read in place without syscalls or copies. Pages are
+ * loaded lazily by the OS; use advise() to hint at the access pattern.
+ *
+ * Move-only; the mapping is released on destruction. Moving keeps the mapped
+ * address, so pointers into the file stay valid.
+ *
+ * @section Exception Safety
+ * The constructor throws std::runtime_error if the file cannot be opened or
+ * mapped. Every other method provides the no-throw guarantee.
+ */
+class MappedFile {
+ public:
+  /**
+   * @brief Creates an empty MappedFile mapping nothing.
+   */
+  MappedFile() noexcept = default;
+
+  /**
+   * @brief Opens and maps a file.
+   *
+   * @param filename Path to the file to map.
+   * @throws std::runtime_error If the file cannot be opened or mapped.
+   * @note Empty files are valid and map to an empty range.
+   */
+  explicit MappedFile(const std::string& filename);
+
+  ~MappedFile() { reset(); }
+
+  MappedFile(MappedFile&& other) noexcept
+      : data_(other.data_), size_(other.size_) {
+    other.data_ = nullptr;
+    other.size_ = 0;
+  }
+
+  MappedFile& operator=(MappedFile&& other) noexcept {
+    if (this != &other) {
+      reset();
+      data_ = other.data_;
+      size_ = other.size_;
+      other.data_ = nullptr;
+      other.size_ = 0;
+    }
+    return *this;
+  }
+
+  // Owns the mapping
+  MappedFile(const MappedFile&) = delete;
+  MappedFile& operator=(const MappedFile&) = delete;
+
+  /**
+   * @brief Returns the start of the mapped file.
+   *
+   * @return Pointer to the first byte, or nullptr if empty.
+   */
+  [[nodiscard]] const uint8_t* data() const noexcept { return data_; }
+
+  /**
+   * @brief Returns the size of the mapped file.
+   *
+   * @return The file size in bytes.
+   */
+  [[nodiscard]] size_t size() const noexcept { return size_; }
+
+  /**
+   * @brief Returns the whole mapped file.
+   *
+   * @return A view of every byte in the file.
+   */
+  [[nodiscard]] std::span<const uint8_t> bytes() const noexcept {
+    return {data_, size_};
+  }
+
+  /**
+   * @brief Passes an access pattern hint for part of the file to the OS.
+   *
+   * @param offset Start of the range, clamped to the file size.
+   * @param length Length of the range, clamped to the end of the file.
+   * @param advice The hint, e.g. kSequential or kWillNeed.
+   * @return true if the OS accepted the hint.
+   */
+  bool advise(size_t offset, size_t length, PageAdvice advice) const noexcept {
+    if (offset >= size_) return false;
+    length = std::min(length, size_ - offset);
+    return memory::PageMemory::advise(data_ + offset, length, advice);
+  }
+
+  /**
+   * @brief Unmaps the file, leaving this MappedFile empty.
+   */
+  void reset() noexcept;
+
+ private:
+  const uint8_t* data_ = nullptr;  ///< Start of the mapping.
+  size_t size_ = 0;                ///< Size of the file in bytes.
+};
+
+}  // namespace intns::io
+
+#endif  // INTNS_IO_MAPPED_FILE_HPP
@@ -0,0 +1,137 @@
+#ifndef INTNS_IO_MAPPED_FILE_READER_HPP
+#define INTNS_IO_MAPPED_FILE_READER_HPP
+
+#include <cstdint>
+#include <span>
+#include <string>
+#include <utility>
+
+#include "BinaryReader.hpp"
+#include "IoTypes.hpp"
+#include "MappedFile.hpp"
+
+namespace intns::io {
+
+namespace detail {
+
+/**
+ * @brief Holds the mapping of a MappedFileReader, as a base class so it is
+ * constructed before the MemoryReader reading from it.
+ */
+struct MappedFileHolder {
+  MappedFile file_;  ///< The mapped file.
+};
+
+}  // namespace detail
+
+/**
+ * @brief A binary reader over a memory-mapped file.
+ *
+ * MappedFileReader maps the whole file and reads it in place, so there is no
+ * per-buffer syscall or copy as with FileReader, and set_position() is free.
+ * It exposes exactly the MemoryReader interface, since that is what reads
+ * the mapping.
+ *
+ * @tparam E The endianness for data interpretation (default: little endian).
+ *
+ * @section Usage
+ * Map a file and read data in any order:
+ * @code
+ * MappedFileReader<Endianness::kBig> reader("assets.pak");
+ * uint32_t toc_offset = reader.read_u32();
+ * reader.set_position(toc_offset);
+ * @endcode
+ *
+ * @section Exception Safety
+ * Constructor throws std::runtime_error if the file cannot be opened or
+ * mapped. Reads behave exactly as MemoryReader, throwing std::out_of_range
+ * if attempting to read beyond the end of the file.
+ *
+ * @note The file must not be truncated while mapped; on POSIX systems
+ * reading truncated pages raises SIGBUS.
+ */
+template <Endianness E = Endianness::kLittle>
+class MappedFileReader : private detail::MappedFileHolder,
+                         public MemoryReader<E> {
+ public:
+  /**
+   * @brief Maps the specified file for reading.
+   *
+   * @param filename Path to the file to read.
+   * @param advice Access pattern hint for the whole file (default:
+   * sequential, so the OS reads ahead aggressively).
+   * @throws std::runtime_error If the file cannot be opened or mapped.
+   */
+  explicit MappedFileReader(const std::string& filename,
+                            PageAdvice advice = PageAdvice::kSequential)
+      : MappedFileReader(MappedFile(filename), advice) {}
+
+  /**
+   * @brief Reads from an already mapped file, taking ownership of it.
+   *
+   * @param file The mapped file.
+   * @param advice Access pattern hint for the whole file.
+   */
+  explicit MappedFileReader(MappedFile file,
+                            PageAdvice advice = PageAdvice::kSequential)
+      : detail::MappedFileHolder{std::move(file)},
+        MemoryReader<E>(file_.bytes()) {
+    if (advice != PageAdvice::kNormal) {
+      (void)file_.advise(0, file_.size(), advice);
+    }
+  }
+
+  /**
+   * @brief Returns the whole mapped file.
+   *
+   * @return A view of every byte in the file, valid while the reader lives.
+   */
+  [[nodiscard]] std::span<const uint8_t> bytes() const noexcept {
+    return file_.bytes();
+  }
+
+  /**
+   * @brief Passes an access pattern hint for part of the file to the OS,
+   * e.g. kWillNeed for a range about to be parsed.
+   *
+   * @param offset Start of the range.
+   * @param length Length of the range.
+   * @param advice The hint.
+   * @return true if the OS accepted the hint.
+   */
+  bool advise(size_t offset, size_t length, PageAdvice advice) const noexcept {
+    return file_.advise(offset, length, advice);
+  }
+
+  /**
+   * @brief Hints that the bytes from the current position on will be needed
+   * soon, so the OS starts loading them.
+   *
+   * @param length Number of bytes to prefetch.
+   * @return true if the OS accepted the hint.
+   */
+  bool will_need(size_t length) const noexcept {
+    return file_.advise(this->position(), length, PageAdvice::kWillNeed);
+  }
+
+  /**
+   * @brief Returns the underlying mapping.
+   *
+   * @return The mapped file.
+   */
+  [[nodiscard]] const MappedFile& file() const noexcept { return file_; }
+};
+
+/**
+ * @brief Type alias for little-endian mapped file reader.
+ */
+using LEMappedFileReader = MappedFileReader<Endianness::kLittle>;
+
+/**
+ * @brief Type alias for big-endian mapped file reader.
+ */
+using BEMappedFileReader = MappedFileReader<Endianness::kBig>;
+
+}  // namespace intns::io
+
+#endif  // INTNS_IO_MAPPED_FILE_READER_HPP
@@ -0,0 +1,176 @@
+#include "ReadAhead.hpp"
+
+#include <algorithm>
+#include <cstring>
+#include <stdexcept>
+
+#include "../trace/Trace.hpp"
+
+namespace intns::io {
+
+ReadAheadStream::ReadAheadStream(const std::string& filename,
+                                 const ReadAhead& options) {
+  if (options.buffer_count == 0 || options.buffer_size == 0) {
+    throw std::invalid_argument("Read-ahead buffer count and size cannot be 0");
+  }
+
+  file_.open(filename, std::ios::binary);
+  if (!file_) {
+    throw std::runtime_error("Failed to open file: " + filename);
+  }
+
+  buffers_.resize(options.buffer_count);
+  free_.reserve(options.buffer_count);
+  for (size_t i = 0; i < options.buffer_count; ++i) {
+    buffers_[i].resize(options.buffer_size);
+    free_.push_back(options.buffer_count - 1 - i);  // Fill slot 0 first
+  }
+
+  worker_ = std::thread([this] { run(); });
+}
+
+ReadAheadStream::~ReadAheadStream() {
+  {
+    std::scoped_lock lock(mutex_);
+    stop_ = true;
+  }
+  worker_cv_.notify_one();
+  worker_.join();
+}
+
+size_t ReadAheadStream::read(void* dest, size_t bytes) {
+  auto* out = static_cast<uint8_t*>(dest);
+  size_t copied = 0;
+
+  while (copied < bytes) {
+    if (!has_current_) {
+      std::unique_lock lock(mutex_);
+      const auto filled = [this] {
+        return !ready_.empty() || eof_ || failed_;
+      };
+      if (!filled()) {
+        // The worker has fallen behind
+        INTNS_TRACE_ZONE("ReadAheadStream::wait");
+        consumer_cv_.wait(lock, filled);
+      }
+      if (failed_) {
+        throw std::runtime_error("Failed to read from file");
+      }
+      if (ready_.empty()) {
+        break;  // End of file
+      }
+
+      current_ = ready_.front();
+      ready_.pop_front();
+      has_current_ = true;
+      current_pos_ = 0;
+    }
+
+    const size_t chunk = std::min(bytes - copied, current_.size - current_pos_);
+    std::memcpy(out + copied, buffers_[current_.slot].data() + current_pos_,
+                chunk);
+    copied += chunk;
+    current_pos_ += chunk;
+
+    if (current_pos_ == current_.size) {
+      {
+        std::scoped_lock lock(mutex_);
+        release_current();
+      }
+      worker_cv_.notify_one();
+    }
+  }
+
+  return copied;
+}
+
+void ReadAheadStream::seek(size_t pos) {
+  {
+    std::scoped_lock lock(mutex_);
+    release_current();
+    for (const Block& block : ready_) {
+      free_.push_back(block.slot);
+    }
+    ready_.clear();
+
+    ++epoch_;
+    seek_pos_ = pos;
+    seek_pending_ = true;
+    eof_ = false;
+    failed_ = false;
+  }
+  worker_cv_.notify_one();
+}
+
+void ReadAheadStream::release_current() noexcept {
+  if (has_current_) {
+    free_.push_back(current_.slot);
+    has_current_ = false;
+  }
+}
+
+void ReadAheadStream::run() {
+  uint64_t epoch = 0;
+
+  while (true) {
+    size_t slot = 0;
+    {
+      std::unique_lock lock(mutex_);
+      worker_cv_.wait(lock, [this] {
+        return stop_ || seek_pending_ ||
+               (!free_.empty() && !eof_ && !failed_);
+      });
+      if (stop_) {
+        return;
+      }
+
+      if (seek_pending_) {
+        seek_pending_ = false;
+        epoch = epoch_;
+        file_.clear();
+        file_.seekg(static_cast<std::streamoff>(seek_pos_));
+        if (!file_) {
+          failed_ = true;
+          consumer_cv_.notify_one();
+          continue;
+        }
+        if (free_.empty() || eof_) {
+          continue;
+        }
+      }
+
+      slot = free_.back();
+      free_.pop_back();
+    }
+
+    // The slow part, done without holding the lock
+    std::vector<uint8_t>& buffer = buffers_[slot];
+    file_.read(reinterpret_cast<char*>(buffer.data()),
+               static_cast<std::streamsize>(buffer.size()));
+    const auto got = static_cast<size_t>(file_.gcount());
+    const bool bad = file_.bad();
+
+    {
+      std::scoped_lock lock(mutex_);
+      if (epoch != epoch_) {
+        free_.push_back(slot);  // A seek made these bytes stale
+        continue;
+      }
+
+      if (bad) {
+        failed_ = true;
+        free_.push_back(slot);
+      } else {
+        if (got > 0) {
+          ready_.push_back(Block{slot, got});
+        } else {
+          free_.push_back(slot);
+        }
+        eof_ = got < buffer.size();
+      }
+    }
+    consumer_cv_.notify_one();
+  }
+}
+
+}  // namespace intns::io
@@ -0,0 +1,132 @@
+#ifndef INTNS_IO_READ_AHEAD_HPP
+#define INTNS_IO_READ_AHEAD_HPP
+
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <fstream>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "InputStream.hpp"
+
+namespace intns::io {
+
+/**
+ * @brief Read-ahead settings for FileReader.
+ */
+struct ReadAhead {
+  // Buffers a background thread keeps filled ahead of the parser; 0
+  // disables read-ahead and reads on the calling thread
+  size_t buffer_count = 0;
+
+  // Bytes read per buffer
+  size_t buffer_size = 256 * 1024;
+};
+
+/**
+ * @brief A file stream read by a background thread ahead of its consumer.
+ *
+ * The worker keeps up to `buffer_count` buffers filled with the bytes that
+ * follow the consumer's position, so reading overlaps parsing. read() only
+ * blocks when the worker has fallen behind; seek() discards everything read
+ * ahead and restarts the worker at the new position.
+ *
+ * Also usable as the InputStream of a StreamReader, e.g. under a
+ * DecompressStream so decompression overlaps reading the compressed file.
+ *
+ * @note read() and seek() must be called from one thread at a time.
+ */
+class ReadAheadStream final : public InputStream {
+ public:
+  /**
+   * @brief Opens a file and starts reading it in the background.
+   *
+   * @param filename Path to the file to read.
+   * @param options Buffer count and size.
+   * @throws std::runtime_error If the file cannot be opened.
+   * @throws std::invalid_argument If the buffer count or size is 0.
+   */
+  ReadAheadStream(const std::string& filename, const ReadAhead& options);
+
+  /**
+   * @brief Stops and joins the background thread.
+   */
+  ~ReadAheadStream() override;
+
+  // The worker refers to the stream by address
+  ReadAheadStream(const ReadAheadStream&) = delete;
+  ReadAheadStream& operator=(const ReadAheadStream&) = delete;
+  ReadAheadStream(ReadAheadStream&&) = delete;
+  ReadAheadStream& operator=(ReadAheadStream&&) = delete;
+
+  /**
+   * @brief Copies the next bytes of the file, waiting for the worker if it
+   * hasn't read them yet.
+   *
+   * @param dest Destination buffer.
+   * @param bytes Number of bytes wanted.
+   * @return The number of bytes copied, less than `bytes` only at end of
+   * file.
+   * @throws std::runtime_error If the background read failed.
+   */
+  size_t read(void* dest, size_t bytes) override;
+
+  /**
+   * @brief Moves the stream to an absolute position, discarding every
+   * buffer read ahead. Also clears an earlier read failure, so reading can
+   * be retried.
+   *
+   * @param pos The new position.
+   */
+  void seek(size_t pos);
+
+ private:
+  /**
+   * @brief A filled buffer waiting to be consumed.
+   */
+  struct Block {
+    size_t slot = 0;  // Index into buffers_
+    size_t size = 0;  // Valid bytes in the buffer
+  };
+
+  // Body of the background thread
+  void run();
+
+  // Returns the consumer's current buffer to the worker, caller holds mutex_
+  void release_current() noexcept;
+
+  // Only touched by the worker once started
+  std::ifstream file_;
+
+  // Every read-ahead buffer
+  std::vector<std::vector<uint8_t>> buffers_;
+
+  std::mutex mutex_;
+  std::condition_variable worker_cv_;    // Signals free buffers and seeks
+  std::condition_variable consumer_cv_;  // Signals filled buffers
+
+  // Guarded by mutex_
+  std::vector<size_t> free_;   // Buffers the worker may fill
+  std::deque<Block> ready_;    // Filled buffers, in file order
+  uint64_t epoch_ = 0;         // Bumped by every seek
+  size_t seek_pos_ = 0;        // Where the worker resumes after a seek
+  bool seek_pending_ = false;  // Worker must reposition before reading on
+  bool eof_ = false;           // Worker reached the end for this epoch
+  bool failed_ = false;        // A background read failed this epoch
+  bool stop_ = false;          // Destructor asked the worker to exit
+
+  // Consumer-side state
+  Block current_{};           // Buffer being consumed
+  bool has_current_ = false;  // Whether current_ is held
+  size_t current_pos_ = 0;    // Bytes of current_ already consumed
+
+  std::thread worker_;  // Started last, once everything else exists
+};
+
+}  // namespace intns::io
+
+#endif  // INTNS_IO_READ_AHEAD_HPP
@@ -0,0 +1,225 @@
+#ifndef INTNS_IO_READ_CURSOR_HPP
+#define INTNS_IO_READ_CURSOR_HPP
+
+#include <bit>
+#include <cassert>
+#include <cstdint>
+#include <cstring>
+#include <span>
+#include <string_view>
+
+#include "IoTypes.hpp"
+#include "Schema.hpp"
+
+namespace intns::io {
+
+/**
+ * @brief An unchecked reader over a range already validated by a reader's
+ * reserve().
+ *
+ * Reads compile to plain loads plus a byte swap where the endianness differs,
+ * with no bounds checks or error paths, so consecutive reads can be fused by
+ * the compiler. The cursor is two pointers and is meant to be passed around
+ * by value.
+ *
+ * @tparam E The endianness for data interpretation (default: little endian).
+ *
+ * @section Usage
+ * Validate a fixed-size header once, then read it unchecked:
+ * @code
+ * auto header = reader.reserve(40);
+ * uint32_t magic = header.read_u32();
+ * uint32_t count = header.read_u32();
+ * @endcode
+ *
+ * @warning Reading past the reserved range is undefined behaviour; debug
+ * builds assert on it. The cursor is only valid as long as the bytes it
+ * points to, see the reserve() of each reader.
+ */
+template <Endianness E = Endianness::kLittle>
+class ReadCursor {
+ public:
+  /**
+   * @brief Creates a cursor over `size` bytes starting at `data`.
+   *
+   * @param data Start of the validated range.
+   * @param size Size of the validated range in bytes.
+   */
+  ReadCursor(const uint8_t* data, size_t size) noexcept
+      : pos_(data), end_(data + size) {}
+
+  /**
+   * @brief Returns the number of reserved bytes not yet read.
+   *
+   * @return The bytes left in the range.
+   */
+  [[nodiscard]] size_t remaining() const noexcept {
+    return static_cast<size_t>(end_ - pos_);
+  }
+
+  /**
+   * @brief Skips bytes within the range.
+   *
+   * @param bytes The number of bytes to skip.
+   */
+  void skip(size_t bytes) noexcept {
+    assert(bytes <= remaining() && "ReadCursor: skipped past reserved range");
+    pos_ += bytes;
+  }
+
+  /**
+   * @brief Reads an unsigned 8-bit integer.
+   * @return The value read.
+   */
+  [[nodiscard]] uint8_t read_u8() noexcept { return load<uint8_t>(); }
+
+  /**
+   * @brief Reads an unsigned 16-bit integer with endianness conversion.
+   * @return The value read.
+   */
+  [[nodiscard]] uint16_t read_u16() noexcept { return load<uint16_t>(); }
+
+  /**
+   * @brief Reads an unsigned 32-bit integer with endianness conversion.
+   * @return The value read.
+   */
+  [[nodiscard]] uint32_t read_u32() noexcept { return load<uint32_t>(); }
+
+  /**
+   * @brief Reads an unsigned 64-bit integer with endianness conversion.
+   * @return The value read.
+   */
+  [[nodiscard]] uint64_t read_u64() noexcept { return load<uint64_t>(); }
+
+  /**
+   * @brief Reads a signed 8-bit integer.
+   * @return The value read.
+   */
+  [[nodiscard]] int8_t read_s8() noexcept {
+    return static_cast<int8_t>(read_u8());
+  }
+
+  /**
+   * @brief Reads a signed 16-bit integer with endianness conversion.
+   * @return The value read.
+   */
+  [[nodiscard]] int16_t read_s16() noexcept {
+    return static_cast<int16_t>(read_u16());
+  }
+
+  /**
+   * @brief Reads a signed 32-bit integer with endianness conversion.
+   * @return The value read.
+   */
+  [[nodiscard]] int32_t read_s32() noexcept {
+    return static_cast<int32_t>(read_u32());
+  }
+
+  /**
+   * @brief Reads a signed 64-bit integer with endianness conversion.
+   * @return The value read.
+   */
+  [[nodiscard]] int64_t read_s64() noexcept {
+    return static_cast<int64_t>(read_u64());
+  }
+
+  /**
+   * @brief Reads a 32-bit floating-point value with endianness conversion.
+   * @return The value read.
+   */
+  [[nodiscard]] float read_f32() noexcept {
+    return std::bit_cast<float>(read_u32());
+  }
+
+  /**
+   * @brief Reads a 64-bit floating-point value with endianness conversion.
+   * @return The value read.
+   */
+  [[nodiscard]] double read_f64() noexcept {
+    return std::bit_cast<double>(read_u64());
+  }
+
+  /**
+   * @brief Copies raw bytes into a destination buffer.
+   *
+   * @param dest Pointer to the destination buffer.
+   * @param bytes Number of bytes to read.
+   */
+  void read_bytes(void* dest, size_t bytes) noexcept {
+    assert(bytes <= remaining() && "ReadCursor: read past reserved range");
+    std::memcpy(dest, pos_, bytes);
+    pos_ += bytes;
+  }
+
+  /**
+   * @brief Reads raw bytes without copying them.
+   *
+   * @param bytes Number of bytes to read.
+   * @return A view of the bytes, valid as long as the cursor is.
+   */
+  [[nodiscard]] std::span<const uint8_t> read_view(size_t bytes) noexcept {
+    assert(bytes <= remaining() && "ReadCursor: read past reserved range");
+    std::span<const uint8_t> view(pos_, bytes);
+    pos_ += bytes;
+    return view;
+  }
+
+  /**
+   * @brief Reads a fixed-length string without copying it.
+   *
+   * @param length Number of bytes to read.
+   * @return A view of the string, valid as long as the cursor is.
+   */
+  [[nodiscard]] std::string_view read_string_view(size_t length) noexcept {
+    assert(length <= remaining() && "ReadCursor: read past reserved range");
+    std::string_view view(reinterpret_cast<const char*>(pos_), length);
+    pos_ += length;
+    return view;
+  }
+
+  /**
+   * @brief Reads a record or other WireType laid out as described in
+   * Schema.hpp.
+   *
+   * @tparam T The type to read.
+   * @return The value read.
+   */
+  template <WireType T>
+  [[nodiscard]] T read() noexcept {
+    assert(wire_size<T>() <= remaining() &&
+           "ReadCursor: read past reserved range");
+    T value{};
+    detail::decode<E>(pos_, value);
+    return value;
+  }
+
+ private:
+  /**
+   * @brief Loads a T from the current position with endianness conversion.
+   */
+  template <typename T>
+  [[nodiscard]] T load() noexcept {
+    assert(sizeof(T) <= remaining() && "ReadCursor: read past reserved range");
+    T value;
+    std::memcpy(&value, pos_, sizeof(T));
+    pos_ += sizeof(T);
+
+    if constexpr (sizeof(T) > 1 && E != native_endianness()) {
+      if constexpr (sizeof(T) == 2) {
+        value = bswap_16(value);
+      } else if constexpr (sizeof(T) == 4) {
+        value = bswap_32(value);
+      } else {
+        value = bswap_64(value);
+      }
+    }
+    return value;
+  }
+
+  const uint8_t* pos_;  ///< Next byte to read.
+  const uint8_t* end_;  ///< End of the reserved range.
+};
+
+}  // namespace intns::io
+
+#endif  // INTNS_IO_READ_CURSOR_HPP
@@ -0,0 +1,334 @@
+#ifndef INTNS_IO_SCHEMA_HPP
+#define INTNS_IO_SCHEMA_HPP
+
+#include <array>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+
+#include "IoTypes.hpp"
+
+namespace intns::io {
+
+// Most fields a record may have
+inline constexpr size_t kMaxRecordFields = 16;
+
+namespace detail {
+
+// Converts to anything, used to count an aggregate's fields
+struct AnyField {
+  template <typename T>
+  operator T() const noexcept;
+};
+
+template <typename T, size_t... I>
+constexpr bool brace_constructible(std::index_sequence<I...>) noexcept {
+  return requires { T{(void(I), AnyField{})...}; };
+}
+
+template <typename T, size_t... I>
+constexpr bool nested_brace_constructible(std::index_sequence<I...>) noexcept {
+  return requires { T{{(void(I), AnyField{})}...}; };
+}
+
+// Most initializers T accepts, which is its field count
+template <typename T, size_t N = 0>
+constexpr size_t count_fields() noexcept {
+  if constexpr (N > kMaxRecordFields) {
+    return N;
+  } else if constexpr (brace_constructible<T>(
+                           std::make_index_sequence<N + 1>{})) {
+    return count_fields<T, N + 1>();
+  } else {
+    return N;
+  }
+}
+
+// Most initializers T accepts when each is braced. Braces cannot be elided
+// into a C array member then, so this differs from count_fields() exactly
+// when T has one and structured bindings would see fewer fields.
+template <typename T, size_t N = 0>
+constexpr size_t count_braced_fields() noexcept {
+  if constexpr (N > kMaxRecordFields) {
+    return N;
+  } else if constexpr (nested_brace_constructible<T>(
+                           std::make_index_sequence<N + 1>{})) {
+    return count_braced_fields<T, N + 1>();
+  } else {
+    return N;
+  }
+}
+
+template <typename T>
+struct is_std_array : std::false_type {};
+
+template <typename T, size_t N>
+struct is_std_array<std::array<T, N>> : std::true_type {};
+
+template <typename T>
+constexpr bool is_record_candidate() noexcept {
+  return std::is_class_v<T> && std::is_aggregate_v<T> && !std::is_union_v<T> &&
+         !is_std_array<T>::value;
+}
+
+/**
+ * @brief Returns references to every field of a record, in declaration
+ * order.
+ */
+template <typename T>
+constexpr auto tie_fields(T& value) noexcept {
+  constexpr size_t kCount = count_fields<std::remove_cv_t<T>>();
+  static_assert(kCount >= 1 && kCount <= kMaxRecordFields,
+                "Records must have between 1 and kMaxRecordFields fields");
+
+  if constexpr (kCount == 1) {
+    auto& [f0] = value;
+    return std::tie(f0);
+  } else if constexpr (kCount == 2) {
+    auto& [f0, f1] = value;
+    return std::tie(f0, f1);
+  } else if constexpr (kCount == 3) {
+    auto& [f0, f1, f2] = value;
+    return std::tie(f0, f1, f2);
+  } else if constexpr (kCount == 4) {
+    auto& [f0, f1, f2, f3] = value;
+    return std::tie(f0, f1, f2, f3);
+  } else if constexpr (kCount == 5) {
+    auto& [f0, f1, f2, f3, f4] = value;
+    return std::tie(f0, f1, f2, f3, f4);
+  } else if constexpr (kCount == 6) {
+    auto& [f0, f1, f2, f3, f4, f5] = value;
+    return std::tie(f0, f1, f2, f3, f4, f5);
+  } else if constexpr (kCount == 7) {
+    auto& [f0, f1, f2, f3, f4, f5, f6] = value;
+    return std::tie(f0, f1, f2, f3, f4, f5, f6);
+  } else if constexpr (kCount == 8) {
+    auto& [f0, f1, f2, f3, f4, f5, f6, f7] = value;
+    return std::tie(f0, f1, f2, f3, f4, f5, f6, f7);
+  } else if constexpr (kCount == 9) {
+    auto& [f0, f1, f2, f3, f4, f5, f6, f7, f8] = value;
+    return std::tie(f0, f1, f2, f3, f4, f5, f6, f7, f8);
+  } else if constexpr (kCount == 10) {
+    auto& [f0, f1, f2, f3, f4, f5, f6, f7, f8, f9] = value;
+    return std::tie(f0, f1, f2, f3, f4, f5, f6, f7, f8, f9);
+  } else if constexpr (kCount == 11) {
+    auto& [f0, f1, f2, f3, f4, f5, f6, f7, f8, f9, f10] = value;
+    return std::tie(f0, f1, f2, f3, f4, f5, f6, f7, f8, f9, f10);
+  } else if constexpr (kCount == 12) {
+    auto& [f0, f1, f2, f3, f4, f5, f6, f7, f8, f9, f10, f11] = value;
+    return std::tie(f0, f1, f2, f3, f4, f5, f6, f7, f8, f9, f10, f11);
+  } else if constexpr (kCount == 13) {
+    auto& [f0, f1, f2, f3, f4, f5, f6, f7, f8, f9, f10, f11, f12] = value;
+    return std::tie(f0, f1, f2, f3, f4, f5, f6, f7, f8, f9, f10, f11, f12);
+  } else if constexpr (kCount == 14) {
+    auto& [f0, f1, f2, f3, f4, f5, f6, f7, f8, f9, f10, f11, f12, f13] = value;
+    return std::tie(f0, f1, f2, f3, f4, f5, f6, f7, f8, f9, f10, f11, f12, f13);
+  } else if constexpr (kCount == 15) {
+    auto& [f0, f1, f2, f3, f4, f5, f6, f7, f8, f9, f10, f11, f12, f13,
+          f14] = value;
+    return std::tie(f0, f1, f2, f3, f4, f5, f6, f7, f8, f9, f10, f11, f12, f13,
+                    f14);
+  } else if constexpr (kCount == 16) {
+    auto& [f0, f1, f2, f3, f4, f5, f6, f7, f8, f9, f10, f11, f12, f13, f14,
+          f15] = value;
+    return std::tie(f0, f1, f2, f3, f4, f5, f6, f7, f8, f9, f10, f11, f12, f13,
+                    f14, f15);
+  }
+}
+
+template <typename T>
+using fields_t = decltype(tie_fields(std::declval<T&>()));
+
+template <typename T>
+constexpr bool is_wire_type() noexcept;
+
+template <typename Tuple, size_t... I>
+constexpr bool all_wire_types(std::index_sequence<I...>) noexcept {
+  return (is_wire_type<
+              std::remove_reference_t<std::tuple_element_t<I, Tuple>>>() &&
+          ...);
+}
+
+template <typename T>
+constexpr bool is_wire_type() noexcept {
+  using U = std::remove_cv_t<T>;
+  if constexpr (std::is_arithmetic_v<U> || std::is_enum_v<U>) {
+    return sizeof(U) == 1 || sizeof(U) == 2 || sizeof(U) == 4 ||
+           sizeof(U) == 8;
+  } else if constexpr (is_std_array<U>::value) {
+    return is_wire_type<typename U::value_type>();
+  } else if constexpr (is_record_candidate<U>()) {
+    constexpr size_t kCount = count_fields<U>();
+    if constexpr (kCount >= 1 && kCount <= kMaxRecordFields &&
+                  kCount == count_braced_fields<U>()) {
+      using Fields = fields_t<U>;
+      return all_wire_types<Fields>(
+          std::make_index_sequence<std::tuple_size_v<Fields>>{});
+    } else {
+      return false;
+    }
+  } else {
+    return false;
+  }
+}
+
+}  // namespace detail
+
+/**
+ * @brief Types the readers and writers can handle with read<T>(),
+ * read_array<T>(), write<T>() and write_array<T>().
+ *
+ * A record is read field by field in declaration order, discovered through
+ * structured bindings, so plain structs need no descriptor:
+ * @code
+ * struct Vertex {
+ *   std::array<float, 3> position;
+ *   uint32_t colour;
+ * };
+ * Vertex v = reader.read<Vertex>();
+ * @endcode
+ *
+ * Fields are packed back to back on the wire, each in the reader's
+ * endianness. Supported field types are 1, 2, 4 and 8 byte arithmetic types
+ * and enums, std::array of supported types, and nested records: aggregates
+ * without base classes or C arrays, of up to kMaxRecordFields fields.
+ *
+ * When a record is trivially copyable, has no padding and needs no byte
+ * swapping, its wire layout is its memory layout and reads collapse to a
+ * single memcpy; otherwise a per-field load and swap sequence is generated.
+ */
+template <typename T>
+concept WireType = detail::is_wire_type<T>();
+
+/**
+ * @brief Returns the size of a type on the wire, with fields packed.
+ *
+ * @tparam T The type.
+ * @return The number of bytes read for one T.
+ */
+template <WireType T>
+constexpr size_t wire_size() noexcept {
+  using U = std::remove_cv_t<T>;
+  if constexpr (std::is_arithmetic_v<U> || std::is_enum_v<U>) {
+    return sizeof(U);
+  } else if constexpr (detail::is_std_array<U>::value) {
+    return std::tuple_size_v<U> * wire_size<typename U::value_type>();
+  } else {
+    using Fields = detail::fields_t<U>;
+    return []<size_t... I>(std::index_sequence<I...>) {
+      return (wire_size<std::remove_reference_t<
+                  std::tuple_element_t<I, Fields>>>() +
+              ...);
+    }(std::make_index_sequence<std::tuple_size_v<Fields>>{});
+  }
+}
+
+/**
+ * @brief Checks whether any part of a type is wider than a byte, so it
+ * changes with endianness.
+ *
+ * @tparam T The type.
+ * @return true if reading T in a foreign endianness needs byte swaps.
+ */
+template <WireType T>
+constexpr bool needs_swap() noexcept {
+  using U = std::remove_cv_t<T>;
+  if constexpr (std::is_arithmetic_v<U> || std::is_enum_v<U>) {
+    return sizeof(U) > 1;
+  } else if constexpr (detail::is_std_array<U>::value) {
+    return needs_swap<typename U::value_type>();
+  } else {
+    using Fields = detail::fields_t<U>;
+    return []<size_t... I>(std::index_sequence<I...>) {
+      return (needs_swap<std::remove_reference_t<
+                  std::tuple_element_t<I, Fields>>>() ||
+              ...);
+    }(std::make_index_sequence<std::tuple_size_v<Fields>>{});
+  }
+}
+
+/**
+ * @brief Checks whether a type's wire layout in endianness E is exactly its
+ * memory layout, so it can be read with a single memcpy.
+ *
+ * @tparam T The type.
+ * @tparam E The endianness of the data.
+ * @return true if T is trivially copyable, has no padding at any level, and
+ * needs no byte swaps in endianness E.
+ */
+template <WireType T, Endianness E>
+constexpr bool has_native_layout() noexcept {
+  return std::is_trivially_copyable_v<T> && wire_size<T>() == sizeof(T) &&
+         (E == native_endianness() || !needs_swap<T>());
+}
+
+namespace detail {
+
+template <typename U>
+U swap_bytes(U value) noexcept {
+  if constexpr (sizeof(U) == 2) {
+    return std::bit_cast<U>(bswap_16(std::bit_cast<uint16_t>(value)));
+  } else if constexpr (sizeof(U) == 4) {
+    return std::bit_cast<U>(bswap_32(std::bit_cast<uint32_t>(value)));
+  } else if constexpr (sizeof(U) == 8) {
+    return std::bit_cast<U>(bswap_64(std::bit_cast<uint64_t>(value)));
+  } else {
+    return value;
+  }
+}
+
+/**
+ * @brief Decodes one T from `src` in endianness E, advancing `src` past its
+ * wire size.
+ */
+template <Endianness E, WireType T>
+void decode(const uint8_t*& src, T& out) noexcept {
+  if constexpr (has_native_layout<T, E>()) {
+    std::memcpy(&out, src, sizeof(T));
+    src += sizeof(T);
+  } else if constexpr (std::is_arithmetic_v<T> || std::is_enum_v<T>) {
+    std::memcpy(&out, src, sizeof(T));
+    src += sizeof(T);
+    out = swap_bytes(out);
+  } else if constexpr (is_std_array<T>::value) {
+    for (auto& element : out) {
+      decode<E>(src, element);
+    }
+  } else {
+    std::apply([&src](auto&... fields) { (decode<E>(src, fields), ...); },
+               tie_fields(out));
+  }
+}
+
+/**
+ * @brief Encodes one T into `dst` in endianness E, advancing `dst` past its
+ * wire size.
+ */
+template <Endianness E, WireType T>
+void encode(uint8_t*& dst, const T& value) noexcept {
+  if constexpr (has_native_layout<T, E>()) {
+    std::memcpy(dst, &value, sizeof(T));
+    dst += sizeof(T);
+  } else if constexpr (std::is_arithmetic_v<T> || std::is_enum_v<T>) {
+    const T swapped = swap_bytes(value);
+    std::memcpy(dst, &swapped, sizeof(T));
+    dst += sizeof(T);
+  } else if constexpr (is_std_array<T>::value) {
+    for (const auto& element : value) {
+      encode<E>(dst, element);
+    }
+  } else {
+    std::apply([&dst](const auto&... fields) { (encode<E>(dst, fields), ...); },
+               tie_fields(value));
+  }
+}
+
+}  // namespace detail
+
+}  // namespace intns::io
+
+#endif  // INTNS_IO_SCHEMA_HPP
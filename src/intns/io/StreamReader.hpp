@@ -0,0 +1,136 @@
+#ifndef INTNS_IO_STREAM_READER_HPP
+#define INTNS_IO_STREAM_READER_HPP
+
+#include <cstdint>
+#include <memory>
+#include <stdexcept>
+#include <string>
+
+#include "BufferedReader.hpp"
+#include "Decompress.hpp"
+#include "InputStream.hpp"
+#include "IoTypes.hpp"
+
+namespace intns::io {
+
+/**
+ * @brief A forward-only binary reader over an InputStream, e.g. a
+ * decompressed file.
+ *
+ * StreamReader offers FileReader's read operations over any InputStream.
+ * Data is pulled through an internal buffer one block at a time, so memory
+ * use is bounded by the buffer size and parsing starts as soon as the first
+ * block is decoded, however large the stream is.
+ *
+ * Since streams cannot seek, there is no size(), remaining() or
+ * set_position(); skip() reads and discards.
+ *
+ * @tparam E The endianness for data interpretation (default: little endian).
+ *
+ * @section Usage
+ * Open a file, decompressing it if its header names a supported format:
+ * @code
+ * StreamReader<Endianness::kLittle> reader("scene.bin.zst");
+ * uint32_t magic = reader.read_u32();
+ * auto names = reader.read_cstring_table(reader.read_u32());
+ * @endcode
+ *
+ * @section Exception Safety
+ * Read operations throw std::out_of_range if attempting to read beyond the
+ * end of the stream, and std::runtime_error if the stream itself fails,
+ * e.g. on corrupt compressed data.
+ */
+template <Endianness E = Endianness::kLittle>
+class StreamReader : public BufferedReader<StreamReader<E>, E> {
+ public:
+  /**
+   * @brief The smallest buffer used, enough for any primitive or LEB128
+   * value.
+   */
+  static constexpr size_t kMinBufferSize = 16;
+
+  /**
+   * @brief Constructs a StreamReader over an InputStream.
+   *
+   * @param source The stream to read.
+   * @param buffer_size Size of the internal buffer (default: 64 KiB),
+   * raised to kMinBufferSize if smaller so any single value fits.
+   * @throws std::invalid_argument If source is null or buffer_size is 0.
+   */
+  explicit StreamReader(std::unique_ptr<InputStream> source,
+                        size_t buffer_size = 64 * 1024)
+      : BufferedReader<StreamReader<E>, E>(buffer_size, kMinBufferSize),
+        source_(std::move(source)) {
+    if (!source_) {
+      throw std::invalid_argument("Stream source cannot be null");
+    }
+  }
+
+  /**
+   * @brief Constructs a StreamReader over a file, decompressing it if it is
+   * compressed, see open_input_stream().
+   *
+   * @param filename Path to the file to read.
+   * @param buffer_size Size of the internal buffer (default: 64 KiB).
+   * @param read_ahead Background read-ahead settings (default: disabled).
+   * @throws std::runtime_error If the file cannot be opened, or uses a
+   * format the library was built without.
+   * @throws std::invalid_argument If buffer_size is 0.
+   */
+  explicit StreamReader(const std::string& filename,
+                        size_t buffer_size = 64 * 1024,
+                        const ReadAhead& read_ahead = {})
+      : StreamReader(open_input_stream(filename, read_ahead), buffer_size) {}
+
+  /**
+   * @brief Checks whether every byte of the stream has been read.
+   *
+   * @return true if no bytes remain.
+   * @throws std::runtime_error If the stream fails.
+   */
+  [[nodiscard]] bool at_end() {
+    if (this->buffer_remaining() == 0) {
+      this->refill();
+    }
+    return this->buffer_remaining() == 0;
+  }
+
+  /**
+   * @brief Reads and discards bytes.
+   *
+   * @param bytes The number of bytes to skip.
+   * @throws std::out_of_range If the stream ends first.
+   */
+  void skip(size_t bytes) { this->discard(bytes); }
+
+ private:
+  friend class BufferedReader<StreamReader<E>, E>;
+
+  static constexpr const char* kSourceName = "stream";
+
+  /**
+   * @brief Reads the next bytes of the stream.
+   *
+   * @return The number of bytes read, less than `bytes` only at the end.
+   * @throws std::runtime_error If the stream fails.
+   */
+  size_t read_source(uint8_t* dest, size_t bytes) {
+    return source_->read(dest, bytes);
+  }
+
+  std::unique_ptr<InputStream> source_;  ///< The stream being read.
+};
+
+/**
+ * @brief Type alias for little-endian stream reader.
+ */
+using LEStreamReader = StreamReader<Endianness::kLittle>;
+
+/**
+ * @brief Type alias for big-endian stream reader.
+ */
+using BEStreamReader = StreamReader<Endianness::kBig>;
+
+}  // namespace intns::io
+
+#endif  // INTNS_IO_STREAM_READER_HPP
@@ -0,0 +1,106 @@
+#ifndef INTNS_IO_STRING_TABLE_HPP
+#define INTNS_IO_STRING_TABLE_HPP
+
+#include <cstddef>
+#include <span>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+namespace intns::io {
+
+/**
+ * @brief A table of strings read in one pass by read_cstring_table().
+ *
+ * Each entry is a view, either into the reader's buffer (MemoryReader) or
+ * into a single block owned by the table (FileReader), in which case every
+ * string is followed by its null terminator so data() can be passed to C
+ * APIs.
+ *
+ * @note Moving a table keeps its views valid; copying is disabled since the
+ * copies would point into the original's storage.
+ */
+class StringTable {
+ public:
+  using const_iterator = std::vector<std::string_view>::const_iterator;
+
+  /**
+   * @brief Creates an empty table.
+   */
+  StringTable() = default;
+
+  /**
+   * @brief Creates a table of views into storage owned elsewhere.
+   *
+   * @param views The strings, which must outlive the table.
+   */
+  explicit StringTable(std::vector<std::string_view> views) noexcept
+      : views_(std::move(views)) {}
+
+  /**
+   * @brief Creates a table owning its strings, stored back to back in
+   * `storage` each followed by a null terminator.
+   *
+   * @param storage The strings and their terminators.
+   * @param lengths The length of each string, without its terminator.
+   */
+  StringTable(std::vector<char> storage, std::span<const size_t> lengths)
+      : storage_(std::move(storage)) {
+    views_.reserve(lengths.size());
+    const char* next = storage_.data();
+    for (size_t length : lengths) {
+      views_.emplace_back(next, length);
+      next += length + 1;
+    }
+  }
+
+  StringTable(const StringTable&) = delete;
+  StringTable& operator=(const StringTable&) = delete;
+  StringTable(StringTable&&) noexcept = default;
+  StringTable& operator=(StringTable&&) noexcept = default;
+
+  /**
+   * @brief Returns the number of strings in the table.
+   */
+  [[nodiscard]] size_t size() const noexcept { return views_.size(); }
+
+  /**
+   * @brief Checks whether the table holds no strings.
+   */
+  [[nodiscard]] bool empty() const noexcept { return views_.empty(); }
+
+  /**
+   * @brief Returns the string at `index`, which must be less than size().
+   */
+  [[nodiscard]] std::string_view operator[](size_t index) const noexcept {
+    return views_[index];
+  }
+
+  /**
+   * @brief Returns every string in table order.
+   */
+  [[nodiscard]] std::span<const std::string_view> views() const noexcept {
+    return views_;
+  }
+
+  /**
+   * @brief Returns the bytes owned by the table, 0 if it borrows its
+   * strings.
+   */
+  [[nodiscard]] size_t storage_size() const noexcept {
+    return storage_.size();
+  }
+
+  [[nodiscard]] const_iterator begin() const noexcept {
+    return views_.begin();
+  }
+  [[nodiscard]] const_iterator end() const noexcept { return views_.end(); }
+
+ private:
+  std::vector<char> storage_;            ///< Owned strings, if any.
+  std::vector<std::string_view> views_;  ///< One view per string.
+};
+
+}  // namespace intns::io
+
+#endif  // INTNS_IO_STRING_TABLE_HPP
@@ -0,0 +1,131 @@
+#ifndef INTNS_IO_VARINT_HPP
+#define INTNS_IO_VARINT_HPP
+
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <stdexcept>
+#include <string>
+
+#include "IoTypes.hpp"
+
+namespace intns::io {
+
+/**
+ * @brief The most bytes a 64-bit LEB128 value can take.
+ */
+inline constexpr size_t kMaxLeb128Bytes = 10;
+
+/**
+ * @brief Maps a signed value to an unsigned one with small magnitudes first
+ * (0, -1, 1, -2, ... become 0, 1, 2, 3, ...), as used by zigzag varints.
+ *
+ * @param value The signed value.
+ * @return The zigzag encoding of `value`.
+ */
+[[nodiscard]] constexpr uint64_t zigzag_encode(int64_t value) noexcept {
+  return (static_cast<uint64_t>(value) << 1) ^
+         static_cast<uint64_t>(value >> 63);
+}
+
+/**
+ * @brief Reverses zigzag_encode().
+ *
+ * @param value The zigzag encoded value.
+ * @return The signed value.
+ */
+[[nodiscard]] constexpr int64_t zigzag_decode(uint64_t value) noexcept {
+  return static_cast<int64_t>((value >> 1) ^ (~(value & 1) + 1));
+}
+
+namespace detail {
+
+// Decodes one byte at a time, for the 9th and 10th bytes of long values and
+// for values near the end of the buffer
+template <bool Signed>
+size_t decode_leb128_bytewise(const uint8_t* data, size_t size,
+                              uint64_t& value) noexcept {
+  const size_t limit = size < kMaxLeb128Bytes ? size : kMaxLeb128Bytes;
+  uint64_t result = 0;
+  for (size_t i = 0; i < limit; ++i) {
+    const uint8_t byte = data[i];
+    if (i == kMaxLeb128Bytes - 1) {
+      // Only bit 63 is left: anything else overflows, or for signed values
+      // must repeat the sign
+      const bool valid = Signed ? byte == 0x00 || byte == 0x7f : byte <= 0x01;
+      if (!valid) return 0;
+      value = result | (static_cast<uint64_t>(byte & 1) << 63);
+      return kMaxLeb128Bytes;
+    }
+
+    result |= static_cast<uint64_t>(byte & 0x7f) << (7 * i);
+    if ((byte & 0x80) == 0) {
+      const unsigned shift = 7 * static_cast<unsigned>(i + 1);
+      if (Signed && (byte & 0x40)) {
+        result |= ~uint64_t{0} << shift;
+      }
+      value = result;
+      return i + 1;
+    }
+  }
+  return 0;
+}
+
+// Decodes a LEB128 value from at most `size` bytes. Values of up to 8 bytes
+// are found with one 8-byte load: the first clear continuation bit gives the
+// length, and the 7-bit groups are packed together with masks and shifts.
+// Returns the bytes consumed, or 0 if the value is truncated or malformed.
+template <bool Signed>
+size_t decode_leb128(const uint8_t* data, size_t size,
+                     uint64_t& value) noexcept {
+  if (size < 8) {
+    return decode_leb128_bytewise<Signed>(data, size, value);
+  }
+
+  uint64_t word;
+  std::memcpy(&word, data, 8);
+  if constexpr (native_endianness() == Endianness::kBig) {
+    word = bswap_64(word);
+  }
+
+  const uint64_t stops = ~word & 0x8080808080808080ull;
+  if (stops == 0) {
+    return decode_leb128_bytewise<Signed>(data, size, value);
+  }
+
+  // Keep the bytes up to and including the first without a continuation bit
+  uint64_t bits = word & (stops ^ (stops - 1)) & 0x7f7f7f7f7f7f7f7full;
+  bits = ((bits & 0x7f007f007f007f00ull) >> 1) |
+         (bits & 0x007f007f007f007full);
+  bits = ((bits & 0x3fff00003fff0000ull) >> 2) |
+         (bits & 0x00003fff00003fffull);
+  bits = ((bits & 0x0fffffff00000000ull) >> 4) |
+         (bits & 0x000000000fffffffull);
+
+  const size_t length = static_cast<size_t>(std::countr_zero(stops)) / 8 + 1;
+  if constexpr (Signed) {
+    // Sign-extend from the top bit of the last group
+    const unsigned shift = 7 * static_cast<unsigned>(length);
+    const uint64_t sign = uint64_t{1} << (shift - 1);
+    bits = (bits ^ sign) - sign;
+  }
+  value = bits;
+  return length;
+}
+
+// Reports why decode_leb128() consumed nothing from `size` bytes
+[[noreturn]] inline void throw_bad_leb128(size_t size) {
+  if (size < kMaxLeb128Bytes) {
+    throw std::out_of_range("Cannot read LEB128 value: only " +
+                            std::to_string(size) + " bytes available");
+  }
+  throw std::runtime_error(
+      "Malformed LEB128 value: longer than 10 bytes or exceeds 64 bits");
+}
+
+}  // namespace detail
+
+}  // namespace intns::io
+
+#endif  // INTNS_IO_VARINT_HPP
@@ -1,7 +1,18 @@
 #ifndef INTNS_MEMORY_HPP
 #define INTNS_MEMORY_HPP
 
+#include "memory/ArenaAllocator.hpp"
+#include "memory/CachedObjectPool.hpp"
+#include "memory/DestructorList.hpp"
+#include "memory/DoubleBufferedAllocator.hpp"
+#include "memory/DoubleStackAllocator.hpp"
+#include "memory/MemoryResource.hpp"
+#include "memory/MemoryStats.hpp"
 #include "memory/ObjectPool.hpp"
+#include "memory/PageMemory.hpp"
+#include "memory/ScratchArena.hpp"
+#include "memory/SizeClassAllocator.hpp"
+#include "memory/SlotPool.hpp"
 #include "memory/StackAllocator.hpp"
 
 #endif
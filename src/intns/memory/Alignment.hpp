@@ -6,6 +6,12 @@
 
 namespace intns::memory {
 
+/**
+ * @brief Assumed size of a cache line, used to keep independently accessed
+ * data from sharing one.
+ */
+inline constexpr std::size_t kCacheLineSize = 64;
+
 /**
  * @brief Aligns a given address to the specified alignment boundary.
  *
@@ -0,0 +1,8 @@
+#include "ArenaAllocator.hpp"
+
+namespace intns::memory {
+
+template class BasicArenaAllocator<NoAllocatorStats>;
+template class BasicArenaAllocator<AllocatorStats>;
+
+}  // namespace intns::memory
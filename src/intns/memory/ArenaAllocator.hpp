@@ -0,0 +1,376 @@
+#ifndef INTNS_MEMORY_ARENAALLOCATOR_HPP
+#define INTNS_MEMORY_ARENAALLOCATOR_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <optional>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+
+#include "../trace/Trace.hpp"
+#include "Alignment.hpp"
+#include "DestructorList.hpp"
+#include "MemoryStats.hpp"
+#include "PageMemory.hpp"
+
+namespace intns::memory {
+
+/**
+ * @brief Block sizing settings for a BasicArenaAllocator.
+ */
+struct ArenaGrowth {
+  // Size in bytes of the first block
+  std::size_t initial_block_size = 4096;
+
+  // Each new block is this many times larger than the previous one
+  std::size_t growth_factor = 2;
+
+  // Geometric growth stops at this block size; larger requests still get a
+  // block of their own
+  std::size_t max_block_size = 1 << 20;
+
+  // Total bytes the arena may reserve across all blocks, spare ones included;
+  // unlimited unless specified
+  std::optional<std::size_t> max_capacity = std::nullopt;
+
+  // Map blocks straight from the OS with these options, e.g. for huge pages
+  // or NUMA binding; blocks come from malloc unless specified
+  std::optional<PageOptions> pages = std::nullopt;
+};
+
+/**
+ * @class BasicArenaAllocator
+ * @brief A linear allocator that grows by chaining additional memory blocks.
+ *
+ * Works like StackAllocator, but when the current block runs out a new one is
+ * chained on instead of failing, so the arena can be sized for the typical
+ * case rather than the worst one. Block sizes grow geometrically up to
+ * ArenaGrowth::max_block_size, and the total can be capped with
+ * ArenaGrowth::max_capacity.
+ *
+ * Key Features:
+ * - Same alloc_t<T>() / alloc() interface as StackAllocator.
+ * - Checkpoints work across block boundaries, including with
+ *   BasicStackCheckpoint.
+ * - Blocks released by reset() or restore_checkpoint() are kept and reused by
+ *   later growth instead of going back to the OS; call release_spare() to
+ *   free them.
+ *
+ * Usage Notes:
+ * - Allocations valid only until allocator reset or checkpoint restore.
+ * - alloc_t() and alloc() return raw storage; use emplace() to construct
+ * objects whose destructors must run on reset or checkpoint restore.
+ * - Not thread-safe; designed for single-threaded use.
+ *
+ * @tparam StatsPolicy Records successful and failed allocations and peak
+ * usage, as for BasicStackAllocator.
+ */
+template <typename StatsPolicy = NoAllocatorStats>
+class BasicArenaAllocator {
+  struct Block;
+
+ public:
+  using marker_type = std::uintptr_t;
+  using size_type = std::size_t;
+  using stats_type = StatsPolicy;
+
+  /**
+   * @brief A saved allocation state: the active block and position within it.
+   */
+  struct Checkpoint {
+    const Block* block = nullptr;
+    marker_type marker = 0;
+  };
+  using checkpoint_t = Checkpoint;
+
+  /**
+   * @brief Constructs an arena and allocates its first block.
+   *
+   * @param growth Block sizing settings.
+   * @throws std::invalid_argument If `initial_block_size` exceeds
+   * ArenaGrowth::max_capacity.
+   * @throws std::runtime_error If a size setting is zero, the growth factor
+   * is zero, or memory allocation fails.
+   */
+  explicit BasicArenaAllocator(ArenaGrowth growth = {});
+
+  /**
+   * @brief Destroys objects created with emplace() and frees every block, in
+   * use or spare.
+   */
+  ~BasicArenaAllocator();
+
+  // Don't allow moving or copying
+  BasicArenaAllocator(const BasicArenaAllocator&) = delete;
+  BasicArenaAllocator& operator=(const BasicArenaAllocator&) = delete;
+  BasicArenaAllocator(BasicArenaAllocator&&) = delete;
+  BasicArenaAllocator& operator=(BasicArenaAllocator&&) = delete;
+
+  /**
+   * @brief Allocates memory for a single object of type T.
+   *
+   * Same requirements on T as StackAllocator::alloc_t(). Chains a new block
+   * if the current one cannot fit T.
+   *
+   * @tparam T The type of object to allocate.
+   * @return The allocated memory for T, or nullptr if growing failed or would
+   * exceed the capacity limit.
+   */
+  template <typename T>
+  [[nodiscard]] T* alloc_t() noexcept {
+    static_assert(!std::is_reference_v<T>,
+                  "Cannot allocate storage for reference types");
+    static_assert(!std::is_void_v<T>, "Cannot allocate storage for void");
+    static_assert(std::is_destructible_v<T>, "Type must be destructible");
+    static_assert(sizeof(T) > 0, "Type must have non-zero size");
+
+    return static_cast<T*>(alloc(sizeof(T), alignof(T)));
+  }
+
+  /**
+   * @brief Allocates a block of memory with the specified size and alignment.
+   *
+   * Allocates from the current block when it fits, otherwise from a recycled
+   * or newly allocated block. Returns nullptr if size is zero, alignment is
+   * not a power of two, or growing fails.
+   *
+   * @param size Number of bytes to allocate.
+   * @param alignment Alignment in bytes (default: alignof(std::max_align_t)).
+   * @return Pointer to allocated memory or nullptr if allocation fails.
+   */
+  [[nodiscard]] void* alloc(size_type size, size_type alignment = alignof(
+                                                std::max_align_t)) noexcept {
+    if (size == 0 || !is_power_of_two(alignment)) [[unlikely]] {
+      stats_.on_alloc_failed();
+      return nullptr;
+    }
+
+    // Fast path: fits in the current block
+    const auto aligned_pos = align_address(active_marker_, alignment);
+    if (aligned_pos >= active_marker_ && aligned_pos <= block_end_ &&
+        size <= block_end_ - aligned_pos) [[likely]] {
+      active_marker_ = aligned_pos + size;
+      stats_.on_alloc(bytes_used());
+      return reinterpret_cast<void*>(aligned_pos);
+    }
+
+    return alloc_slow(size, alignment);
+  }
+
+  /**
+   * @brief Allocates and constructs an object of type T in place.
+   *
+   * Works as StackAllocator::emplace(): objects that are not trivially
+   * destructible are destroyed, newest first, on reset, destruction, or
+   * restoring a checkpoint taken before this call.
+   *
+   * @tparam T The type of object to construct.
+   * @param args Arguments forwarded to T's constructor.
+   * @return The constructed object, or nullptr if growing failed.
+   * @throws Any exception thrown by T's constructor, in which case the
+   * allocator is left as it was before the call.
+   */
+  template <typename T, typename... Args>
+  [[nodiscard]] T* emplace(Args&&... args) {
+    const checkpoint_t before = save_checkpoint();
+
+    DestructorList::Record* record = nullptr;
+    if constexpr (!std::is_trivially_destructible_v<T>) {
+      record = alloc_t<DestructorList::Record>();
+      if (!record) {
+        return nullptr;
+      }
+    }
+
+    T* obj = alloc_t<T>();
+    if (!obj) {
+      rewind(before);
+      return nullptr;
+    }
+
+    try {
+      std::construct_at(obj, std::forward<Args>(args)...);
+    } catch (...) {
+      rewind(before);
+      throw;
+    }
+
+    if constexpr (!std::is_trivially_destructible_v<T>) {
+      destructors_.push(record, obj, position_of(before));
+    }
+    return obj;
+  }
+
+  /**
+   * @brief Frees the most recent allocation, if `ptr` is it.
+   *
+   * Works as StackAllocator::release_top(); the block stays in the chain.
+   *
+   * @param ptr Start of the allocation.
+   * @param size Size of the allocation in bytes, as passed to alloc().
+   * @return true if the allocation was on top and has been released.
+   */
+  [[nodiscard]] bool release_top(void* ptr, size_type size) noexcept {
+    const auto addr = reinterpret_cast<marker_type>(ptr);
+    if (addr < block_start(current_) || addr + size != active_marker_) {
+      return false;
+    }
+
+    active_marker_ = addr;
+    return true;
+  }
+
+  /**
+   * @brief Saves the current state of the arena.
+   * @return checkpoint_t The current block and position.
+   */
+  [[nodiscard]] checkpoint_t save_checkpoint() const noexcept {
+    return {current_, active_marker_};
+  }
+
+  /**
+   * @brief Restores the arena to a previously saved checkpoint.
+   *
+   * Objects created with emplace() after the checkpoint are destroyed, and
+   * blocks chained after it become spare blocks.
+   *
+   * @param checkpoint The previous allocation state to restore.
+   * @throws std::runtime_error if the checkpoint's block is no longer in use,
+   * or its position lies outside that block.
+   */
+  void restore_checkpoint(checkpoint_t checkpoint);
+
+  /**
+   * @brief Returns the number of bytes consumed, including padding and the
+   * unused tails of earlier blocks.
+   * @return The number of bytes used.
+   */
+  [[nodiscard]] size_type bytes_used() const noexcept {
+    return current_->used_before + (active_marker_ - block_start(current_));
+  }
+
+  /**
+   * @brief Returns the number of bytes left in the current block, i.e. how
+   * much can be allocated without chaining another block.
+   * @return The number of bytes remaining in the current block.
+   */
+  [[nodiscard]] size_type bytes_remaining() const noexcept {
+    return block_end_ - active_marker_;
+  }
+
+  /**
+   * @brief Returns the number of bytes reserved across all blocks, spare ones
+   * included.
+   * @return The arena's total capacity.
+   */
+  [[nodiscard]] size_type capacity() const noexcept { return reserved_; }
+
+  /**
+   * @brief Returns the number of blocks currently in use.
+   * @return The length of the block chain, at least 1.
+   */
+  [[nodiscard]] size_type block_count() const noexcept;
+
+  /**
+   * @brief Resets the arena to its initial state, destroying every object
+   * created with emplace(). Every block but the first becomes a spare block.
+   */
+  void reset() noexcept;
+
+  /**
+   * @brief Frees every spare block.
+   */
+  void release_spare() noexcept;
+
+  /**
+   * @brief Returns the arena's statistics policy.
+   * @return The statistics, call snapshot() on it to read counters.
+   */
+  [[nodiscard]] const stats_type& stats() const noexcept { return stats_; }
+
+ private:
+  /**
+   * @brief Header placed at the front of every block, followed by its data.
+   */
+  struct alignas(std::max_align_t) Block {
+    Block* prev = nullptr;      // Previous block in the chain, or next spare
+    size_type capacity = 0;     // Usable bytes after the header
+    size_type used_before = 0;  // Bytes taken by earlier blocks in the chain
+  };
+
+  [[nodiscard]] static marker_type block_start(const Block* b) noexcept {
+    return reinterpret_cast<marker_type>(b) + sizeof(Block);
+  }
+
+  // Linear position of a checkpoint, comparable across blocks
+  [[nodiscard]] static std::uintptr_t position_of(checkpoint_t c) noexcept {
+    return c.block->used_before + (c.marker - block_start(c.block));
+  }
+
+  // Restores a checkpoint known to be valid, without destroying anything
+  void rewind(checkpoint_t checkpoint) noexcept {
+    pop_blocks_to(checkpoint.block);
+    active_marker_ = checkpoint.marker;
+  }
+
+  /**
+   * @brief Chains a spare or new block big enough for the request and
+   * allocates from it.
+   */
+  [[nodiscard]] void* alloc_slow(size_type size, size_type alignment) noexcept;
+
+  // Allocates a new block, nullptr on failure or if over the capacity limit
+  [[nodiscard]] Block* new_block(size_type capacity) noexcept;
+
+  // Returns a block to malloc or the OS, whichever it came from
+  void free_block(Block* b) noexcept;
+
+  // Moves next_block_size_ one growth step towards the max block size
+  void advance_block_size() noexcept;
+
+  // Makes `b` the active block, chained after the current one
+  void push_block(Block* b) noexcept;
+
+  // Moves every block above `keep` onto the spare list
+  void pop_blocks_to(const Block* keep) noexcept;
+
+  // Block sizing settings
+  ArenaGrowth growth_;
+
+  // The active (last chained) block
+  Block* current_ = nullptr;
+
+  // Blocks released by reset or restore, kept for reuse
+  Block* spare_ = nullptr;
+
+  // Marker to track the current position in the active block
+  marker_type active_marker_ = 0;
+
+  // End of the active block's data
+  marker_type block_end_ = 0;
+
+  // Size of the next block to allocate from the OS
+  size_type next_block_size_ = 0;
+
+  // Bytes reserved across all blocks, spare ones included
+  size_type reserved_ = 0;
+
+  // Objects created by emplace() that still need destroying
+  DestructorList destructors_;
+
+  // Allocation statistics, empty unless enabled
+  [[no_unique_address]] StatsPolicy stats_;
+};
+
+/**
+ * @brief The default arena allocator, without statistics.
+ */
+using ArenaAllocator = BasicArenaAllocator<>;
+
+}  // namespace intns::memory
+
+#include "ArenaAllocator.tpp"
+
+#endif
@@ -0,0 +1,233 @@
+#include "ArenaAllocator.hpp"
+
+#include <algorithm>
+#include <cstdlib>
+#include <limits>
+#include <new>
+#include <string>
+
+namespace intns::memory {
+
+template <typename S>
+BasicArenaAllocator<S>::BasicArenaAllocator(ArenaGrowth growth)
+    : growth_(growth), next_block_size_(growth.initial_block_size) {
+  if (growth.initial_block_size == 0 || growth.max_block_size == 0)
+      [[unlikely]] {
+    throw std::runtime_error("ArenaAllocator: Block size is zero.");
+  }
+
+  if (growth.growth_factor == 0) [[unlikely]] {
+    throw std::runtime_error("ArenaAllocator: Growth factor is zero.");
+  }
+
+  if (growth.max_capacity.has_value() &&
+      growth.initial_block_size > growth.max_capacity.value()) [[unlikely]] {
+    throw std::invalid_argument(
+        "ArenaAllocator: Initial block size exceeds the max capacity of " +
+        std::to_string(growth.max_capacity.value()) + " bytes.");
+  }
+
+  Block* first = new_block(growth.initial_block_size);
+  if (!first) [[unlikely]] {
+    throw std::runtime_error("ArenaAllocator: Failed to allocate memory.");
+  }
+
+  push_block(first);
+  advance_block_size();
+}
+
+template <typename S>
+BasicArenaAllocator<S>::~BasicArenaAllocator() {
+  destructors_.unwind_all();
+  release_spare();
+  while (current_) {
+    Block* prev = current_->prev;
+    free_block(current_);
+    current_ = prev;
+  }
+}
+
+template <typename S>
+void BasicArenaAllocator<S>::restore_checkpoint(checkpoint_t checkpoint) {
+  // The checkpoint's block must still be somewhere in the chain
+  const Block* target = current_;
+  while (target && target != checkpoint.block) {
+    target = target->prev;
+  }
+
+  if (!target || checkpoint.marker < block_start(target) ||
+      checkpoint.marker > block_start(target) + target->capacity)
+      [[unlikely]] {
+    throw std::runtime_error(
+        "ArenaAllocator::restore_checkpoint: Invalid checkpoint");
+  }
+
+  destructors_.unwind_to(position_of(checkpoint));
+  rewind(checkpoint);
+}
+
+template <typename S>
+typename BasicArenaAllocator<S>::size_type
+BasicArenaAllocator<S>::block_count() const noexcept {
+  size_type count = 0;
+  for (const Block* b = current_; b; b = b->prev) {
+    ++count;
+  }
+  return count;
+}
+
+template <typename S>
+void BasicArenaAllocator<S>::reset() noexcept {
+  const Block* first = current_;
+  while (first->prev) {
+    first = first->prev;
+  }
+
+  destructors_.unwind_all();
+  pop_blocks_to(first);
+  active_marker_ = block_start(current_);
+}
+
+template <typename S>
+void BasicArenaAllocator<S>::release_spare() noexcept {
+  while (spare_) {
+    Block* next = spare_->prev;
+    reserved_ -= spare_->capacity;
+    free_block(spare_);
+    spare_ = next;
+  }
+}
+
+template <typename S>
+void* BasicArenaAllocator<S>::alloc_slow(size_type size,
+                                         size_type alignment) noexcept {
+  // Block data is aligned to max_align_t, stricter alignment needs padding
+  const size_type padding =
+      alignment > alignof(Block) ? alignment - alignof(Block) : 0;
+  if (size > std::numeric_limits<size_type>::max() - sizeof(Block) - padding)
+      [[unlikely]] {
+    stats_.on_alloc_failed();
+    return nullptr;
+  }
+  const size_type needed = size + padding;
+
+  // Reuse the first spare block that fits
+  Block* block = nullptr;
+  for (Block** link = &spare_; *link; link = &(*link)->prev) {
+    if ((*link)->capacity >= needed) {
+      block = *link;
+      *link = block->prev;
+      break;
+    }
+  }
+
+  if (!block) {
+    INTNS_TRACE_ZONE("ArenaAllocator::new_block");
+    const size_type block_size = std::max(needed, next_block_size_);
+    block = new_block(block_size);
+
+    // Spare blocks too small to use may be what stands in the way
+    if (!block && spare_ && growth_.max_capacity.has_value()) {
+      release_spare();
+      block = new_block(block_size);
+    }
+
+    if (!block) [[unlikely]] {
+      stats_.on_alloc_failed();
+      return nullptr;
+    }
+
+    advance_block_size();
+  }
+
+  push_block(block);
+
+  // Guaranteed to fit now
+  const auto aligned_pos = align_address(active_marker_, alignment);
+  active_marker_ = aligned_pos + size;
+  stats_.on_alloc(bytes_used());
+  return reinterpret_cast<void*>(aligned_pos);
+}
+
+template <typename S>
+typename BasicArenaAllocator<S>::Block* BasicArenaAllocator<S>::new_block(
+    size_type capacity) noexcept {
+  if (growth_.max_capacity.has_value() &&
+      capacity > growth_.max_capacity.value() - reserved_) {
+    return nullptr;  // reserved_ never exceeds the limit
+  }
+
+  void* memory = nullptr;
+  if (growth_.pages.has_value()) {
+    PageMemory pages =
+        PageMemory::try_map(sizeof(Block) + capacity, *growth_.pages);
+    if (!pages) [[unlikely]] {
+      return nullptr;
+    }
+
+    // The block is unmapped by its capacity, so the rounding must fit too
+    capacity = pages.size() - sizeof(Block);
+    if (growth_.max_capacity.has_value() &&
+        capacity > growth_.max_capacity.value() - reserved_) {
+      return nullptr;
+    }
+    memory = pages.release();
+  } else {
+    memory = std::malloc(sizeof(Block) + capacity);
+  }
+
+  if (!memory) [[unlikely]] {
+    return nullptr;
+  }
+
+  reserved_ += capacity;
+  return ::new (memory) Block{nullptr, capacity, 0};
+}
+
+template <typename S>
+void BasicArenaAllocator<S>::free_block(Block* b) noexcept {
+  if (growth_.pages.has_value()) {
+    PageMemory::unmap(b, sizeof(Block) + b->capacity);
+  } else {
+    std::free(b);
+  }
+}
+
+template <typename S>
+void BasicArenaAllocator<S>::advance_block_size() noexcept {
+  // Grow geometrically, stopping at the max block size
+  if (next_block_size_ < growth_.max_block_size) {
+    next_block_size_ =
+        next_block_size_ > growth_.max_block_size / growth_.growth_factor
+            ? growth_.max_block_size
+            : next_block_size_ * growth_.growth_factor;
+  }
+}
+
+template <typename S>
+void BasicArenaAllocator<S>::push_block(Block* b) noexcept {
+  b->prev = current_;
+  b->used_before = current_ ? current_->used_before + current_->capacity : 0;
+
+  current_ = b;
+  active_marker_ = block_start(b);
+  block_end_ = active_marker_ + b->capacity;
+}
+
+template <typename S>
+void BasicArenaAllocator<S>::pop_blocks_to(const Block* keep) noexcept {
+  while (current_ != keep) {
+    Block* b = current_;
+    current_ = b->prev;
+    b->prev = spare_;
+    spare_ = b;
+  }
+
+  block_end_ = block_start(current_) + current_->capacity;
+}
+
+// Instantiated once in ArenaAllocator.cpp
+extern template class BasicArenaAllocator<NoAllocatorStats>;
+extern template class BasicArenaAllocator<AllocatorStats>;
+
+}  // namespace intns::memory
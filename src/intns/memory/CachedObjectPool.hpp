@@ -0,0 +1,323 @@
+#ifndef INTNS_MEMORY_CACHEDOBJECTPOOL_HPP
+#define INTNS_MEMORY_CACHEDOBJECTPOOL_HPP
+
+#include <algorithm>
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include "ObjectPool.hpp"
+
+namespace intns::memory {
+
+/**
+ * @brief A thread-safe object pool with per-thread object caches.
+ *
+ * CachedObjectPool keeps a small 'magazine' of objects per thread, so take()
+ * and add() usually touch only thread-local state. When a magazine runs empty
+ * or full, half a magazine is moved to or from a shared, mutex-protected
+ * depot in one batch, so the lock is taken once per batch rather than once
+ * per object.
+ *
+ * @tparam T The type of objects managed (default and move constructible).
+ * @tparam AcquirePolicy Class with static on_acquire(T&) called on acquisition.
+ * @tparam ReleasePolicy Class with static on_release(T&) called on release.
+ *
+ * @note All public methods are thread-safe.
+ *
+ * @section Usage
+ * Drop-in replacement for ObjectPool where contention matters; works with
+ * PoolLease. Use ObjectPoolFor to select the implementation at compile time.
+ *
+ * @section Size Limits And Counting
+ * The size limit is enforced on the shared depot. Each thread may hold up to
+ * `magazine_size()` further objects in its cache, and size() only counts the
+ * depot plus the calling thread's cache.
+ *
+ * @section Exception Safety
+ * Construction throws std::runtime_error if initial size exceeds limit.
+ * Methods throw std::runtime_error if pool is empty or size limit is exceeded.
+ * Exceptions during object creation or policy methods are propagated.
+ */
+template <typename T, typename AcquirePolicy = NoOpPoolPolicy<T>,
+          typename ReleasePolicy = AcquirePolicy>
+  requires AcquireHook<AcquirePolicy, T> && ReleaseHook<ReleasePolicy, T>
+class CachedObjectPool {
+  static_assert(std::is_default_constructible_v<T>,
+                "T must be default constructible");
+  static_assert(std::is_move_constructible_v<T>,
+                "T must be move constructible");
+
+ public:
+  using size_type = size_t;
+  using value_type = T;
+
+  // Default number of objects each thread may cache
+  static constexpr size_type kDefaultMagazineSize = 32;
+
+  /**
+   * @brief Creates a CachedObjectPool with a set initial size, optional max
+   * limit and per-thread cache size. Initial objects are default-constructed
+   * into the shared depot and processed by `ReleasePolicy::on_release`.
+   *
+   * @param init_size The number of objects to initially create in the pool.
+   * @param limit The maximum number of objects allowed in the depot (optional,
+   * default is 0 for unlimited).
+   * @param magazine_size The number of objects each thread may cache.
+   * @throws std::runtime_error If `init_size` is greater than the specified
+   * size limit, or `magazine_size` is zero.
+   * @throws Any exception thrown during object creation or by
+   * `ReleasePolicy::on_release`.
+   */
+  explicit CachedObjectPool(size_type init_size = 0,
+                            std::optional<size_type> limit = std::nullopt,
+                            size_type magazine_size = kDefaultMagazineSize);
+
+  /**
+   * @brief Destroys the pool and every object in the depot.
+   *
+   * Objects still cached by other threads are destroyed when those threads
+   * exit, or when they next touch a pool of this type.
+   */
+  ~CachedObjectPool();
+
+  // Thread caches refer to the pool by identity
+  CachedObjectPool(const CachedObjectPool&) = delete;
+  CachedObjectPool& operator=(const CachedObjectPool&) = delete;
+  CachedObjectPool(CachedObjectPool&&) = delete;
+  CachedObjectPool& operator=(CachedObjectPool&&) = delete;
+
+  /**
+   * @brief Removes and returns an object from the pool.
+   *
+   * @return value_type The acquired object from the pool.
+   * @throws std::runtime_error If the pool is empty.
+   */
+  [[nodiscard]] value_type take();
+
+  /**
+   * @brief Attempts to take an object from the pool.
+   *
+   * @return std::optional<value_type> The acquired object if available,
+   * otherwise std::nullopt.
+   */
+  [[nodiscard]] std::optional<value_type> try_take();
+
+  /**
+   * @brief Adds a new object to the pool.
+   *
+   * @param back The object to add to the pool (rvalue reference).
+   * @throws std::runtime_error If the thread cache is full and the depot size
+   * limit has been reached.
+   */
+  void add(value_type&& back);
+
+  /**
+   * @brief Attempts to add a new object to the pool.
+   *
+   * @param back The object to be added, passed as an rvalue reference.
+   * @return true if the object was successfully added; false if the size limit
+   * was reached.
+   */
+  [[nodiscard]] bool try_add(value_type&& back);
+
+  /**
+   * @brief Ensures the depot holds at least the specified number of objects.
+   *
+   * @param target_size Minimum number of objects to hold in the depot.
+   * @throws std::runtime_error if the target size is zero or above the limit.
+   */
+  void reserve(size_type target_size) {
+    (void)reserve_impl<true>(target_size);
+  }
+
+  /**
+   * @brief Ensures the depot holds at least the specified number of objects
+   * without throwing exceptions.
+   *
+   * @param target_size Minimum number of objects to hold in the depot.
+   * @return true if the reservation was successful; false otherwise.
+   */
+  [[nodiscard]] bool try_reserve(size_type target_size) {
+    return reserve_impl<false>(target_size);
+  }
+
+  /**
+   * @brief Moves every object cached by the calling thread into the depot.
+   *
+   * Objects that do not fit under the size limit are destroyed.
+   */
+  void flush_thread_cache();
+
+  /**
+   * @brief Returns the number of objects in the depot and the calling
+   * thread's cache; other threads' caches are not counted.
+   * @return The number of objects visible to the calling thread.
+   */
+  [[nodiscard]] size_type size() const;
+
+  /**
+   * @brief Checks if no objects are visible to the calling thread.
+   * @return true if size() is zero, false otherwise.
+   */
+  [[nodiscard]] bool empty() const { return size() == 0; }
+
+  /**
+   * @brief Returns the maximum allowed size for the depot.
+   *
+   * @return The size limit, or std::nullopt if unlimited.
+   */
+  [[nodiscard]] std::optional<size_type> size_limit() const {
+    std::scoped_lock<std::mutex> lock(depot_->mutex);
+    return depot_->size_limit;
+  }
+
+  /**
+   * @brief Sets the max depot size; nullopt makes it unlimited.
+   * @param limit The new size limit.
+   */
+  void set_size_limit(std::optional<size_type> limit) noexcept {
+    std::scoped_lock<std::mutex> lock(depot_->mutex);
+    depot_->size_limit = limit;
+  }
+
+  /**
+   * @brief Returns the number of objects each thread may cache.
+   * @return The magazine size given on construction.
+   */
+  [[nodiscard]] size_type magazine_size() const noexcept {
+    return magazine_size_;
+  }
+
+ private:
+  /**
+   * @brief Shared object storage, kept alive by thread caches so they can
+   * safely flush after the pool itself is gone.
+   */
+  struct Depot {
+    std::mutex mutex;
+    std::vector<value_type> objects;
+    std::optional<size_type> size_limit = std::nullopt;
+    std::atomic<size_type> count = 0;  // Mirrors objects.size(), lock-free
+    bool alive = true;                 // Cleared when the pool is destroyed
+
+    [[nodiscard]] bool has_room() const noexcept {
+      return !size_limit.has_value() || objects.size() < size_limit.value();
+    }
+  };
+
+  /**
+   * @brief One thread's object cache for one pool.
+   */
+  struct Magazine {
+    std::uint64_t pool_id = 0;
+    std::shared_ptr<Depot> depot;
+    std::vector<value_type> items;
+
+    ~Magazine() { flush(); }
+
+    // Returns every cached object to the depot, if it is still alive
+    void flush() noexcept;
+  };
+
+  /**
+   * @brief Lifetime of the calling thread's ThreadCache. Pools with static
+   * storage duration outlive the main thread's cache, so it is checked before
+   * every access.
+   */
+  enum class CacheState : std::uint8_t { kUnused, kLive, kDestroyed };
+
+  /**
+   * @brief Per-thread list of magazines, one per pool this thread has used.
+   */
+  struct ThreadCache {
+    std::vector<std::unique_ptr<Magazine>> magazines;
+    Magazine* last = nullptr;  // Most recently used magazine
+
+    ThreadCache() noexcept { tls_state_ = CacheState::kLive; }
+    ~ThreadCache() { tls_state_ = CacheState::kDestroyed; }
+  };
+
+  /**
+   * @brief Finds the calling thread's magazine for this pool.
+   * @return The magazine, or nullptr if this thread has not used the pool.
+   */
+  [[nodiscard]] Magazine* find_magazine() const noexcept;
+
+  /**
+   * @brief Finds or creates the calling thread's magazine for this pool.
+   * @return The magazine, never null.
+   * @throws std::runtime_error If the thread's caches were already destroyed,
+   * e.g. when a static pool is used during program exit.
+   */
+  [[nodiscard]] Magazine& local_magazine() const;
+
+  /**
+   * @brief Moves up to half a magazine of objects from the depot.
+   * @return true if at least one object was moved.
+   */
+  bool refill(Magazine& mag) const;
+
+  /**
+   * @brief Moves up to half a magazine of objects into the depot.
+   * @return true if at least one object was moved.
+   */
+  bool spill(Magazine& mag) const;
+
+  template <bool ThrowOnError>
+  [[nodiscard]] bool reserve_impl(size_type target_size);
+
+  // Source of unique pool identities; ids are never reused
+  static inline std::atomic<std::uint64_t> next_id_ = 1;
+
+  // The calling thread's caches for pools of this type
+  static thread_local ThreadCache tls_cache_;
+
+  // Whether tls_cache_ may be accessed; trivially destructible, so still
+  // readable after tls_cache_ is gone
+  static inline thread_local CacheState tls_state_ = CacheState::kUnused;
+
+  // Identity used to match this pool's magazines
+  std::uint64_t id_ = next_id_.fetch_add(1, std::memory_order_relaxed);
+
+  // The number of objects each thread may cache
+  size_type magazine_size_ = kDefaultMagazineSize;
+
+  // Shared storage behind the thread caches
+  std::shared_ptr<Depot> depot_ = std::make_shared<Depot>();
+};
+
+/**
+ * @brief Selects the locking strategy of a pool chosen through ObjectPoolFor.
+ */
+enum class PoolMode : uint8_t {
+  kLocked = 0,   // ObjectPool: one mutex guards every operation
+  kThreadCached  // CachedObjectPool: per-thread caches over a shared depot
+};
+
+/**
+ * @brief Selects a pool implementation at compile time.
+ *
+ * @tparam Mode The locking strategy to use.
+ * @tparam T The type of objects managed.
+ * @tparam AcquirePolicy Class with static on_acquire(T&) called on acquisition.
+ * @tparam ReleasePolicy Class with static on_release(T&) called on release.
+ */
+template <PoolMode Mode, typename T, typename AcquirePolicy = NoOpPoolPolicy<T>,
+          typename ReleasePolicy = AcquirePolicy>
+using ObjectPoolFor =
+    std::conditional_t<Mode == PoolMode::kThreadCached,
+                       CachedObjectPool<T, AcquirePolicy, ReleasePolicy>,
+                       ObjectPool<T, AcquirePolicy, ReleasePolicy>>;
+
+}  // namespace intns::memory
+
+#include "CachedObjectPool.tpp"
+
+#endif  // INTNS_MEMORY_CACHEDOBJECTPOOL_HPP
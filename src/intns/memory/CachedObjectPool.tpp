@@ -0,0 +1,328 @@
+#include "CachedObjectPool.hpp"
+
+namespace intns::memory {
+
+template <typename T, typename A, typename R>
+  requires AcquireHook<A, T> && ReleaseHook<R, T>
+thread_local typename CachedObjectPool<T, A, R>::ThreadCache
+    CachedObjectPool<T, A, R>::tls_cache_;
+
+template <typename T, typename A, typename R>
+  requires AcquireHook<A, T> && ReleaseHook<R, T>
+CachedObjectPool<T, A, R>::CachedObjectPool(size_type init_size,
+                                            std::optional<size_type> limit,
+                                            size_type magazine_size)
+    : magazine_size_(magazine_size) {
+  if (magazine_size == 0) [[unlikely]] {
+    throw std::runtime_error(
+        "CachedObjectPool::CachedObjectPool: magazine size is zero.");
+  }
+
+  if (limit.has_value() && init_size > limit.value()) [[unlikely]] {
+    throw std::runtime_error(
+        "CachedObjectPool::CachedObjectPool: initial size is > size limit.");
+  }
+
+  if (limit.has_value() && limit.value() != 0) {
+    depot_->size_limit = limit;  // 0 can also mean "unlimited"
+  }
+
+  // Create initial objects in the depot, default-constructing them
+  // And notifying the release policy
+  depot_->objects.reserve(init_size);
+  for (size_type i = 0; i < init_size; i++) {
+    depot_->objects.emplace_back();
+    R::on_release(depot_->objects.back());
+  }
+  depot_->count.store(depot_->objects.size(), std::memory_order_relaxed);
+}
+
+template <typename T, typename A, typename R>
+  requires AcquireHook<A, T> && ReleaseHook<R, T>
+CachedObjectPool<T, A, R>::~CachedObjectPool() {
+  {
+    std::scoped_lock<std::mutex> lock(depot_->mutex);
+    depot_->alive = false;
+    depot_->objects.clear();
+    depot_->count.store(0, std::memory_order_relaxed);
+  }
+
+  // Drop our own thread's cache now, other threads drop theirs lazily. A
+  // static pool is destroyed after the main thread's cache, which then
+  // already flushed into the depot.
+  if (tls_state_ != CacheState::kLive) {
+    return;
+  }
+
+  ThreadCache& cache = tls_cache_;
+  if (cache.last && cache.last->pool_id == id_) {
+    cache.last = nullptr;
+  }
+
+  std::erase_if(cache.magazines,
+                [this](const auto& mag) { return mag->pool_id == id_; });
+}
+
+template <typename T, typename A, typename R>
+  requires AcquireHook<A, T> && ReleaseHook<R, T>
+typename CachedObjectPool<T, A, R>::value_type
+CachedObjectPool<T, A, R>::take() {
+  Magazine& mag = local_magazine();
+  if (mag.items.empty() && !refill(mag)) [[unlikely]] {
+    throw std::runtime_error("CachedObjectPool::take: pool is empty.");
+  }
+
+  // Move the last cached object
+  // and notify the acquire policy
+  value_type value = std::move(mag.items.back());
+  mag.items.pop_back();
+  A::on_acquire(value);  // No exception can be thrown here
+  return value;
+}
+
+template <typename T, typename A, typename R>
+  requires AcquireHook<A, T> && ReleaseHook<R, T>
+std::optional<typename CachedObjectPool<T, A, R>::value_type>
+CachedObjectPool<T, A, R>::try_take() {
+  Magazine& mag = local_magazine();
+  if (mag.items.empty() && !refill(mag)) {
+    return std::nullopt;
+  }
+
+  // Move the last cached object
+  // and notify the acquire policy
+  value_type value = std::move(mag.items.back());
+  mag.items.pop_back();
+  A::on_acquire(value);
+  return value;
+}
+
+template <typename T, typename A, typename R>
+  requires AcquireHook<A, T> && ReleaseHook<R, T>
+void CachedObjectPool<T, A, R>::add(value_type&& back) {
+  Magazine& mag = local_magazine();
+  if (mag.items.size() >= magazine_size_ && !spill(mag)) [[unlikely]] {
+    throw std::runtime_error(
+        "CachedObjectPool::add: unable to add as size limit reached.");
+  }
+
+  // Notify the release policy before
+  // caching the object
+  R::on_release(back);
+  mag.items.push_back(std::move(back));
+}
+
+template <typename T, typename A, typename R>
+  requires AcquireHook<A, T> && ReleaseHook<R, T>
+bool CachedObjectPool<T, A, R>::try_add(value_type&& back) {
+  Magazine& mag = local_magazine();
+  if (mag.items.size() >= magazine_size_ && !spill(mag)) {
+    return false;
+  }
+
+  // Notify the release policy before
+  // caching the object
+  try {
+    R::on_release(back);
+    mag.items.push_back(std::move(back));
+    return true;
+  } catch (...) {
+    return false;
+  }
+}
+
+template <typename T, typename A, typename R>
+  requires AcquireHook<A, T> && ReleaseHook<R, T>
+void CachedObjectPool<T, A, R>::flush_thread_cache() {
+  if (Magazine* mag = find_magazine()) {
+    mag->flush();
+  }
+}
+
+template <typename T, typename A, typename R>
+  requires AcquireHook<A, T> && ReleaseHook<R, T>
+typename CachedObjectPool<T, A, R>::size_type CachedObjectPool<T, A, R>::size()
+    const {
+  const Magazine* mag = find_magazine();
+  return depot_->count.load(std::memory_order_relaxed) +
+         (mag ? mag->items.size() : 0);
+}
+
+template <typename T, typename A, typename R>
+  requires AcquireHook<A, T> && ReleaseHook<R, T>
+void CachedObjectPool<T, A, R>::Magazine::flush() noexcept {
+  if (!depot) {
+    return;
+  }
+
+  std::scoped_lock<std::mutex> lock(depot->mutex);
+  if (depot->alive) {
+    // Move what fits, anything over the limit is destroyed below
+    try {
+      while (!items.empty() && depot->has_room()) {
+        depot->objects.push_back(std::move(items.back()));
+        items.pop_back();
+      }
+    } catch (...) {
+      // Out of memory growing the depot, drop the rest
+    }
+    depot->count.store(depot->objects.size(), std::memory_order_relaxed);
+  }
+
+  items.clear();
+}
+
+template <typename T, typename A, typename R>
+  requires AcquireHook<A, T> && ReleaseHook<R, T>
+typename CachedObjectPool<T, A, R>::Magazine*
+CachedObjectPool<T, A, R>::find_magazine() const noexcept {
+  if (tls_state_ != CacheState::kLive) [[unlikely]] {
+    return nullptr;
+  }
+
+  ThreadCache& cache = tls_cache_;
+
+  // Fast path: same pool as last time on this thread
+  if (cache.last && cache.last->pool_id == id_) [[likely]] {
+    return cache.last;
+  }
+
+  for (auto& mag : cache.magazines) {
+    if (mag->pool_id == id_) {
+      cache.last = mag.get();
+      return mag.get();
+    }
+  }
+
+  return nullptr;
+}
+
+template <typename T, typename A, typename R>
+  requires AcquireHook<A, T> && ReleaseHook<R, T>
+typename CachedObjectPool<T, A, R>::Magazine&
+CachedObjectPool<T, A, R>::local_magazine() const {
+  if (Magazine* mag = find_magazine()) [[likely]] {
+    return *mag;
+  }
+
+  if (tls_state_ == CacheState::kDestroyed) [[unlikely]] {
+    throw std::runtime_error(
+        "CachedObjectPool: used after the thread's cache was destroyed.");
+  }
+
+  ThreadCache& cache = tls_cache_;
+
+  // First use on this thread, drop caches of pools that no longer exist
+  std::erase_if(cache.magazines, [](const auto& mag) {
+    std::scoped_lock<std::mutex> lock(mag->depot->mutex);
+    return !mag->depot->alive;
+  });
+
+  auto mag = std::make_unique<Magazine>();
+  mag->pool_id = id_;
+  mag->depot = depot_;
+  mag->items.reserve(magazine_size_);
+
+  cache.magazines.push_back(std::move(mag));
+  cache.last = cache.magazines.back().get();
+  return *cache.last;
+}
+
+template <typename T, typename A, typename R>
+  requires AcquireHook<A, T> && ReleaseHook<R, T>
+bool CachedObjectPool<T, A, R>::refill(Magazine& mag) const {
+  std::scoped_lock<std::mutex> lock(depot_->mutex);
+  auto& objects = depot_->objects;
+  if (objects.empty()) {
+    return false;
+  }
+
+  // Take half a magazine so the next few add() calls don't spill straight back
+  const size_type batch =
+      std::min(objects.size(), std::max<size_type>(magazine_size_ / 2, 1));
+  for (size_type i = 0; i < batch; ++i) {
+    mag.items.push_back(std::move(objects.back()));
+    objects.pop_back();
+  }
+
+  depot_->count.store(objects.size(), std::memory_order_relaxed);
+  return true;
+}
+
+template <typename T, typename A, typename R>
+  requires AcquireHook<A, T> && ReleaseHook<R, T>
+bool CachedObjectPool<T, A, R>::spill(Magazine& mag) const {
+  std::scoped_lock<std::mutex> lock(depot_->mutex);
+  if (!depot_->has_room()) {
+    return false;
+  }
+
+  // Give back half a magazine so the next few take() calls stay local
+  const size_type batch = std::max<size_type>(magazine_size_ / 2, 1);
+  for (size_type i = 0; i < batch && depot_->has_room(); ++i) {
+    depot_->objects.push_back(std::move(mag.items.back()));
+    mag.items.pop_back();
+  }
+
+  depot_->count.store(depot_->objects.size(), std::memory_order_relaxed);
+  return true;
+}
+
+template <typename T, typename AcquirePolicy, typename ReleasePolicy>
+  requires AcquireHook<AcquirePolicy, T> && ReleaseHook<ReleasePolicy, T>
+template <bool ThrowOnError>
+bool CachedObjectPool<T, AcquirePolicy, ReleasePolicy>::reserve_impl(
+    size_type target_size) {
+  if (target_size == 0) [[unlikely]] {
+    if constexpr (ThrowOnError) {
+      throw std::runtime_error(
+          "CachedObjectPool::reserve: target size is zero.");
+    } else {
+      return true;  // Nothing to reserve
+    }
+  }
+
+  std::scoped_lock<std::mutex> lock(depot_->mutex);
+  auto& objects = depot_->objects;
+  const size_type current_size = objects.size();
+
+  if (current_size >= target_size) {
+    return true;  // Already at or above target size
+  }
+
+  // Check size limit
+  if (depot_->size_limit.has_value() &&
+      target_size > depot_->size_limit.value()) {
+    if constexpr (ThrowOnError) {
+      throw std::runtime_error(
+          "CachedObjectPool::reserve: cannot reserve more than size limit.");
+    } else {
+      return false;
+    }
+  }
+
+  // Batch create objects
+  try {
+    objects.reserve(target_size);
+    while (objects.size() < target_size) {
+      objects.emplace_back();
+      ReleasePolicy::on_release(objects.back());
+    }
+  } catch (...) {
+    // Rollback on error
+    while (objects.size() > current_size) {
+      objects.pop_back();
+    }
+
+    if constexpr (ThrowOnError) {
+      throw;  // Propagate the exception
+    } else {
+      return false;  // Indicate failure
+    }
+  }
+
+  depot_->count.store(objects.size(), std::memory_order_relaxed);
+  return true;
+}
+
+}  // namespace intns::memory
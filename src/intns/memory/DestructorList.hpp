@@ -0,0 +1,94 @@
+#ifndef INTNS_MEMORY_DESTRUCTORLIST_HPP
+#define INTNS_MEMORY_DESTRUCTORLIST_HPP
+
+#include <cstdint>
+#include <memory>
+#include <new>
+#include <type_traits>
+
+namespace intns::memory {
+
+/**
+ * @class DestructorList
+ * @brief An intrusive LIFO list of pending destructor calls, used by the
+ * linear allocators to clean up objects created with emplace().
+ *
+ * Records live in the allocator's own memory, allocated just before the
+ * object they destroy, and are tagged with the allocator position at which
+ * they were made. Rewinding the allocator to a position destroys every object
+ * recorded at or after it, newest first.
+ *
+ * Not thread-safe; owned by a single allocator.
+ */
+class DestructorList {
+ public:
+  /**
+   * @brief One pending destructor call.
+   */
+  struct Record {
+    void (*destroy)(void*) noexcept = nullptr;
+    void* object = nullptr;
+    std::uintptr_t position = 0;  // Allocator position before the record
+    Record* prev = nullptr;       // Previously recorded object
+  };
+
+  DestructorList() = default;
+
+  // Records point into the owning allocator
+  DestructorList(const DestructorList&) = delete;
+  DestructorList& operator=(const DestructorList&) = delete;
+
+  /**
+   * @brief Records `obj` for destruction when the allocator unwinds past
+   * `position`.
+   *
+   * @param record Uninitialized storage for the record.
+   * @param obj The object to destroy later.
+   * @param position The allocator position before `record` was allocated.
+   */
+  template <typename T>
+  void push(Record* record, T* obj, std::uintptr_t position) noexcept {
+    static_assert(std::is_nothrow_destructible_v<T>,
+                  "Recorded types must have a noexcept destructor");
+
+    head_ = ::new (static_cast<void*>(record))
+        Record{&destroy_object<T>, obj, position, head_};
+  }
+
+  /**
+   * @brief Destroys, newest first, every object recorded at or after
+   * `position`.
+   * @param position The allocator position being rewound to.
+   */
+  void unwind_to(std::uintptr_t position) noexcept {
+    while (head_ && head_->position >= position) {
+      Record* record = head_;
+      head_ = record->prev;
+      record->destroy(record->object);
+    }
+  }
+
+  /**
+   * @brief Destroys every recorded object, newest first.
+   */
+  void unwind_all() noexcept { unwind_to(0); }
+
+  /**
+   * @brief Checks whether any destructor calls are pending.
+   * @return true if nothing is recorded.
+   */
+  [[nodiscard]] bool empty() const noexcept { return head_ == nullptr; }
+
+ private:
+  template <typename T>
+  static void destroy_object(void* obj) noexcept {
+    std::destroy_at(static_cast<T*>(obj));
+  }
+
+  // Most recently recorded object
+  Record* head_ = nullptr;
+};
+
+}  // namespace intns::memory
+
+#endif
@@ -0,0 +1,130 @@
+#ifndef INTNS_MEMORY_DOUBLEBUFFEREDALLOCATOR_HPP
+#define INTNS_MEMORY_DOUBLEBUFFEREDALLOCATOR_HPP
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <utility>
+
+#include "StackAllocator.hpp"
+
+namespace intns::memory {
+
+/**
+ * @class DoubleBufferedAllocator
+ * @brief A frame allocator flipping between two linear allocators.
+ *
+ * Allocations made during a frame stay valid through the following frame, so
+ * data produced in frame N can be read in frame N + 1 without copying it to
+ * another arena. Each flip() resets the buffer it switches to, releasing what
+ * was allocated two frames ago and destroying objects created there with
+ * emplace().
+ *
+ * @tparam Allocator The allocator used for each buffer, StackAllocator by
+ * default; ArenaAllocator also works.
+ *
+ * @note Not thread-safe; designed for single-threaded use.
+ */
+template <typename Allocator = StackAllocator>
+class DoubleBufferedAllocator {
+ public:
+  using allocator_type = Allocator;
+  using size_type = std::size_t;
+
+  /**
+   * @brief Constructs both buffers from the same arguments, e.g. a capacity
+   * for StackAllocator or an ArenaGrowth for ArenaAllocator.
+   * @warning Each buffer is constructed separately, don't pass an external
+   * memory block as both would manage it.
+   *
+   * @param args Constructor arguments for each buffer.
+   * @throws Any exception thrown by the allocator's constructor.
+   */
+  template <typename... Args>
+  explicit DoubleBufferedAllocator(const Args&... args)
+      : buffers_{Allocator(args...), Allocator(args...)} {}
+
+  // Don't allow moving or copying
+  DoubleBufferedAllocator(const DoubleBufferedAllocator&) = delete;
+  DoubleBufferedAllocator& operator=(const DoubleBufferedAllocator&) = delete;
+  DoubleBufferedAllocator(DoubleBufferedAllocator&&) = delete;
+  DoubleBufferedAllocator& operator=(DoubleBufferedAllocator&&) = delete;
+
+  /**
+   * @brief Starts a new frame: the current buffer becomes the previous one,
+   * and the other buffer is reset and becomes current.
+   */
+  void flip() noexcept {
+    current_ ^= 1;
+    buffers_[current_].reset();
+    ++frame_;
+  }
+
+  /**
+   * @brief Returns the buffer for this frame's allocations.
+   * @return The current buffer.
+   */
+  [[nodiscard]] Allocator& current() noexcept { return buffers_[current_]; }
+
+  /**
+   * @brief Returns the buffer holding last frame's allocations, which stay
+   * valid until the next flip().
+   * @return The previous buffer.
+   */
+  [[nodiscard]] Allocator& previous() noexcept {
+    return buffers_[current_ ^ 1];
+  }
+
+  /**
+   * @brief Returns the number of flips so far.
+   * @return The index of the current frame.
+   */
+  [[nodiscard]] std::uint64_t frame_index() const noexcept { return frame_; }
+
+  /**
+   * @brief Allocates memory for a single object of type T in this frame.
+   * @return The allocated memory for T, or nullptr on failure.
+   */
+  template <typename T>
+  [[nodiscard]] T* alloc_t() noexcept {
+    return current().template alloc_t<T>();
+  }
+
+  /**
+   * @brief Allocates a block of memory in this frame.
+   * @param size Number of bytes to allocate.
+   * @param alignment Alignment in bytes (default: alignof(std::max_align_t)).
+   * @return Pointer to allocated memory or nullptr if allocation fails.
+   */
+  [[nodiscard]] void* alloc(
+      size_type size,
+      size_type alignment = alignof(std::max_align_t)) noexcept {
+    return current().alloc(size, alignment);
+  }
+
+  /**
+   * @brief Constructs an object of type T in this frame, destroyed when its
+   * buffer is next reset.
+   * @param args Arguments forwarded to T's constructor.
+   * @return The constructed object, or nullptr if out of space.
+   * @throws Any exception thrown by T's constructor.
+   */
+  template <typename T, typename... Args>
+  [[nodiscard]] T* emplace(Args&&... args) {
+    return current().template emplace<T>(std::forward<Args>(args)...);
+  }
+
+ private:
+  // The two buffers, alternating every frame
+  std::array<Allocator, 2> buffers_;
+
+  // Index of the current buffer
+  size_type current_ = 0;
+
+  // Number of flips so far
+  std::uint64_t frame_ = 0;
+};
+
+}  // namespace intns::memory
+
+#endif
@@ -0,0 +1,59 @@
+#include "DoubleStackAllocator.hpp"
+
+#include <cstdlib>
+
+namespace intns::memory {
+DoubleStackAllocator::DoubleStackAllocator(size_type capacity) {
+  if (capacity == 0) {
+    throw std::runtime_error(
+        "DoubleStackAllocator: Cannot allocate 0 memory for stack.");
+  }
+
+  void* memory = std::malloc(capacity);
+  if (!memory) [[unlikely]] {
+    throw std::runtime_error(
+        "DoubleStackAllocator: Failed to allocate memory.");
+  }
+
+  start_marker_ = reinterpret_cast<marker_type>(memory);
+  capacity_ = capacity;
+  owns_memory_ = true;
+  reset();
+}
+
+DoubleStackAllocator::DoubleStackAllocator(void* memory, size_type size) {
+  if (!memory) [[unlikely]] {
+    throw std::runtime_error(
+        "DoubleStackAllocator: Handed null memory pointer.");
+  }
+
+  if (size == 0) [[unlikely]] {
+    throw std::runtime_error(
+        "DoubleStackAllocator: Cannot manage 0-byte buffer");
+  }
+
+  // Align the bottom end like StackAllocator does, the top end aligns itself
+  constexpr size_type min_usable_space = alignof(std::max_align_t);
+
+  std::uintptr_t addr = reinterpret_cast<std::uintptr_t>(memory);
+  std::uintptr_t start = align_address(addr, alignof(std::max_align_t));
+  std::uintptr_t offset = start - addr;
+
+  if (offset != 0 && offset + min_usable_space >= size) [[unlikely]] {
+    throw std::runtime_error(
+        "DoubleStackAllocator: Buffer too small after alignment");
+  }
+
+  start_marker_ = start;
+  capacity_ = size - offset;
+  owns_memory_ = false;
+  reset();
+}
+
+DoubleStackAllocator::~DoubleStackAllocator() {
+  if (owns_memory_) {
+    std::free(reinterpret_cast<std::uint8_t*>(start_marker_));
+  }
+}
+
+}  // namespace intns::memory
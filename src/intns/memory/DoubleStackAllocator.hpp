@@ -0,0 +1,313 @@
+#ifndef INTNS_MEMORY_DOUBLESTACKALLOCATOR_HPP
+#define INTNS_MEMORY_DOUBLESTACKALLOCATOR_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <stdexcept>
+#include <type_traits>
+
+#include "Alignment.hpp"
+
+namespace intns::memory {
+
+/**
+ * @brief Selects which end of a DoubleStackAllocator to allocate from.
+ */
+enum class StackSide : uint8_t {
+  kBottom = 0,  // Grows upwards from the start of the block
+  kTop          // Grows downwards from the end of the block
+};
+
+/**
+ * @class DoubleStackAllocator
+ * @brief A linear allocator with two stacks growing towards each other in one
+ * memory block.
+ *
+ * Useful for splitting one budget between two lifetimes, e.g. long-lived data
+ * at the bottom and temporaries at the top, without fixing the split up
+ * front. Allocation fails only when the two stacks meet.
+ *
+ * Each end is exposed through bottom() and top(), which have the
+ * StackAllocator allocation and checkpoint interface, so BasicStackCheckpoint
+ * and AllocatorResource work on either end independently.
+ *
+ * Usage Notes:
+ * - Allocations valid only until their end is reset or restored past them.
+ * - Doesn't invoke constructors/destructors; use placement new and manual
+ * cleanup.
+ * - Not thread-safe; designed for single-threaded use.
+ */
+class DoubleStackAllocator {
+ public:
+  using marker_type = std::uintptr_t;
+  using checkpoint_t = marker_type;
+  using size_type = std::size_t;
+
+  /**
+   * @brief One end of the allocator, with the StackAllocator interface.
+   * @tparam Side The end this object allocates from.
+   */
+  template <StackSide Side>
+  class End {
+   public:
+    using marker_type = DoubleStackAllocator::marker_type;
+    using checkpoint_t = DoubleStackAllocator::checkpoint_t;
+    using size_type = DoubleStackAllocator::size_type;
+
+    // Refers back to its allocator
+    End(const End&) = delete;
+    End& operator=(const End&) = delete;
+
+    /**
+     * @brief Allocates memory for a single object of type T from this end.
+     * @return The allocated memory for T, or nullptr on failure.
+     */
+    template <typename T>
+    [[nodiscard]] T* alloc_t() noexcept {
+      static_assert(!std::is_reference_v<T>,
+                    "Cannot allocate storage for reference types");
+      static_assert(!std::is_void_v<T>, "Cannot allocate storage for void");
+      static_assert(std::is_destructible_v<T>, "Type must be destructible");
+      static_assert(sizeof(T) > 0, "Type must have non-zero size");
+
+      return static_cast<T*>(alloc(sizeof(T), alignof(T)));
+    }
+
+    /**
+     * @brief Allocates a block of memory from this end.
+     *
+     * @param size Number of bytes to allocate.
+     * @param alignment Alignment in bytes (default: alignof(max_align_t)).
+     * @return Pointer to allocated memory, or nullptr if size is zero,
+     * alignment is not a power of two, or the ends would overlap.
+     */
+    [[nodiscard]] void* alloc(
+        size_type size,
+        size_type alignment = alignof(std::max_align_t)) noexcept {
+      return owner_.alloc_from<Side>(size, alignment);
+    }
+
+    /**
+     * @brief Frees the most recent allocation of this end, if `ptr` is it.
+     * @return true if the allocation was on top and has been released.
+     */
+    [[nodiscard]] bool release_top(void* ptr, size_type size) noexcept {
+      return owner_.release_from<Side>(ptr, size);
+    }
+
+    /**
+     * @brief Saves the current state of this end.
+     * @return checkpoint_t The current marker of this end.
+     */
+    [[nodiscard]] checkpoint_t save_checkpoint() const noexcept {
+      return Side == StackSide::kBottom ? owner_.bottom_marker_
+                                        : owner_.top_marker_;
+    }
+
+    /**
+     * @brief Restores this end to a previously saved checkpoint.
+     *
+     * @param checkpoint The previous state of this end.
+     * @throws std::runtime_error if the checkpoint lies outside the block or
+     * inside memory currently used by the other end.
+     */
+    void restore_checkpoint(checkpoint_t checkpoint) {
+      owner_.restore_from<Side>(checkpoint);
+    }
+
+    /**
+     * @brief Returns the number of bytes used by this end.
+     * @return The number of bytes used.
+     */
+    [[nodiscard]] size_type bytes_used() const noexcept {
+      return Side == StackSide::kBottom
+                 ? owner_.bottom_marker_ - owner_.start_marker_
+                 : owner_.end_marker() - owner_.top_marker_;
+    }
+
+    /**
+     * @brief Releases every allocation of this end.
+     */
+    void reset() noexcept {
+      if constexpr (Side == StackSide::kBottom) {
+        owner_.bottom_marker_ = owner_.start_marker_;
+      } else {
+        owner_.top_marker_ = owner_.end_marker();
+      }
+    }
+
+   private:
+    friend class DoubleStackAllocator;
+
+    explicit End(DoubleStackAllocator& owner) noexcept : owner_(owner) {}
+
+    // The allocator this end belongs to
+    DoubleStackAllocator& owner_;
+  };
+
+  /**
+   * @brief Constructs a DoubleStackAllocator with the specified capacity.
+   *
+   * @param capacity The size in bytes of the memory block to allocate.
+   * @throws std::runtime_error If capacity is zero or memory allocation fails.
+   */
+  DoubleStackAllocator(size_type capacity = 1000);
+
+  /**
+   * @brief Constructs a DoubleStackAllocator with a given memory block and
+   * size.
+   * @warning Does NOT take ownership of the memory, must be free'd externally.
+   *
+   * @param memory Pointer to the memory buffer to be managed.
+   * @param size Size of the memory buffer in bytes.
+   * @throws std::runtime_error If memory is null, size is zero, or buffer is
+   * too small after alignment.
+   */
+  DoubleStackAllocator(void* memory, size_type size);
+
+  /**
+   * @brief Frees the memory block, if owned.
+   */
+  ~DoubleStackAllocator();
+
+  // Don't allow moving or copying
+  DoubleStackAllocator(const DoubleStackAllocator&) = delete;
+  DoubleStackAllocator& operator=(const DoubleStackAllocator&) = delete;
+  DoubleStackAllocator(DoubleStackAllocator&&) = delete;
+  DoubleStackAllocator& operator=(DoubleStackAllocator&&) = delete;
+
+  /**
+   * @brief Returns the end growing upwards from the start of the block.
+   * @return The bottom end.
+   */
+  [[nodiscard]] End<StackSide::kBottom>& bottom() noexcept { return bottom_; }
+
+  /**
+   * @brief Returns the end growing downwards from the end of the block.
+   * @return The top end.
+   */
+  [[nodiscard]] End<StackSide::kTop>& top() noexcept { return top_; }
+
+  /**
+   * @brief Returns the number of bytes used by both ends together.
+   * @return The number of bytes used.
+   */
+  [[nodiscard]] size_type bytes_used() const noexcept {
+    return capacity_ - bytes_remaining();
+  }
+
+  /**
+   * @brief Returns the number of bytes between the two ends.
+   * @return The number of bytes either end can still allocate, before
+   * alignment.
+   */
+  [[nodiscard]] size_type bytes_remaining() const noexcept {
+    return top_marker_ - bottom_marker_;
+  }
+
+  /**
+   * @brief Returns the total capacity of the allocator.
+   * @return The maximum number of bytes that can be stored.
+   */
+  [[nodiscard]] size_type capacity() const noexcept { return capacity_; }
+
+  /**
+   * @brief Releases every allocation of both ends.
+   */
+  void reset() noexcept {
+    bottom_marker_ = start_marker_;
+    top_marker_ = end_marker();
+  }
+
+ private:
+  [[nodiscard]] marker_type end_marker() const noexcept {
+    return start_marker_ + capacity_;
+  }
+
+  template <StackSide Side>
+  [[nodiscard]] void* alloc_from(size_type size, size_type alignment) noexcept {
+    if (size == 0 || !is_power_of_two(alignment) || size > bytes_remaining())
+        [[unlikely]] {
+      return nullptr;
+    }
+
+    if constexpr (Side == StackSide::kBottom) {
+      const auto aligned_pos = align_address(bottom_marker_, alignment);
+      if (aligned_pos < bottom_marker_ || aligned_pos > top_marker_ ||
+          size > top_marker_ - aligned_pos) {
+        return nullptr;
+      }
+
+      bottom_marker_ = aligned_pos + size;
+      return reinterpret_cast<void*>(aligned_pos);
+    } else {
+      // Round down from the top, the allocation ends at or below top_marker_
+      const auto aligned_pos = (top_marker_ - size) & ~(alignment - 1);
+      if (aligned_pos < bottom_marker_) {
+        return nullptr;
+      }
+
+      top_marker_ = aligned_pos;
+      return reinterpret_cast<void*>(aligned_pos);
+    }
+  }
+
+  template <StackSide Side>
+  [[nodiscard]] bool release_from(void* ptr, size_type size) noexcept {
+    const auto addr = reinterpret_cast<marker_type>(ptr);
+    if constexpr (Side == StackSide::kBottom) {
+      if (addr < start_marker_ || addr + size != bottom_marker_) {
+        return false;
+      }
+      bottom_marker_ = addr;
+    } else {
+      if (addr != top_marker_ || size > end_marker() - addr) {
+        return false;
+      }
+      top_marker_ = addr + size;
+    }
+    return true;
+  }
+
+  template <StackSide Side>
+  void restore_from(checkpoint_t checkpoint) {
+    const bool valid = Side == StackSide::kBottom
+                           ? checkpoint >= start_marker_ &&
+                                 checkpoint <= top_marker_
+                           : checkpoint >= bottom_marker_ &&
+                                 checkpoint <= end_marker();
+    if (!valid) [[unlikely]] {
+      throw std::runtime_error(
+          "DoubleStackAllocator::restore_checkpoint: Invalid checkpoint");
+    }
+
+    if constexpr (Side == StackSide::kBottom) {
+      bottom_marker_ = checkpoint;
+    } else {
+      top_marker_ = checkpoint;
+    }
+  }
+
+  // Marker to track the beginning of the block
+  marker_type start_marker_ = 0;
+
+  // First free byte of the bottom end
+  marker_type bottom_marker_ = 0;
+
+  // One past the last free byte, where the top end begins
+  marker_type top_marker_ = 0;
+
+  // The full size of the block
+  size_type capacity_ = 0;
+
+  // Tracks ownership of the start marker
+  bool owns_memory_ = true;
+
+  // The two ends, handed out by reference
+  End<StackSide::kBottom> bottom_{*this};
+  End<StackSide::kTop> top_{*this};
+};
+
+}  // namespace intns::memory
+
+#endif
@@ -0,0 +1,203 @@
+#ifndef INTNS_MEMORY_MEMORYRESOURCE_HPP
+#define INTNS_MEMORY_MEMORYRESOURCE_HPP
+
+#include <concepts>
+#include <cstddef>
+#include <limits>
+#include <memory_resource>
+#include <new>
+#include <type_traits>
+
+#include "StackAllocator.hpp"
+
+namespace intns::memory {
+
+/**
+ * @brief Concept for allocators the adapters can allocate from.
+ */
+template <typename Allocator>
+concept RawAllocator =
+    requires(Allocator& a, std::size_t size, std::size_t alignment) {
+      { a.alloc(size, alignment) } noexcept -> std::same_as<void*>;
+    };
+
+/**
+ * @brief Concept for allocators that free individual allocations, given the
+ * size and alignment they were allocated with.
+ */
+template <typename Allocator>
+concept FreeingAllocator =
+    RawAllocator<Allocator> &&
+    requires(Allocator& a, void* p, std::size_t size, std::size_t alignment) {
+      { a.deallocate(p, size, alignment) } noexcept;
+    };
+
+/**
+ * @brief Concept for linear allocators that can only free their most recent
+ * allocation.
+ */
+template <typename Allocator>
+concept LinearAllocator =
+    RawAllocator<Allocator> && requires(Allocator& a, void* p,
+                                        std::size_t size) {
+      { a.release_top(p, size) } noexcept -> std::same_as<bool>;
+    };
+
+/**
+ * @brief Returns memory to the allocator it came from, by whichever means the
+ * allocator supports.
+ *
+ * Freeing allocators get a real free, linear allocators release the block
+ * only if it is their most recent allocation and ignore it otherwise; the
+ * memory is then reclaimed on reset or checkpoint restore.
+ */
+template <typename Allocator>
+  requires FreeingAllocator<Allocator> || LinearAllocator<Allocator>
+void give_back(Allocator& a, void* p, std::size_t size,
+               std::size_t alignment) noexcept {
+  if constexpr (FreeingAllocator<Allocator>) {
+    a.deallocate(p, size, alignment);
+  } else {
+    (void)a.release_top(p, size);
+  }
+}
+
+/**
+ * @class AllocatorResource
+ * @brief A std::pmr::memory_resource drawing from one of the library's
+ * allocators.
+ *
+ * Over a StackAllocator or ArenaAllocator the resource is monotonic:
+ * do_deallocate() is a no-op unless the block is the allocator's most recent
+ * allocation, so a std::pmr container created inside a StackCheckpoint frame
+ * lives entirely in that frame. Destroy such containers before the frame
+ * ends.
+ *
+ * @tparam Allocator The allocator to draw from; it must outlive the resource.
+ *
+ * @section Exception Safety
+ * do_allocate() throws std::bad_alloc if the allocator is out of memory.
+ */
+template <typename Allocator = StackAllocator>
+  requires FreeingAllocator<Allocator> || LinearAllocator<Allocator>
+class AllocatorResource : public std::pmr::memory_resource {
+ public:
+  /**
+   * @brief Creates a resource allocating from `a`.
+   * @param a The allocator to draw from.
+   */
+  explicit AllocatorResource(Allocator& a) noexcept : allocator_(&a) {}
+
+  /**
+   * @brief Returns the allocator this resource draws from.
+   * @return The underlying allocator.
+   */
+  [[nodiscard]] Allocator& allocator() const noexcept { return *allocator_; }
+
+ private:
+  void* do_allocate(std::size_t bytes, std::size_t alignment) override {
+    // memory_resource allows zero-byte requests, the allocators don't
+    void* p = allocator_->alloc(bytes == 0 ? 1 : bytes, alignment);
+    if (!p) [[unlikely]] {
+      throw std::bad_alloc();
+    }
+    return p;
+  }
+
+  void do_deallocate(void* p, std::size_t bytes,
+                     std::size_t alignment) override {
+    give_back(*allocator_, p, bytes == 0 ? 1 : bytes, alignment);
+  }
+
+  [[nodiscard]] bool do_is_equal(
+      const std::pmr::memory_resource& other) const noexcept override {
+    return this == &other;
+  }
+
+  // The allocator to draw from
+  Allocator* allocator_;
+};
+
+/**
+ * @class AllocatorAdapter
+ * @brief A standard Allocator for containers, drawing from one of the
+ * library's allocators.
+ *
+ * Use it where std::pmr is not an option, e.g.
+ * `std::vector<int, AllocatorAdapter<int>> v(AllocatorAdapter<int>(stack));`.
+ * Deallocation follows the same rules as AllocatorResource.
+ *
+ * @tparam T The type of objects allocated.
+ * @tparam Allocator The allocator to draw from; it must outlive every
+ * container using it.
+ */
+template <typename T, typename Allocator = StackAllocator>
+  requires FreeingAllocator<Allocator> || LinearAllocator<Allocator>
+class AllocatorAdapter {
+ public:
+  using value_type = T;
+
+  // Containers keep allocating from the same allocator when moved or swapped
+  using propagate_on_container_move_assignment = std::true_type;
+  using propagate_on_container_swap = std::true_type;
+
+  /**
+   * @brief Creates an adapter allocating from `a`.
+   * @param a The allocator to draw from.
+   */
+  explicit AllocatorAdapter(Allocator& a) noexcept : allocator_(&a) {}
+
+  /**
+   * @brief Rebinding constructor; shares the other adapter's allocator.
+   */
+  template <typename U>
+  AllocatorAdapter(const AllocatorAdapter<U, Allocator>& other) noexcept
+      : allocator_(&other.allocator()) {}
+
+  /**
+   * @brief Allocates storage for `n` objects of type T.
+   * @param n The number of objects.
+   * @return The allocated storage.
+   * @throws std::bad_alloc If the allocator is out of memory.
+   */
+  [[nodiscard]] T* allocate(std::size_t n) {
+    if (n > std::numeric_limits<std::size_t>::max() / sizeof(T)) [[unlikely]] {
+      throw std::bad_alloc();
+    }
+
+    void* p = allocator_->alloc(n == 0 ? 1 : n * sizeof(T), alignof(T));
+    if (!p) [[unlikely]] {
+      throw std::bad_alloc();
+    }
+    return static_cast<T*>(p);
+  }
+
+  /**
+   * @brief Returns storage obtained from allocate().
+   * @param p The storage.
+   * @param n The number of objects it was allocated for.
+   */
+  void deallocate(T* p, std::size_t n) noexcept {
+    give_back(*allocator_, p, n == 0 ? 1 : n * sizeof(T), alignof(T));
+  }
+
+  /**
+   * @brief Returns the allocator this adapter draws from.
+   * @return The underlying allocator.
+   */
+  [[nodiscard]] Allocator& allocator() const noexcept { return *allocator_; }
+
+  template <typename U>
+  [[nodiscard]] bool operator==(
+      const AllocatorAdapter<U, Allocator>& other) const noexcept {
+    return allocator_ == &other.allocator();
+  }
+
+ private:
+  // The allocator to draw from
+  Allocator* allocator_;
+};
+
+}  // namespace intns::memory
+
+#endif
@@ -0,0 +1,242 @@
+#ifndef INTNS_MEMORY_MEMORYSTATS_HPP
+#define INTNS_MEMORY_MEMORYSTATS_HPP
+
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+
+namespace intns::memory {
+
+/**
+ * @brief A point-in-time copy of the counters kept by PoolStats.
+ */
+struct PoolStatsSnapshot {
+  std::uint64_t hits = 0;              ///< Objects handed out.
+  std::uint64_t misses = 0;            ///< Acquisitions that found no object.
+  std::uint64_t adds = 0;              ///< Objects returned to the pool.
+  std::uint64_t rejected_adds = 0;     ///< Adds refused by the size limit.
+  std::uint64_t created = 0;           ///< Objects created by the pool.
+  std::uint64_t trimmed = 0;           ///< Idle objects destroyed by trimming.
+  std::uint64_t high_water = 0;        ///< Most objects ever pooled at once.
+  std::uint64_t lock_contentions = 0;  ///< Lock acquisitions that had to wait.
+  std::uint64_t lock_wait_ns = 0;      ///< Total time waiting on the lock.
+  std::uint64_t leases = 0;            ///< Finished PoolLease lifetimes.
+  std::uint64_t lease_ns = 0;          ///< Total time objects spent leased.
+
+  /**
+   * @brief Returns the fraction of acquisitions that found an object.
+   * @return A value in [0, 1], or 0 if nothing was acquired yet.
+   */
+  [[nodiscard]] double hit_rate() const noexcept {
+    const std::uint64_t total = hits + misses;
+    return total == 0 ? 0.0 : static_cast<double>(hits) / total;
+  }
+
+  /**
+   * @brief Returns the average time an object spent in a PoolLease.
+   * @return The average lease duration, or zero if no lease finished yet.
+   */
+  [[nodiscard]] std::chrono::nanoseconds average_lease() const noexcept {
+    return std::chrono::nanoseconds(leases == 0 ? 0 : lease_ns / leases);
+  }
+};
+
+/**
+ * @brief A point-in-time copy of the counters kept by AllocatorStats.
+ */
+struct AllocatorStatsSnapshot {
+  std::uint64_t allocs = 0;         ///< Successful allocations.
+  std::uint64_t failed_allocs = 0;  ///< Allocations that returned nullptr.
+  std::uint64_t peak_bytes = 0;     ///< Highest bytes_used() reached.
+};
+
+/**
+ * @brief Pool statistics policy that records nothing.
+ *
+ * Every hook is an empty inline function, so a pool using it compiles to the
+ * same code as one without statistics.
+ */
+struct NoPoolStats {
+  static constexpr bool kEnabled = false;
+
+  void on_hit(std::size_t) const noexcept {}
+  void on_miss() const noexcept {}
+  void on_add(std::size_t, std::size_t) const noexcept {}
+  void on_add_rejected() const noexcept {}
+  void on_created(std::size_t, std::size_t) const noexcept {}
+  void on_trimmed(std::size_t) const noexcept {}
+  void on_lock_wait(std::chrono::nanoseconds) const noexcept {}
+  void on_lease(std::chrono::nanoseconds) const noexcept {}
+
+  [[nodiscard]] PoolStatsSnapshot snapshot() const noexcept { return {}; }
+  void reset() const noexcept {}
+};
+
+/**
+ * @brief Pool statistics policy backed by relaxed atomic counters.
+ *
+ * Hooks are const so they can be called from const pool members and from
+ * PoolLease; snapshot() may be called from any thread, e.g. by a metrics
+ * scraper, and sees each counter individually up to date.
+ */
+class PoolStats {
+ public:
+  static constexpr bool kEnabled = true;
+
+  void on_hit(std::size_t count) const noexcept { bump(hits_, count); }
+  void on_miss() const noexcept { bump(misses_, 1); }
+
+  void on_add(std::size_t count, std::size_t pooled) const noexcept {
+    bump(adds_, count);
+    raise(high_water_, pooled);
+  }
+
+  void on_add_rejected() const noexcept { bump(rejected_adds_, 1); }
+
+  void on_created(std::size_t count, std::size_t pooled) const noexcept {
+    bump(created_, count);
+    raise(high_water_, pooled);
+  }
+
+  void on_trimmed(std::size_t count) const noexcept { bump(trimmed_, count); }
+
+  void on_lock_wait(std::chrono::nanoseconds wait) const noexcept {
+    bump(lock_contentions_, 1);
+    bump(lock_wait_ns_, static_cast<std::uint64_t>(wait.count()));
+  }
+
+  void on_lease(std::chrono::nanoseconds duration) const noexcept {
+    bump(leases_, 1);
+    bump(lease_ns_, static_cast<std::uint64_t>(duration.count()));
+  }
+
+  /**
+   * @brief Copies every counter.
+   * @return The current counter values.
+   */
+  [[nodiscard]] PoolStatsSnapshot snapshot() const noexcept {
+    PoolStatsSnapshot s;
+    s.hits = load(hits_);
+    s.misses = load(misses_);
+    s.adds = load(adds_);
+    s.rejected_adds = load(rejected_adds_);
+    s.created = load(created_);
+    s.trimmed = load(trimmed_);
+    s.high_water = load(high_water_);
+    s.lock_contentions = load(lock_contentions_);
+    s.lock_wait_ns = load(lock_wait_ns_);
+    s.leases = load(leases_);
+    s.lease_ns = load(lease_ns_);
+    return s;
+  }
+
+  /**
+   * @brief Zeroes every counter.
+   */
+  void reset() const noexcept {
+    for (auto* counter :
+         {&hits_, &misses_, &adds_, &rejected_adds_, &created_, &trimmed_,
+          &high_water_, &lock_contentions_, &lock_wait_ns_, &leases_,
+          &lease_ns_}) {
+      counter->store(0, std::memory_order_relaxed);
+    }
+  }
+
+ private:
+  using counter_type = std::atomic<std::uint64_t>;
+
+  static void bump(counter_type& c, std::uint64_t n) noexcept {
+    c.fetch_add(n, std::memory_order_relaxed);
+  }
+
+  static void raise(counter_type& c, std::uint64_t value) noexcept {
+    std::uint64_t seen = c.load(std::memory_order_relaxed);
+    while (value > seen &&
+           !c.compare_exchange_weak(seen, value, std::memory_order_relaxed)) {
+    }
+  }
+
+  [[nodiscard]] static std::uint64_t load(const counter_type& c) noexcept {
+    return c.load(std::memory_order_relaxed);
+  }
+
+  mutable counter_type hits_ = 0;
+  mutable counter_type misses_ = 0;
+  mutable counter_type adds_ = 0;
+  mutable counter_type rejected_adds_ = 0;
+  mutable counter_type created_ = 0;
+  mutable counter_type trimmed_ = 0;
+  mutable counter_type high_water_ = 0;
+  mutable counter_type lock_contentions_ = 0;
+  mutable counter_type lock_wait_ns_ = 0;
+  mutable counter_type leases_ = 0;
+  mutable counter_type lease_ns_ = 0;
+};
+
+/**
+ * @brief Allocator statistics policy that records nothing.
+ */
+struct NoAllocatorStats {
+  static constexpr bool kEnabled = false;
+
+  void on_alloc(std::size_t) const noexcept {}
+  void on_alloc_failed() const noexcept {}
+
+  [[nodiscard]] AllocatorStatsSnapshot snapshot() const noexcept { return {}; }
+  void reset() const noexcept {}
+};
+
+/**
+ * @brief Allocator statistics policy backed by relaxed atomic counters.
+ *
+ * Allocators are single-threaded, so counters are only ever written by the
+ * owning thread; the atomics just make snapshot() safe from other threads.
+ */
+class AllocatorStats {
+ public:
+  static constexpr bool kEnabled = true;
+
+  void on_alloc(std::size_t bytes_used) const noexcept {
+    allocs_.store(allocs_.load(std::memory_order_relaxed) + 1,
+                  std::memory_order_relaxed);
+    if (bytes_used > peak_bytes_.load(std::memory_order_relaxed)) {
+      peak_bytes_.store(bytes_used, std::memory_order_relaxed);
+    }
+  }
+
+  void on_alloc_failed() const noexcept {
+    failed_allocs_.store(failed_allocs_.load(std::memory_order_relaxed) + 1,
+                         std::memory_order_relaxed);
+  }
+
+  /**
+   * @brief Copies every counter.
+   * @return The current counter values.
+   */
+  [[nodiscard]] AllocatorStatsSnapshot snapshot() const noexcept {
+    AllocatorStatsSnapshot s;
+    s.allocs = allocs_.load(std::memory_order_relaxed);
+    s.failed_allocs = failed_allocs_.load(std::memory_order_relaxed);
+    s.peak_bytes = peak_bytes_.load(std::memory_order_relaxed);
+    return s;
+  }
+
+  /**
+   * @brief Zeroes every counter.
+   */
+  void reset() const noexcept {
+    allocs_.store(0, std::memory_order_relaxed);
+    failed_allocs_.store(0, std::memory_order_relaxed);
+    peak_bytes_.store(0, std::memory_order_relaxed);
+  }
+
+ private:
+  mutable std::atomic<std::uint64_t> allocs_ = 0;
+  mutable std::atomic<std::uint64_t> failed_allocs_ = 0;
+  mutable std::atomic<std::uint64_t> peak_bytes_ = 0;
+};
+
+}  // namespace intns::memory
+
+#endif  // INTNS_MEMORY_MEMORYSTATS_HPP
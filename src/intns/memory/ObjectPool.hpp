@@ -1,14 +1,30 @@
 #ifndef INTNS_MEMORY_OBJECTPOOL_HPP
 #define INTNS_MEMORY_OBJECTPOOL_HPP
 
+#include <algorithm>
 #include <cassert>
+#include <chrono>
+#include <concepts>
+#include <condition_variable>
+#include <coroutine>
 #include <deque>
+#include <exception>
+#include <functional>
+#include <iterator>
 #include <mutex>
 #include <optional>
+#include <ranges>
+#include <span>
 #include <stdexcept>
+#include <stop_token>
 #include <string>
+#include <thread>
 #include <type_traits>
 #include <utility>
+#include <vector>
+
+#include "../trace/Trace.hpp"
+#include "MemoryStats.hpp"
 
 namespace intns::memory {
 /**
@@ -31,6 +47,42 @@ concept ReleaseHook = requires(T& obj) {
   { Policy::on_release(obj) } noexcept;
 };
 
+/**
+ * @brief Concept to check if a type supports the batched acquire hook.
+ * Type `T` must implement `Policy::on_acquire_batch(std::span<T>)`, which is
+ * `noexcept`. When present, batch operations call it instead of looping over
+ * `on_acquire`.
+ * @tparam T The type to check for the batched acquire hook.
+ */
+template <typename Policy, typename T>
+concept AcquireBatchHook = requires(std::span<T> objs) {
+  { Policy::on_acquire_batch(objs) } noexcept;
+};
+
+/**
+ * @brief Concept to check if a type supports the batched release hook.
+ * Type `T` must implement `Policy::on_release_batch(std::span<T>)`, which is
+ * `noexcept`. When present, batch operations call it instead of looping over
+ * `on_release`.
+ * @tparam T The type to check for the batched release hook.
+ */
+template <typename Policy, typename T>
+concept ReleaseBatchHook = requires(std::span<T> objs) {
+  { Policy::on_release_batch(objs) } noexcept;
+};
+
+/**
+ * @brief A range whose elements can be moved into an ObjectPool of `T`.
+ * @tparam Range The range type.
+ */
+template <typename Range, typename T>
+concept PoolInputRange =
+    std::ranges::sized_range<Range> &&
+    std::same_as<std::remove_cvref_t<std::ranges::range_reference_t<Range>>,
+                 T> &&
+    !std::is_const_v<
+        std::remove_reference_t<std::ranges::range_reference_t<Range>>>;
+
 /**
  * @brief A no-operation pool policy for resource management.
  *
@@ -46,22 +98,52 @@ struct NoOpPoolPolicy {
   static void on_release(U&) noexcept {}
 };
 
+/**
+ * @brief On-demand growth settings for an ObjectPool built from a factory.
+ */
+struct PoolGrowth {
+  // Objects created at once when the pool runs empty
+  size_t chunk_size = 16;
+
+  // Objects to create up front
+  size_t prewarm = 0;
+
+  // Create the prewarm objects on a background thread instead of in the
+  // constructor
+  bool prewarm_in_background = false;
+
+  // Destroy pooled objects left unused for this long, checked on a background
+  // thread; zero disables trimming
+  std::chrono::milliseconds idle_period{0};
+
+  // Trimming never leaves fewer than this many pooled objects
+  size_t min_idle = 0;
+};
+
 /**
  * @brief A thread-safe object pool for managing reusable objects of type T.
  *
  * ObjectPool efficiently manages reusable objects, reducing allocation costs.
  * It supports size limits, customizable policies, and ensures exception safety.
  *
- * @tparam T The type of objects managed (default and move constructible).
+ * @tparam T The type of objects managed (move constructible, and default
+ * constructible unless the pool is built from a factory).
  * @tparam AcquirePolicy Class with static on_acquire(T&) called on acquisition.
  * @tparam ReleasePolicy Class with static on_release(T&) called on release.
+ * @tparam StatsPolicy NoPoolStats (default, free) or PoolStats to count hits,
+ * misses, lock contention and lease durations; see stats().
  *
  * @note All public methods are thread-safe.
  *
  * @section Usage
  * Use take() or try_take() to acquire objects.
  * Use add() or try_add() to return objects.
- * Construct the pool with an initial size and optional size limit.
+ * Use take_n(), try_take_n() and add_n() to move many objects under one lock.
+ * Use take_for() or take_until() to wait for an object, or async_take() to be
+ * handed one by a later add() without blocking.
+ * Construct the pool with an initial size and optional size limit, or with a
+ * factory so objects are created lazily, in chunks, when the pool runs empty;
+ * the size limit then also caps how many objects the pool creates.
  *
  *@section Exception Safety
  * Construction throws std::runtime_error if initial size exceeds limit.
@@ -69,11 +151,10 @@ struct NoOpPoolPolicy {
  * Exceptions during object creation or policy methods are propagated.
  */
 template <typename T, typename AcquirePolicy = NoOpPoolPolicy<T>,
-          typename ReleasePolicy = AcquirePolicy>
+          typename ReleasePolicy = AcquirePolicy,
+          typename StatsPolicy = NoPoolStats>
   requires AcquireHook<AcquirePolicy, T> && ReleaseHook<ReleasePolicy, T>
 class ObjectPool {
-  static_assert(std::is_default_constructible_v<T>,
-                "T must be default constructible");
   static_assert(std::is_move_constructible_v<T>,
                 "T must be move constructible");
 
@@ -81,6 +162,8 @@ class ObjectPool {
   using queue_type = std::deque<T>;
   using size_type = size_t;
   using value_type = T;
+  using factory_type = std::function<value_type()>;
+  using stats_type = StatsPolicy;
 
   ObjectPool() = default;
   ~ObjectPool() = default;
@@ -110,6 +193,39 @@ class ObjectPool {
   ObjectPool(size_type init_size,
              std::optional<size_type> limit = std::nullopt);
 
+  /**
+   * @brief Creates an ObjectPool that builds objects with `factory` on demand.
+   *
+   * Whenever an acquisition finds the pool empty, `growth.chunk_size` objects
+   * are created (outside the lock) and processed by
+   * `ReleasePolicy::on_release`, as long as the pool has created fewer than
+   * `limit` objects in total.
+   *
+   * @param factory Creates one object; may capture any constructor arguments.
+   * @param growth Chunk size, prewarming and idle trimming settings.
+   * @param limit The maximum number of objects the pool may create and hold
+   * (optional, default is 0 for unlimited).
+   * @throws std::invalid_argument If `factory` is empty or the chunk size is
+   * zero.
+   * @throws std::runtime_error If `growth.prewarm` is greater than the
+   * specified size limit.
+   * @throws Any exception thrown by `factory` while prewarming in the
+   * constructor.
+   */
+  explicit ObjectPool(factory_type factory, PoolGrowth growth = {},
+                      std::optional<size_type> limit = std::nullopt);
+
+  /**
+   * @brief Destroys pooled objects that went unused since the previous trim.
+   *
+   * Objects below the lowest pool size seen since the last trim were not
+   * touched in between, so that many (minus `PoolGrowth::min_idle`) are
+   * destroyed. Factory pools with an idle period call this periodically.
+   *
+   * @return The number of objects destroyed.
+   */
+  size_type trim_idle();
+
   /**
    * @brief Removes and returns an object from the pool.
    *
@@ -143,6 +259,156 @@ class ObjectPool {
    */
   [[nodiscard]] bool try_add(value_type&& back);
 
+  /**
+   * @brief Removes enough objects from the pool to fill `out`, taking the lock
+   * once. Existing elements of `out` are move-assigned over.
+   *
+   * @param out The destination for the acquired objects.
+   * @throws std::runtime_error If fewer than `out.size()` objects are pooled;
+   * the pool is left unchanged.
+   */
+  void take_n(std::span<value_type> out);
+
+  /**
+   * @brief Removes and returns `count` objects, taking the lock once.
+   *
+   * @param count The number of objects to acquire.
+   * @return std::vector<value_type> The acquired objects.
+   * @throws std::runtime_error If fewer than `count` objects are pooled; the
+   * pool is left unchanged.
+   */
+  [[nodiscard]] std::vector<value_type> take_n(size_type count);
+
+  /**
+   * @brief Removes and returns up to `count` objects, taking the lock once.
+   *
+   * @param count The maximum number of objects to acquire.
+   * @return std::vector<value_type> The acquired objects, fewer than `count`
+   * (possibly none) if the pool runs short.
+   */
+  [[nodiscard]] std::vector<value_type> try_take_n(size_type count);
+
+  /**
+   * @brief Adds every object of a range to the pool, taking the lock once.
+   * The range's elements are moved from.
+   *
+   * @param objects The objects to add.
+   * @throws std::runtime_error If adding them all would exceed the size limit;
+   * nothing is added.
+   */
+  template <PoolInputRange<T> Range>
+  void add_n(Range&& objects) {
+    add_n_impl<true>(std::forward<Range>(objects));
+  }
+
+  /**
+   * @brief Attempts to add every object of a range to the pool, taking the
+   * lock once. The range's elements are moved from on success.
+   *
+   * @param objects The objects to add.
+   * @return true if all objects were added; false if they would exceed the
+   * size limit, in which case nothing is added.
+   */
+  template <PoolInputRange<T> Range>
+  [[nodiscard]] bool try_add_n(Range&& objects) {
+    return add_n_impl<false>(std::forward<Range>(objects));
+  }
+
+  /**
+   * @brief Removes and returns an object, waiting up to `timeout` for another
+   * thread to add one if the pool is empty.
+   *
+   * @param timeout The maximum time to wait.
+   * @return value_type The acquired object from the pool.
+   * @throws std::runtime_error If no object became available in time.
+   */
+  template <typename Rep, typename Period>
+  [[nodiscard]] value_type take_for(
+      const std::chrono::duration<Rep, Period>& timeout) {
+    return take_until(std::chrono::steady_clock::now() + timeout);
+  }
+
+  /**
+   * @brief Removes and returns an object, waiting until `deadline` for another
+   * thread to add one if the pool is empty.
+   *
+   * @param deadline The point in time to stop waiting.
+   * @return value_type The acquired object from the pool.
+   * @throws std::runtime_error If no object became available in time.
+   */
+  template <typename Clock, typename Duration>
+  [[nodiscard]] value_type take_until(
+      const std::chrono::time_point<Clock, Duration>& deadline);
+
+  /**
+   * @brief Attempts to take an object, waiting up to `timeout` for another
+   * thread to add one if the pool is empty.
+   *
+   * @param timeout The maximum time to wait.
+   * @return std::optional<value_type> The acquired object, or std::nullopt if
+   * none became available in time.
+   */
+  template <typename Rep, typename Period>
+  [[nodiscard]] std::optional<value_type> try_take_for(
+      const std::chrono::duration<Rep, Period>& timeout) {
+    return try_take_until(std::chrono::steady_clock::now() + timeout);
+  }
+
+  /**
+   * @brief Attempts to take an object, waiting until `deadline` for another
+   * thread to add one if the pool is empty.
+   *
+   * @param deadline The point in time to stop waiting.
+   * @return std::optional<value_type> The acquired object, or std::nullopt if
+   * none became available in time.
+   */
+  template <typename Clock, typename Duration>
+  [[nodiscard]] std::optional<value_type> try_take_until(
+      const std::chrono::time_point<Clock, Duration>& deadline);
+
+  /**
+   * @brief Callback receiving an object handed over by async_take().
+   */
+  using callback_type = std::function<void(value_type)>;
+
+  /**
+   * @brief Awaitable returned by async_take(); `co_await` yields the object.
+   */
+  class TakeAwaiter;
+
+  /**
+   * @brief Acquires an object without blocking, calling `callback` with it.
+   *
+   * If the pool holds an object, `callback` runs immediately on the calling
+   * thread. Otherwise it is queued and runs on the thread of the add() call
+   * that supplies an object, after the lock is released. Queued callbacks are
+   * served in order and before threads blocked in take_for()/take_until().
+   *
+   * @param callback The function to hand the object to. Exceptions it throws
+   * propagate out of the call that ran it; a queued callback that throws
+   * still lets the remaining waiters be served, and the first exception is
+   * rethrown once the call that supplied the objects is done with them.
+   * @warning Queued callbacks are dropped if the pool is destroyed first.
+   */
+  void async_take(callback_type callback);
+
+  /**
+   * @brief Returns an awaitable that acquires an object, suspending the
+   * awaiting coroutine while the pool is empty.
+   *
+   * The coroutine is resumed on the thread of the add() call that supplies an
+   * object, as for async_take(callback_type).
+   *
+   * @code
+   * auto obj = co_await pool.async_take();
+   * @endcode
+   *
+   * @return TakeAwaiter The awaitable.
+   * @warning Suspended coroutines are never resumed if the pool is destroyed
+   * first.
+   */
+  [[nodiscard]] TakeAwaiter async_take() noexcept { return TakeAwaiter(*this); }
+
   /**
    * @brief Reserves space for a minimum number of objects in the pool.
    *
@@ -150,7 +416,9 @@ class ObjectPool {
    * @throws std::runtime_error if the target size is zero and `ThrowOnError`
    * is enabled.
    */
-  void reserve(size_type target_size) { reserve_impl<true>(target_size); }
+  void reserve(size_type target_size) {
+    (void)reserve_impl<true>(target_size);
+  }
 
   /**
    * @brief Reserves space for a minimum number of objects in the pool without
@@ -168,7 +436,7 @@ class ObjectPool {
    * current size. This may free unused memory and optimize resource usage.
    */
   void shrink_to_fit() {
-    std::scoped_lock<std::mutex> lock(mutex_);
+    const auto lock = lock_pool();
     objects_.shrink_to_fit();
   }
 
@@ -177,7 +445,7 @@ class ObjectPool {
    * @return Maximum objects before reallocation.
    */
   size_type capacity() const {
-    std::scoped_lock<std::mutex> lock(mutex_);
+    const auto lock = lock_pool();
     return objects_.capacity();
   }
 
@@ -186,7 +454,7 @@ class ObjectPool {
    * @return The number of objects managed.
    */
   [[nodiscard]] size_type size() const {
-    std::scoped_lock<std::mutex> lock(mutex_);
+    const auto lock = lock_pool();
     return objects_.size();
   }
 
@@ -195,7 +463,7 @@ class ObjectPool {
    * @return true if the pool contains no objects, false otherwise.
    */
   [[nodiscard]] bool empty() const {
-    std::scoped_lock<std::mutex> lock(mutex_);
+    const auto lock = lock_pool();
     return objects_.empty();
   }
 
@@ -205,7 +473,7 @@ class ObjectPool {
    * @return The size limit as a value of type size_type.
    */
   [[nodiscard]] std::optional<size_type> size_limit() const noexcept {
-    std::scoped_lock<std::mutex> lock(mutex_);
+    const auto lock = lock_pool();
     return size_limit_;
   }
 
@@ -214,11 +482,128 @@ class ObjectPool {
    * @param limit The new size limit.
    */
   void set_size_limit(std::optional<size_type> limit) noexcept {
-    std::scoped_lock<std::mutex> lock(mutex_);
+    const auto lock = lock_pool();
     size_limit_ = limit;
   }
 
+  /**
+   * @brief Returns the statistics policy instance, e.g. to take a snapshot().
+   * @return The pool's statistics; all zero for NoPoolStats.
+   */
+  [[nodiscard]] const stats_type& stats() const noexcept { return stats_; }
+
  private:
+  /**
+   * @brief Locks the pool, timing the wait if it was contended and statistics
+   * or tracing are enabled.
+   */
+  [[nodiscard]] std::unique_lock<std::mutex> lock_pool() const {
+    if constexpr (StatsPolicy::kEnabled || trace::kEnabled) {
+      std::unique_lock<std::mutex> lock(mutex_, std::try_to_lock);
+      if (!lock.owns_lock()) {
+        INTNS_TRACE_ZONE("ObjectPool::lock_wait");
+        const auto start = std::chrono::steady_clock::now();
+        lock.lock();
+        stats_.on_lock_wait(std::chrono::steady_clock::now() - start);
+      }
+      return lock;
+    } else {
+      return std::unique_lock<std::mutex>(mutex_);
+    }
+  }
+
+  /**
+   * @brief Pops the most recently added object, caller holds the lock.
+   */
+  [[nodiscard]] value_type pop_back_object() {
+    value_type value = std::move(objects_.back());
+    objects_.pop_back();
+    low_water_ = std::min(low_water_, objects_.size());
+    return value;
+  }
+
+  /**
+   * @brief Creates one object for reserve(), with the factory if set.
+   */
+  [[nodiscard]] value_type make_object();
+
+  /**
+   * @brief Grows the pool by at least `count` objects, rounded up to whole
+   * chunks and clamped to the size limit. The lock is held on entry and exit
+   * but released while the factory runs and while the new objects are handed
+   * to waiters, so callers must recheck the pool afterwards.
+   *
+   * @return true if any objects were pooled; false if the pool can't grow.
+   * @throws If `ThrowOnError` enabled, anything thrown by the factory.
+   */
+  template <bool ThrowOnError>
+  bool grow(std::unique_lock<std::mutex>& lock, size_type count);
+
+  /**
+   * @brief Grows the pool until it holds at least `count` objects, or it
+   * cannot grow further. Caller holds the lock.
+   *
+   * @return true if at least `count` objects are pooled.
+   */
+  template <bool ThrowOnError>
+  bool ensure_pooled(std::unique_lock<std::mutex>& lock, size_type count) {
+    while (objects_.size() < count) {
+      if (!grow<ThrowOnError>(lock, count - objects_.size())) {
+        return false;
+      }
+    }
+    return true;
+  }
+
+  /**
+   * @brief Body of the maintenance thread: prewarms, then trims periodically.
+   */
+  void maintain(std::stop_token stop);
+
+  /**
+   * @brief Hands newly added objects to queued async_take() callers, then
+   * wakes threads blocked in take_until(). Releases the lock.
+   *
+   * @throws The first exception thrown by a callback, after all of them ran.
+   */
+  void hand_off(std::unique_lock<std::mutex>& lock);
+
+  /**
+   * @brief Takes an object for `callback` if one is pooled, otherwise queues
+   * it. Caller holds the lock.
+   *
+   * @return The object if one was pooled, for the caller to hand over after
+   * releasing the lock.
+   */
+  [[nodiscard]] std::optional<value_type> take_or_enqueue(
+      std::unique_lock<std::mutex>& lock, callback_type& callback);
+
+  /**
+   * @brief Calls the acquire policy on a batch of freshly taken objects.
+   */
+  static void notify_acquire(std::span<value_type> objs) noexcept {
+    if constexpr (AcquireBatchHook<AcquirePolicy, T>) {
+      AcquirePolicy::on_acquire_batch(objs);
+    } else {
+      for (value_type& obj : objs) AcquirePolicy::on_acquire(obj);
+    }
+  }
+
+  /**
+   * @brief Moves up to `count` objects off the back of the queue, caller
+   * holds the lock.
+   */
+  [[nodiscard]] std::vector<value_type> pop_back_n(size_type count);
+
+  /**
+   * @brief Shared implementation of add_n() and try_add_n().
+   *
+   * @return If `ThrowOnError` disabled, true on success; false on failure.
+   * @throws If `ThrowOnError` enabled, throws `std::runtime_error` on failure.
+   */
+  template <bool ThrowOnError, typename Range>
+  bool add_n_impl(Range&& objects);
+
   /**
    * @brief Ensures the object pool contains at least the specified number of
    * objects.
@@ -242,6 +627,75 @@ class ObjectPool {
 
   // Customizable size limit object, unlimited unless specified
   std::optional<size_type> size_limit_ = std::nullopt;
+
+  // Signalled when objects are added while threads are blocked
+  std::condition_variable available_;
+
+  // Number of threads blocked in take_until()
+  size_type blocked_ = 0;
+
+  // Queued async_take() callers, served in order
+  std::deque<callback_type> waiters_;
+
+  // Creates objects on demand, empty for pools that don't grow
+  factory_type factory_;
+
+  // Growth settings used with factory_
+  PoolGrowth growth_;
+
+  // Objects created by the pool and not trimmed since
+  size_type created_ = 0;
+
+  // Lowest pool size since the last trim_idle()
+  size_type low_water_ = 0;
+
+  // Woken to stop the maintenance thread
+  std::condition_variable_any maintenance_cv_;
+
+  // Statistics policy, empty unless enabled
+  [[no_unique_address]] StatsPolicy stats_;
+
+  // Prewarms and trims in the background, declared last so it stops first
+  std::jthread maintenance_;
+};
+
+template <typename T, typename AcquirePolicy, typename ReleasePolicy,
+          typename StatsPolicy>
+  requires AcquireHook<AcquirePolicy, T> && ReleaseHook<ReleasePolicy, T>
+class ObjectPool<T, AcquirePolicy, ReleasePolicy, StatsPolicy>::TakeAwaiter {
+ public:
+  explicit TakeAwaiter(ObjectPool& pool) noexcept : pool_(&pool) {}
+
+  [[nodiscard]] bool await_ready() {
+    value_ = pool_->try_take();
+    return value_.has_value();
+  }
+
+  bool await_suspend(std::coroutine_handle<> handle) {
+    std::unique_lock<std::mutex> lock = pool_->lock_pool();
+
+    // Resumed by whichever add() supplies the object, possibly right away
+    callback_type resume = [this, handle](value_type obj) {
+      value_.emplace(std::move(obj));
+      handle.resume();
+    };
+
+    value_ = pool_->take_or_enqueue(lock, resume);
+    if (!value_.has_value()) {
+      return true;  // Queued, *this may already be gone once unlocked
+    }
+
+    pool_->stats_.on_hit(1);
+    lock.unlock();
+    AcquirePolicy::on_acquire(*value_);
+    return false;  // Got one after all, don't suspend
+  }
+
+  [[nodiscard]] value_type await_resume() { return std::move(*value_); }
+
+ private:
+  ObjectPool* pool_;
+  std::optional<value_type> value_;
 };
 
 /**
@@ -251,18 +705,38 @@ class ObjectPool {
  * destruction unless explicitly released; guarantees exception safety and
  * prevents leaks.
  *
+ * Pools whose take() returns a pointer (such as SlotPool) are leased by
+ * pointer; otherwise the object itself is held by the lease.
+ *
  * @tparam Pool The ObjectPool providing value_type, take(), and add() methods.
  */
 template <typename Pool>
 class PoolLease {
   using value_type = typename Pool::value_type;
 
+  // What the pool hands out: the object itself, or a pointer to it
+  using handle_type = decltype(std::declval<Pool&>().take());
+  static constexpr bool kByPointer = std::is_pointer_v<handle_type>;
+
+  // Lease durations are only measured for pools with statistics enabled
+  static constexpr bool kTimed = requires {
+    requires Pool::stats_type::kEnabled;
+  };
+  struct Untimed {};
+  using start_type =
+      std::conditional_t<kTimed, std::chrono::steady_clock::time_point,
+                         Untimed>;
+
  public:
   /**
    * @brief Creates a PoolLease and acquires an object from the given pool.
    * @param p Reference to the Pool to lease from.
    */
-  PoolLease(Pool& p) : pool_(&p), obj_(p.take()) {}
+  PoolLease(Pool& p) : pool_(&p), obj_(p.take()) {
+    if constexpr (kTimed) {
+      start_ = std::chrono::steady_clock::now();
+    }
+  }
 
   /**
    * @brief Move constructor for PoolLease.
@@ -271,7 +745,10 @@ class PoolLease {
    * @param o The PoolLease instance to move from.
    */
   PoolLease(PoolLease&& o) noexcept
-      : pool_(o.pool_), obj_(std::move(o.obj_)), active_(o.active_) {
+      : pool_(o.pool_),
+        obj_(std::move(o.obj_)),
+        active_(o.active_),
+        start_(o.start_) {
     o.active_ = false;
   }
 
@@ -283,6 +760,9 @@ class PoolLease {
    */
   ~PoolLease() {
     if (active_) {
+      if constexpr (kTimed) {
+        pool_->stats().on_lease(std::chrono::steady_clock::now() - start_);
+      }
       pool_->add(std::move(obj_));
     }
   }
@@ -291,25 +771,27 @@ class PoolLease {
    * @brief Returns a reference to the internal object.
    * @return Reference to the stored object.
    */
-  [[nodiscard]] auto& get() noexcept { return obj_; }
+  [[nodiscard]] value_type& get() noexcept { return object(); }
 
   /**
    * @brief Provides pointer-like access to the underlying object.
    * @return A pointer to the managed object.
    */
-  [[nodiscard]] value_type* operator->() noexcept { return &obj_; }
+  [[nodiscard]] value_type* operator->() noexcept { return &object(); }
 
   /**
    * @brief Returns a constant reference to the managed object.
    * @return const reference to the object stored in the pool.
    */
-  [[nodiscard]] const auto& get() const noexcept { return obj_; }
+  [[nodiscard]] const value_type& get() const noexcept { return object(); }
 
   /**
    * @brief Provides pointer-like access to the underlying object.
    * @return A constant pointer to the managed object.
    */
-  [[nodiscard]] const value_type* operator->() const noexcept { return &obj_; }
+  [[nodiscard]] const value_type* operator->() const noexcept {
+    return &object();
+  }
 
   /**
    * @brief Releases ownership of the managed object.
@@ -317,20 +799,152 @@ class PoolLease {
    * Marks the object inactive and returns it, transferring ownership;
    * it is no longer considered active.
    *
-   * @return value_type The managed object, moved out of this instance.
+   * @return The managed object moved out of this instance, or the pointer to
+   * it for pointer-based pools.
    * @note This function is noexcept and guarantees not to throw exceptions.
    */
-  [[nodiscard]] value_type release() noexcept {
+  [[nodiscard]] handle_type release() noexcept {
     active_ = false;
     return std::move(obj_);
   }
 
  private:
+  [[nodiscard]] value_type& object() noexcept {
+    if constexpr (kByPointer) {
+      return *obj_;
+    } else {
+      return obj_;
+    }
+  }
+
+  [[nodiscard]] const value_type& object() const noexcept {
+    if constexpr (kByPointer) {
+      return *obj_;
+    } else {
+      return obj_;
+    }
+  }
+
   // Pointer to the pool from which the object was leased
   Pool* pool_;
 
-  // The object being managed by this lease
-  value_type obj_;
+  // The object (or pointer to it) being managed by this lease
+  handle_type obj_;
+
+  // Indicates whether the lease is still active
+  bool active_ = true;
+
+  // When the object was leased, if the pool keeps statistics
+  [[no_unique_address]] start_type start_{};
+};
+
+/**
+ * @brief RAII wrapper for leasing several ObjectPool objects at once.
+ *
+ * PoolBatchLease takes a batch of objects with one take_n() call on creation
+ * and returns them with one add_n() call on destruction, unless explicitly
+ * released.
+ *
+ * @tparam Pool The pool providing value_type, take_n(), and add_n() methods.
+ */
+template <typename Pool>
+class PoolBatchLease {
+  using value_type = typename Pool::value_type;
+  using size_type = typename Pool::size_type;
+
+ public:
+  /**
+   * @brief Creates a PoolBatchLease and acquires `count` objects.
+   * @param p Reference to the Pool to lease from.
+   * @param count The number of objects to lease.
+   * @throws std::runtime_error If the pool holds fewer than `count` objects.
+   */
+  PoolBatchLease(Pool& p, size_type count)
+      : pool_(&p), objs_(p.take_n(count)) {}
+
+  /**
+   * @brief Move constructor for PoolBatchLease.
+   * Transfers ownership and deactivates the source to prevent double release.
+   *
+   * @param o The PoolBatchLease instance to move from.
+   */
+  PoolBatchLease(PoolBatchLease&& o) noexcept
+      : pool_(o.pool_), objs_(std::move(o.objs_)), active_(o.active_) {
+    o.active_ = false;
+  }
+
+  PoolBatchLease(const PoolBatchLease&) = delete;
+  PoolBatchLease& operator=(const PoolBatchLease&) = delete;
+
+  /**
+   * @brief Destructor for the PoolBatchLease class.
+   */
+  ~PoolBatchLease() {
+    if (active_) {
+      pool_->add_n(objs_);
+    }
+  }
+
+  /**
+   * @brief Returns the leased objects.
+   * @return A span over every leased object.
+   */
+  [[nodiscard]] std::span<value_type> objects() noexcept { return objs_; }
+
+  /**
+   * @brief Returns the leased objects.
+   * @return A constant span over every leased object.
+   */
+  [[nodiscard]] std::span<const value_type> objects() const noexcept {
+    return objs_;
+  }
+
+  /**
+   * @brief Returns the number of leased objects.
+   * @return The batch size.
+   */
+  [[nodiscard]] size_type size() const noexcept { return objs_.size(); }
+
+  /**
+   * @brief Accesses one leased object by index, without bounds checking.
+   * @param i Index below size().
+   * @return Reference to the object.
+   */
+  [[nodiscard]] value_type& operator[](size_type i) noexcept {
+    return objs_[i];
+  }
+
+  /**
+   * @brief Accesses one leased object by index, without bounds checking.
+   * @param i Index below size().
+   * @return Constant reference to the object.
+   */
+  [[nodiscard]] const value_type& operator[](size_type i) const noexcept {
+    return objs_[i];
+  }
+
+  [[nodiscard]] auto begin() noexcept { return objs_.begin(); }
+  [[nodiscard]] auto end() noexcept { return objs_.end(); }
+  [[nodiscard]] auto begin() const noexcept { return objs_.begin(); }
+  [[nodiscard]] auto end() const noexcept { return objs_.end(); }
+
+  /**
+   * @brief Releases ownership of the managed objects.
+   *
+   * @return std::vector<value_type> The objects, moved out of this instance.
+   * @note This function is noexcept and guarantees not to throw exceptions.
+   */
+  [[nodiscard]] std::vector<value_type> release() noexcept {
+    active_ = false;
+    return std::move(objs_);
+  }
+
+ private:
+  // Pointer to the pool from which the objects were leased
+  Pool* pool_;
+
+  // The objects being managed by this lease
+  std::vector<value_type> objs_;
 
   // Indicates whether the lease is still active
   bool active_ = true;
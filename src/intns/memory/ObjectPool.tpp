@@ -2,11 +2,14 @@
 
 namespace intns::memory {
 
-template <typename T, typename A, typename R>
+template <typename T, typename A, typename R, typename S>
   requires AcquireHook<A, T> && ReleaseHook<R, T>
-ObjectPool<T, A, R>::ObjectPool(size_type init_size,
-                                std::optional<size_type> limit)
+ObjectPool<T, A, R, S>::ObjectPool(size_type init_size,
+                                   std::optional<size_type> limit)
     : objects_(), size_limit_(limit) {
+  static_assert(std::is_default_constructible_v<T>,
+                "T must be default constructible");
+
   if (limit.has_value() && init_size > limit.value()) [[unlikely]] {
     throw std::runtime_error(
         "ObjectPool::ObjectPool: initial size is > size limit.");
@@ -22,47 +25,91 @@ ObjectPool<T, A, R>::ObjectPool(size_type init_size,
     objects_.emplace_back(value_type());
     R::on_release(objects_.back());  // No exception can be thrown here
   }
+
+  created_ = init_size;
+  low_water_ = init_size;
+  stats_.on_created(init_size, init_size);
 }
 
-template <typename T, typename A, typename R>
+template <typename T, typename A, typename R, typename S>
   requires AcquireHook<A, T> && ReleaseHook<R, T>
-typename ObjectPool<T, A, R>::value_type ObjectPool<T, A, R>::take() {
-  std::scoped_lock<std::mutex> lock(mutex_);
-  if (objects_.empty()) [[unlikely]] {
+ObjectPool<T, A, R, S>::ObjectPool(factory_type factory, PoolGrowth growth,
+                                   std::optional<size_type> limit)
+    : size_limit_(limit), factory_(std::move(factory)), growth_(growth) {
+  if (!factory_) [[unlikely]] {
+    throw std::invalid_argument("ObjectPool::ObjectPool: factory is empty.");
+  }
+
+  if (growth_.chunk_size == 0) [[unlikely]] {
+    throw std::invalid_argument("ObjectPool::ObjectPool: chunk size is zero.");
+  }
+
+  if (limit.has_value() && limit.value() == 0) {
+    size_limit_ = std::nullopt;  // 0 can also mean "unlimited"
+  }
+
+  if (size_limit_.has_value() && growth_.prewarm > size_limit_.value())
+      [[unlikely]] {
+    throw std::runtime_error(
+        "ObjectPool::ObjectPool: prewarm size is > size limit.");
+  }
+
+  if (growth_.prewarm > 0 && !growth_.prewarm_in_background) {
+    std::unique_lock<std::mutex> lock = lock_pool();
+    (void)ensure_pooled<true>(lock, growth_.prewarm);
+  }
+
+  // Only pay for a thread if there is background work to do
+  const bool background_prewarm =
+      growth_.prewarm > 0 && growth_.prewarm_in_background;
+  if (background_prewarm || growth_.idle_period.count() > 0) {
+    maintenance_ =
+        std::jthread([this](std::stop_token stop) { maintain(stop); });
+  }
+}
+
+template <typename T, typename A, typename R, typename S>
+  requires AcquireHook<A, T> && ReleaseHook<R, T>
+typename ObjectPool<T, A, R, S>::value_type ObjectPool<T, A, R, S>::take() {
+  std::unique_lock<std::mutex> lock = lock_pool();
+  if (!ensure_pooled<true>(lock, 1)) [[unlikely]] {
+    stats_.on_miss();
     throw std::runtime_error("ObjectPool::take: queue is empty.");
   }
 
   // Move the last object from the queue
   // and notify the acquire policy
-  value_type value = std::move(objects_.back());
-  objects_.pop_back();
+  value_type value = pop_back_object();
+  stats_.on_hit(1);
   A::on_acquire(value);  // No exception can be thrown here
   return value;
 }
 
-template <typename T, typename A, typename R>
+template <typename T, typename A, typename R, typename S>
   requires AcquireHook<A, T> && ReleaseHook<R, T>
-std::optional<typename ObjectPool<T, A, R>::value_type>
-ObjectPool<T, A, R>::try_take() {
-  std::scoped_lock<std::mutex> lock(mutex_);
-  if (objects_.empty()) {
+std::optional<typename ObjectPool<T, A, R, S>::value_type>
+ObjectPool<T, A, R, S>::try_take() {
+  std::unique_lock<std::mutex> lock = lock_pool();
+  if (!ensure_pooled<false>(lock, 1)) {
+    stats_.on_miss();
     return std::nullopt;
   }
 
   // Move the last object from the queue
   // and notify the acquire policy
-  value_type value = std::move(objects_.back());
-  objects_.pop_back();
+  value_type value = pop_back_object();
+  stats_.on_hit(1);
   A::on_acquire(value);
   return value;
 }
 
-template <typename T, typename A, typename R>
+template <typename T, typename A, typename R, typename S>
   requires AcquireHook<A, T> && ReleaseHook<R, T>
-void ObjectPool<T, A, R>::add(value_type&& back) {
-  std::scoped_lock<std::mutex> lock(mutex_);
+void ObjectPool<T, A, R, S>::add(value_type&& back) {
+  std::unique_lock<std::mutex> lock = lock_pool();
 
   if (size_limit_.has_value() && objects_.size() >= size_limit_.value()) {
+    stats_.on_add_rejected();
     throw std::runtime_error(
         "ObjectPool::add: unable to add as size limit reached.");
   }
@@ -71,14 +118,17 @@ void ObjectPool<T, A, R>::add(value_type&& back) {
   // adding the object to the pool
   R::on_release(back);
   objects_.push_back(std::move(back));
+  stats_.on_add(1, objects_.size());
+  hand_off(lock);
 }
 
-template <typename T, typename A, typename R>
+template <typename T, typename A, typename R, typename S>
   requires AcquireHook<A, T> && ReleaseHook<R, T>
-bool ObjectPool<T, A, R>::try_add(value_type&& back) {
-  std::scoped_lock<std::mutex> lock(mutex_);
+bool ObjectPool<T, A, R, S>::try_add(value_type&& back) {
+  std::unique_lock<std::mutex> lock = lock_pool();
 
   if (size_limit_.has_value() && objects_.size() >= size_limit_.value()) {
+    stats_.on_add_rejected();
     return false;
   }
 
@@ -87,16 +137,268 @@ bool ObjectPool<T, A, R>::try_add(value_type&& back) {
   try {
     R::on_release(back);
     objects_.push_back(std::move(back));
-    return true;
   } catch (...) {
     return false;
   }
+
+  stats_.on_add(1, objects_.size());
+  hand_off(lock);
+  return true;
+}
+
+template <typename T, typename A, typename R, typename S>
+  requires AcquireHook<A, T> && ReleaseHook<R, T>
+void ObjectPool<T, A, R, S>::take_n(std::span<value_type> out) {
+  {
+    std::unique_lock<std::mutex> lock = lock_pool();
+    if (!ensure_pooled<true>(lock, out.size())) [[unlikely]] {
+      stats_.on_miss();
+      throw std::runtime_error("ObjectPool::take_n: not enough objects.");
+    }
+
+    // Move the last objects from the queue, in the same order take() would
+    const auto first = objects_.end() - out.size();
+    std::move(std::make_reverse_iterator(objects_.end()),
+              std::make_reverse_iterator(first), out.begin());
+    objects_.erase(first, objects_.end());
+    low_water_ = std::min(low_water_, objects_.size());
+    stats_.on_hit(out.size());
+  }
+
+  // The objects are exclusively ours now, notify outside the lock
+  notify_acquire(out);
+}
+
+template <typename T, typename A, typename R, typename S>
+  requires AcquireHook<A, T> && ReleaseHook<R, T>
+std::vector<typename ObjectPool<T, A, R, S>::value_type>
+ObjectPool<T, A, R, S>::take_n(size_type count) {
+  std::vector<value_type> out;
+  {
+    std::unique_lock<std::mutex> lock = lock_pool();
+    if (!ensure_pooled<true>(lock, count)) [[unlikely]] {
+      stats_.on_miss();
+      throw std::runtime_error("ObjectPool::take_n: not enough objects.");
+    }
+
+    out = pop_back_n(count);
+    stats_.on_hit(count);
+  }
+
+  notify_acquire(out);
+  return out;
+}
+
+template <typename T, typename A, typename R, typename S>
+  requires AcquireHook<A, T> && ReleaseHook<R, T>
+std::vector<typename ObjectPool<T, A, R, S>::value_type>
+ObjectPool<T, A, R, S>::try_take_n(size_type count) {
+  std::vector<value_type> out;
+  {
+    std::unique_lock<std::mutex> lock = lock_pool();
+    (void)ensure_pooled<false>(lock, count);  // Short pools hand out the rest
+    out = pop_back_n(std::min(count, objects_.size()));
+    stats_.on_hit(out.size());
+    if (out.size() < count) {
+      stats_.on_miss();
+    }
+  }
+
+  notify_acquire(out);
+  return out;
+}
+
+template <typename T, typename A, typename R, typename S>
+  requires AcquireHook<A, T> && ReleaseHook<R, T>
+std::vector<typename ObjectPool<T, A, R, S>::value_type>
+ObjectPool<T, A, R, S>::pop_back_n(size_type count) {
+  std::vector<value_type> out;
+  out.reserve(count);  // May throw, leaving the queue untouched
+
+  const auto first = objects_.end() - count;
+  std::move(std::make_reverse_iterator(objects_.end()),
+            std::make_reverse_iterator(first), std::back_inserter(out));
+  objects_.erase(first, objects_.end());
+  low_water_ = std::min(low_water_, objects_.size());
+  return out;
 }
 
-template <typename T, typename AcquirePolicy, typename ReleasePolicy>
+template <typename T, typename A, typename R, typename S>
+  requires AcquireHook<A, T> && ReleaseHook<R, T>
+template <bool ThrowOnError, typename Range>
+bool ObjectPool<T, A, R, S>::add_n_impl(Range&& objects) {
+  const auto count = static_cast<size_type>(std::ranges::size(objects));
+
+  std::unique_lock<std::mutex> lock = lock_pool();
+
+  if (size_limit_.has_value() &&
+      objects_.size() + count > size_limit_.value()) {
+    stats_.on_add_rejected();
+    if constexpr (ThrowOnError) {
+      throw std::runtime_error(
+          "ObjectPool::add_n: unable to add as size limit reached.");
+    } else {
+      return false;
+    }
+  }
+
+  // Notify the release policy before
+  // adding the objects to the pool
+  if constexpr (ReleaseBatchHook<R, T> &&
+                std::ranges::contiguous_range<Range>) {
+    R::on_release_batch(std::span<value_type>(objects));
+  } else {
+    for (value_type& obj : objects) R::on_release(obj);
+  }
+
+  const size_type current_size = objects_.size();
+  try {
+    for (value_type& obj : objects) {
+      objects_.push_back(std::move(obj));
+    }
+  } catch (...) {
+    // Rollback on error, moving the objects back out
+    auto it = std::ranges::begin(objects);
+    for (size_type i = current_size; i < objects_.size(); ++i, ++it) {
+      *it = std::move(objects_[i]);
+    }
+    objects_.erase(objects_.begin() + current_size, objects_.end());
+
+    if constexpr (ThrowOnError) {
+      throw;  // Propagate the exception
+    } else {
+      return false;  // Indicate failure
+    }
+  }
+
+  stats_.on_add(count, objects_.size());
+  hand_off(lock);
+  return true;
+}
+
+template <typename T, typename A, typename R, typename S>
+  requires AcquireHook<A, T> && ReleaseHook<R, T>
+template <typename Clock, typename Duration>
+typename ObjectPool<T, A, R, S>::value_type ObjectPool<T, A, R, S>::take_until(
+    const std::chrono::time_point<Clock, Duration>& deadline) {
+  std::optional<value_type> value = try_take_until(deadline);
+  if (!value.has_value()) [[unlikely]] {
+    throw std::runtime_error(
+        "ObjectPool::take_until: timed out waiting for an object.");
+  }
+
+  return std::move(*value);
+}
+
+template <typename T, typename A, typename R, typename S>
+  requires AcquireHook<A, T> && ReleaseHook<R, T>
+template <typename Clock, typename Duration>
+std::optional<typename ObjectPool<T, A, R, S>::value_type>
+ObjectPool<T, A, R, S>::try_take_until(
+    const std::chrono::time_point<Clock, Duration>& deadline) {
+  std::unique_lock<std::mutex> lock = lock_pool();
+  (void)ensure_pooled<false>(lock, 1);
+
+  // Park until add() supplies an object or the deadline passes
+  bool ready = !objects_.empty();
+  if (!ready) {
+    INTNS_TRACE_ZONE("ObjectPool::take_wait");
+    ++blocked_;
+    ready = available_.wait_until(lock, deadline,
+                                  [this] { return !objects_.empty(); });
+    --blocked_;
+  }
+
+  if (!ready) {
+    stats_.on_miss();
+    return std::nullopt;
+  }
+
+  // Move the last object from the queue
+  // and notify the acquire policy
+  value_type value = pop_back_object();
+  stats_.on_hit(1);
+  A::on_acquire(value);
+  return value;
+}
+
+template <typename T, typename A, typename R, typename S>
+  requires AcquireHook<A, T> && ReleaseHook<R, T>
+void ObjectPool<T, A, R, S>::async_take(callback_type callback) {
+  std::unique_lock<std::mutex> lock = lock_pool();
+  std::optional<value_type> value = take_or_enqueue(lock, callback);
+  if (value.has_value()) {
+    stats_.on_hit(1);
+  } else {
+    stats_.on_miss();
+  }
+  lock.unlock();
+
+  // Queued callbacks are run later by hand_off()
+  if (value.has_value()) {
+    A::on_acquire(*value);
+    callback(std::move(*value));
+  }
+}
+
+template <typename T, typename A, typename R, typename S>
+  requires AcquireHook<A, T> && ReleaseHook<R, T>
+std::optional<typename ObjectPool<T, A, R, S>::value_type>
+ObjectPool<T, A, R, S>::take_or_enqueue(std::unique_lock<std::mutex>& lock,
+                                        callback_type& callback) {
+  if (!ensure_pooled<false>(lock, 1)) {
+    waiters_.push_back(std::move(callback));
+    return std::nullopt;
+  }
+
+  return pop_back_object();
+}
+
+template <typename T, typename A, typename R, typename S>
+  requires AcquireHook<A, T> && ReleaseHook<R, T>
+void ObjectPool<T, A, R, S>::hand_off(std::unique_lock<std::mutex>& lock) {
+  // Queued async callers first, each callback runs outside the lock. A
+  // throwing callback must not strand the others, so the first exception is
+  // kept and rethrown once everyone has been served
+  std::exception_ptr error;
+  while (!waiters_.empty() && !objects_.empty()) {
+    callback_type waiter = std::move(waiters_.front());
+    waiters_.pop_front();
+    value_type value = pop_back_object();
+    stats_.on_hit(1);
+
+    lock.unlock();
+    try {
+      A::on_acquire(value);
+      waiter(std::move(value));
+    } catch (...) {
+      if (!error) {
+        error = std::current_exception();
+      }
+    }
+    lock.lock();
+  }
+
+  // Then wake as many blocked threads as there are objects left
+  const size_type wake = std::min(blocked_, objects_.size());
+  lock.unlock();
+
+  if (wake == 1) {
+    available_.notify_one();
+  } else if (wake > 1) {
+    available_.notify_all();
+  }
+
+  if (error) {
+    std::rethrow_exception(error);
+  }
+}
+
+template <typename T, typename AcquirePolicy, typename ReleasePolicy,
+          typename StatsPolicy>
   requires AcquireHook<AcquirePolicy, T> && ReleaseHook<ReleasePolicy, T>
 template <bool ThrowOnError>
-bool ObjectPool<T, AcquirePolicy, ReleasePolicy>::reserve_impl(
+bool ObjectPool<T, AcquirePolicy, ReleasePolicy, StatsPolicy>::reserve_impl(
     size_type target_size) {
   if (target_size == 0) [[unlikely]] {
     if constexpr (ThrowOnError) {
@@ -106,7 +408,7 @@ bool ObjectPool<T, AcquirePolicy, ReleasePolicy>::reserve_impl(
     }
   }
 
-  std::scoped_lock<std::mutex> lock(mutex_);
+  std::unique_lock<std::mutex> lock = lock_pool();
   const size_type current_size = objects_.size();
 
   if (current_size >= target_size) {
@@ -124,16 +426,16 @@ bool ObjectPool<T, AcquirePolicy, ReleasePolicy>::reserve_impl(
   }
 
   const size_type to_create = target_size - current_size;
-  objects_.reserve(target_size);
 
   // Batch create objects
   try {
     for (size_type i = 0; i < to_create; ++i) {
-      objects_.emplace_back();
+      objects_.push_back(make_object());
       ReleasePolicy::on_release(objects_.back());
     }
   } catch (...) {
-    objects_.resize(current_size);  // Rollback on error
+    // Rollback on error
+    objects_.erase(objects_.begin() + current_size, objects_.end());
 
     if constexpr (ThrowOnError) {
       throw;  // Propagate the exception
@@ -142,7 +444,161 @@ bool ObjectPool<T, AcquirePolicy, ReleasePolicy>::reserve_impl(
     }
   }
 
+  created_ += to_create;
+  stats_.on_created(to_create, objects_.size());
+  hand_off(lock);
   return true;
 }
 
-}  // namespace intns::memory
\ No newline at end of file
+template <typename T, typename A, typename R, typename S>
+  requires AcquireHook<A, T> && ReleaseHook<R, T>
+typename ObjectPool<T, A, R, S>::value_type
+ObjectPool<T, A, R, S>::make_object() {
+  if (factory_) {
+    return factory_();
+  }
+
+  if constexpr (std::is_default_constructible_v<T>) {
+    return value_type();
+  } else {
+    throw std::runtime_error(
+        "ObjectPool::reserve: no factory to construct objects with.");
+  }
+}
+
+template <typename T, typename A, typename R, typename S>
+  requires AcquireHook<A, T> && ReleaseHook<R, T>
+template <bool ThrowOnError>
+bool ObjectPool<T, A, R, S>::grow(std::unique_lock<std::mutex>& lock,
+                                  size_type count) {
+  if (!factory_) {
+    return false;
+  }
+
+  // Round up to whole chunks, then clamp to what the limit still allows
+  const size_type chunk = growth_.chunk_size;
+  size_type to_create = (count + chunk - 1) / chunk * chunk;
+  if (size_limit_.has_value()) {
+    const size_type limit = size_limit_.value();
+    const size_type room_created = created_ < limit ? limit - created_ : 0;
+    const size_type room_pooled =
+        objects_.size() < limit ? limit - objects_.size() : 0;
+    to_create = std::min({to_create, room_created, room_pooled});
+  }
+
+  if (to_create == 0) {
+    return false;
+  }
+
+  // Claim the quota, so concurrent growers don't overshoot the limit
+  created_ += to_create;
+  lock.unlock();
+
+  std::vector<value_type> fresh;
+  try {
+    fresh.reserve(to_create);
+    for (size_type i = 0; i < to_create; ++i) {
+      fresh.push_back(factory_());
+      R::on_release(fresh.back());
+    }
+  } catch (...) {
+    lock.lock();
+    created_ -= to_create;
+
+    if constexpr (ThrowOnError) {
+      throw;  // Propagate the exception
+    } else {
+      return false;  // Indicate failure
+    }
+  }
+
+  lock.lock();
+
+  // add() or set_size_limit() may have run while we were constructing,
+  // so only keep what still fits and give back the quota for the rest
+  size_type keep = fresh.size();
+  if (size_limit_.has_value()) {
+    const size_type limit = size_limit_.value();
+    keep = std::min(keep, objects_.size() < limit ? limit - objects_.size()
+                                                  : size_type{0});
+  }
+
+  created_ -= fresh.size() - keep;
+  for (size_type i = 0; i < keep; ++i) {
+    objects_.push_back(std::move(fresh[i]));
+  }
+  stats_.on_created(keep, objects_.size());
+
+  // Serve whoever queued up meanwhile, then drop the surplus unlocked
+  hand_off(lock);
+  fresh.clear();
+  lock.lock();
+  return keep > 0;
+}
+
+template <typename T, typename A, typename R, typename S>
+  requires AcquireHook<A, T> && ReleaseHook<R, T>
+typename ObjectPool<T, A, R, S>::size_type ObjectPool<T, A, R, S>::trim_idle() {
+  std::deque<value_type> doomed;  // Destroyed after the lock is released
+  {
+    const auto lock = lock_pool();
+
+    // Objects below the low-water mark weren't taken since the last trim,
+    // and since the pool is LIFO they sit at the front of the queue
+    const size_type keep = growth_.min_idle;
+    const size_type idle = std::min(low_water_, objects_.size());
+    const size_type count = idle > keep ? idle - keep : 0;
+
+    const auto last = objects_.begin() + count;
+    std::move(objects_.begin(), last, std::back_inserter(doomed));
+    objects_.erase(objects_.begin(), last);
+
+    created_ -= std::min(created_, count);
+    low_water_ = objects_.size();
+    stats_.on_trimmed(count);
+  }
+
+  return doomed.size();
+}
+
+template <typename T, typename A, typename R, typename S>
+  requires AcquireHook<A, T> && ReleaseHook<R, T>
+void ObjectPool<T, A, R, S>::maintain(std::stop_token stop) {
+  if (growth_.prewarm > 0 && growth_.prewarm_in_background) {
+    std::unique_lock<std::mutex> lock = lock_pool();
+    while (!stop.stop_requested() && created_ < growth_.prewarm) {
+      const size_type missing = growth_.prewarm - created_;
+      if (!grow<false>(lock, std::min(missing, growth_.chunk_size))) {
+        break;
+      }
+    }
+
+    hand_off(lock);
+  }
+
+  if (growth_.idle_period.count() <= 0) {
+    return;
+  }
+
+  // Start the first period from a clean low-water mark
+  {
+    const auto lock = lock_pool();
+    low_water_ = objects_.size();
+  }
+
+  while (!stop.stop_requested()) {
+    {
+      std::unique_lock<std::mutex> lock = lock_pool();
+      maintenance_cv_.wait_for(lock, stop, growth_.idle_period,
+                               [] { return false; });
+    }
+
+    if (stop.stop_requested()) {
+      break;
+    }
+
+    (void)trim_idle();
+  }
+}
+
+}  // namespace intns::memory
@@ -0,0 +1,315 @@
+#include "PageMemory.hpp"
+
+#include <stdexcept>
+
+#include "Alignment.hpp"
+
+#if defined(_WIN32)
+#ifndef NOMINMAX
+#define NOMINMAX
+#endif
+#ifndef WIN32_LEAN_AND_MEAN
+#define WIN32_LEAN_AND_MEAN
+#endif
+#include <windows.h>
+#else
+#include <sys/mman.h>
+#include <unistd.h>
+
+#include <fstream>
+#if defined(__linux__)
+#include <sys/syscall.h>
+#endif
+#endif
+
+namespace intns::memory {
+
+namespace {
+
+using size_type = PageMemory::size_type;
+
+// Rounds `size` up to a multiple of `granularity`, a power of two
+size_type round_up(size_type size, size_type granularity) noexcept {
+  return static_cast<size_type>(align_address(size, granularity));
+}
+
+// Writes to one byte per page, so every page is backed before first use
+void touch_pages(void* data, size_type size) noexcept {
+  const size_type page = PageMemory::page_size();
+  auto* bytes = static_cast<volatile unsigned char*>(data);
+  for (size_type offset = 0; offset < size; offset += page) {
+    bytes[offset] = 0;
+  }
+}
+
+#if defined(_WIN32)
+
+void* virtual_alloc(size_type size, DWORD type,
+                    const std::optional<int>& node) noexcept {
+  if (node.has_value()) {
+    return VirtualAllocExNuma(GetCurrentProcess(), nullptr, size, type,
+                              PAGE_READWRITE, static_cast<DWORD>(*node));
+  }
+  return VirtualAlloc(nullptr, size, type, PAGE_READWRITE);
+}
+
+#else
+
+int to_madvise(PageAdvice advice) noexcept {
+  switch (advice) {
+    case PageAdvice::kSequential:
+      return MADV_SEQUENTIAL;
+    case PageAdvice::kRandom:
+      return MADV_RANDOM;
+    case PageAdvice::kWillNeed:
+      return MADV_WILLNEED;
+    case PageAdvice::kDontNeed:
+      return MADV_DONTNEED;
+    case PageAdvice::kNormal:
+    default:
+      return MADV_NORMAL;
+  }
+}
+
+void* anonymous_map(size_type size, int extra_flags) noexcept {
+  void* data = mmap(nullptr, size, PROT_READ | PROT_WRITE,
+                    MAP_PRIVATE | MAP_ANONYMOUS | extra_flags, -1, 0);
+  return data == MAP_FAILED ? nullptr : data;
+}
+
+// Maps `size` bytes starting on a huge page boundary, so the kernel can back
+// the range with transparent huge pages
+void* huge_aligned_map(size_type size, size_type huge) noexcept {
+  const size_type page = PageMemory::page_size();
+  const size_type padded = size + huge - page;
+  auto* raw = static_cast<unsigned char*>(anonymous_map(padded, 0));
+  if (!raw) {
+    return nullptr;
+  }
+
+  // Trim the unaligned head and the tail
+  auto* start = reinterpret_cast<unsigned char*>(
+      align_address(reinterpret_cast<std::uintptr_t>(raw), huge));
+  const size_type head = static_cast<size_type>(start - raw);
+  if (head != 0) {
+    munmap(raw, head);
+  }
+  if (padded - head > size) {
+    munmap(start + size, padded - head - size);
+  }
+  return start;
+}
+
+void bind_to_node(void* data, size_type size, int node) noexcept {
+#if defined(__linux__) && defined(SYS_mbind)
+  if (node < 0) {
+    return;
+  }
+
+  // One bit per node, MPOL_BIND from <linux/mempolicy.h>
+  constexpr int kMpolBind = 2;
+  constexpr size_type kBits = sizeof(unsigned long) * 8;
+  unsigned long mask[16] = {};
+  if (static_cast<size_type>(node) >= kBits * 16) {
+    return;
+  }
+  mask[node / kBits] = 1UL << (node % kBits);
+  (void)syscall(SYS_mbind, data, size, kMpolBind, mask, kBits * 16 + 1, 0);
+#else
+  (void)data;
+  (void)size;
+  (void)node;
+#endif
+}
+
+#endif
+
+}  // namespace
+
+PageMemory PageMemory::map(size_type size, const PageOptions& options) {
+  if (size == 0) [[unlikely]] {
+    throw std::runtime_error("PageMemory::map: Cannot map 0 bytes.");
+  }
+
+  PageMemory pages = try_map(size, options);
+  if (!pages) [[unlikely]] {
+    throw std::runtime_error("PageMemory::map: Failed to map memory.");
+  }
+  return pages;
+}
+
+PageMemory PageMemory::try_map(size_type size,
+                               const PageOptions& options) noexcept {
+  if (size == 0) {
+    return {};
+  }
+
+  const size_type page = page_size();
+  const size_type huge = huge_page_size();
+  const bool want_huge = options.huge_pages != HugePages::kNone && huge != 0;
+
+  void* data = nullptr;
+  size_type mapped = 0;
+  bool got_huge = false;
+
+#if defined(_WIN32)
+  // Large pages are the only huge page mode on Windows
+  if (want_huge) {
+    mapped = round_up(size, huge);
+    data = virtual_alloc(mapped, MEM_RESERVE | MEM_COMMIT | MEM_LARGE_PAGES,
+                         options.numa_node);
+    got_huge = data != nullptr;
+  }
+
+  if (!data) {
+    if (want_huge && !options.huge_page_fallback) {
+      return {};
+    }
+
+    mapped = round_up(size, page);
+    data = virtual_alloc(mapped, MEM_RESERVE | MEM_COMMIT, options.numa_node);
+    if (!data) {
+      return {};
+    }
+  }
+
+  if (options.advice != PageAdvice::kNormal) {
+    (void)advise(data, mapped, options.advice);
+  }
+#else
+  if (want_huge && options.huge_pages == HugePages::kExplicit) {
+#if defined(MAP_HUGETLB)
+    mapped = round_up(size, huge);
+    data = anonymous_map(mapped, MAP_HUGETLB);
+    got_huge = data != nullptr;
+#endif
+    if (!data && !options.huge_page_fallback) {
+      return {};
+    }
+  }
+
+  if (!data && want_huge) {
+    // Transparent huge pages, or the fallback for explicit ones
+    mapped = round_up(size, huge);
+    data = huge_aligned_map(mapped, huge);
+#if defined(MADV_HUGEPAGE)
+    if (data) {
+      (void)madvise(data, mapped, MADV_HUGEPAGE);
+    }
+#endif
+  }
+
+  if (!data) {
+    mapped = round_up(size, page);
+    data = anonymous_map(mapped, 0);
+    if (!data) {
+      return {};
+    }
+  }
+
+  // Bind before anything touches the pages
+  if (options.numa_node.has_value()) {
+    bind_to_node(data, mapped, *options.numa_node);
+  }
+
+  if (options.advice != PageAdvice::kNormal) {
+    (void)advise(data, mapped, options.advice);
+  }
+#endif
+
+  if (options.prefault) {
+#if defined(MADV_POPULATE_WRITE)
+    if (madvise(data, mapped, MADV_POPULATE_WRITE) != 0) {
+      touch_pages(data, mapped);
+    }
+#else
+    touch_pages(data, mapped);
+#endif
+  }
+
+  return PageMemory(data, mapped, got_huge);
+}
+
+void PageMemory::unmap(void* data, size_type size) noexcept {
+  if (!data) {
+    return;
+  }
+
+#if defined(_WIN32)
+  (void)size;
+  VirtualFree(data, 0, MEM_RELEASE);
+#else
+  munmap(data, size);
+#endif
+}
+
+bool PageMemory::advise(const void* data, size_type size,
+                        PageAdvice advice) noexcept {
+  if (!data || size == 0) {
+    return false;
+  }
+
+  const size_type page = page_size();
+  const auto addr = reinterpret_cast<std::uintptr_t>(data);
+  std::uintptr_t start = addr & ~(page - 1);
+  size_type length = round_up(size + (addr - start), page);
+  if (advice == PageAdvice::kDontNeed) {
+    // Discarding is destructive, so only whole pages inside the range; the
+    // partial pages at either end may hold live data
+    start = round_up(addr, page);
+    const std::uintptr_t end = (addr + size) & ~(page - 1);
+    if (end <= start) {
+      return true;  // No whole page to discard
+    }
+    length = end - start;
+  }
+
+#if defined(_WIN32)
+#if defined(_WIN32_WINNT) && _WIN32_WINNT >= 0x0602
+  if (advice == PageAdvice::kWillNeed) {
+    WIN32_MEMORY_RANGE_ENTRY range{reinterpret_cast<void*>(start), length};
+    return PrefetchVirtualMemory(GetCurrentProcess(), 1, &range, 0) != 0;
+  }
+#endif
+  (void)length;
+  return advice == PageAdvice::kNormal;
+#else
+  return madvise(reinterpret_cast<void*>(start), length,
+                 to_madvise(advice)) == 0;
+#endif
+}
+
+PageMemory::size_type PageMemory::page_size() noexcept {
+  static const size_type size = [] {
+#if defined(_WIN32)
+    SYSTEM_INFO info;
+    GetSystemInfo(&info);
+    return static_cast<size_type>(info.dwPageSize);
+#else
+    const long size = sysconf(_SC_PAGESIZE);
+    return size > 0 ? static_cast<size_type>(size) : size_type{4096};
+#endif
+  }();
+  return size;
+}
+
+PageMemory::size_type PageMemory::huge_page_size() noexcept {
+  static const size_type size = []() -> size_type {
+#if defined(_WIN32)
+    return static_cast<size_type>(GetLargePageMinimum());
+#elif defined(__linux__)
+    // The PMD size is what both THP and the default hugetlb pool use
+    std::ifstream file("/sys/kernel/mm/transparent_hugepage/hpage_pmd_size");
+    size_type bytes = 0;
+    if (file >> bytes && is_power_of_two(bytes)) {
+      return bytes;
+    }
+    return size_type{2} * 1024 * 1024;
+#else
+    return 0;
+#endif
+  }();
+  return size;
+}
+
+}  // namespace intns::memory
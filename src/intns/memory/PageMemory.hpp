@@ -0,0 +1,226 @@
+#ifndef INTNS_MEMORY_PAGEMEMORY_HPP
+#define INTNS_MEMORY_PAGEMEMORY_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+
+namespace intns::memory {
+
+/**
+ * @brief Selects whether page-backed memory should use huge pages.
+ */
+enum class HugePages : uint8_t {
+  kNone = 0,     // Regular pages
+  kTransparent,  // Huge-page aligned and advised for transparent huge pages
+  kExplicit      // Reserved huge pages (MAP_HUGETLB / MEM_LARGE_PAGES)
+};
+
+/**
+ * @brief Access pattern hints passed on to the OS (madvise and equivalents).
+ */
+enum class PageAdvice : uint8_t {
+  kNormal = 0,  // No particular pattern
+  kSequential,  // Read ahead aggressively, drop pages behind
+  kRandom,      // Don't read ahead
+  kWillNeed,    // Start loading the range now
+  kDontNeed     // The range won't be needed soon; discards its contents
+};
+
+/**
+ * @brief How PageMemory should obtain its pages.
+ */
+struct PageOptions {
+  // Huge page mode
+  HugePages huge_pages = HugePages::kNone;
+
+  // Fall back to regular pages if explicit huge pages are unavailable,
+  // instead of failing
+  bool huge_page_fallback = true;
+
+  // Touch every page up front, so first use doesn't page fault; done after
+  // NUMA binding so pages land on the requested node
+  bool prefault = false;
+
+  // Bind the pages to this NUMA node; best effort, ignored where unsupported
+  std::optional<int> numa_node = std::nullopt;
+
+  // Access pattern hint for the whole mapping
+  PageAdvice advice = PageAdvice::kNormal;
+};
+
+/**
+ * @class PageMemory
+ * @brief An owned range of pages obtained directly from the OS.
+ *
+ * Backing memory for the allocators when plain malloc isn't good enough:
+ * mmap on POSIX systems and VirtualAlloc on Windows, with optional huge
+ * pages, NUMA binding, access hints and pre-faulting. The size is rounded up
+ * to whole pages, so size() may exceed the requested size.
+ *
+ * Move-only; the pages are unmapped on destruction.
+ *
+ * @section Platform Notes
+ * - Linux supports every option; NUMA binding uses mbind.
+ * - Other POSIX systems ignore explicit huge pages (falling back if allowed)
+ *   and NUMA binding.
+ * - Windows treats both huge page modes as large pages, which need the
+ *   SeLockMemoryPrivilege, and binds NUMA nodes with VirtualAllocExNuma.
+ */
+class PageMemory {
+ public:
+  using size_type = std::size_t;
+
+  /**
+   * @brief Creates an empty PageMemory owning nothing.
+   */
+  PageMemory() noexcept = default;
+
+  /**
+   * @brief Maps at least `size` bytes of pages.
+   *
+   * @param size Minimum number of bytes.
+   * @param options How to obtain the pages.
+   * @return The mapped pages.
+   * @throws std::runtime_error If `size` is zero or the mapping fails.
+   */
+  [[nodiscard]] static PageMemory map(size_type size,
+                                      const PageOptions& options = {});
+
+  /**
+   * @brief Maps at least `size` bytes of pages, without throwing exceptions.
+   *
+   * @param size Minimum number of bytes.
+   * @param options How to obtain the pages.
+   * @return The mapped pages, or an empty PageMemory on failure.
+   */
+  [[nodiscard]] static PageMemory try_map(
+      size_type size, const PageOptions& options = {}) noexcept;
+
+  /**
+   * @brief Unmaps pages detached with release().
+   * @param data The start of the pages.
+   * @param size The size() the pages had.
+   */
+  static void unmap(void* data, size_type size) noexcept;
+
+  /**
+   * @brief Passes an access pattern hint for a range of memory to the OS.
+   *
+   * Works on any memory, e.g. file mappings. For the non-destructive hints
+   * the range is widened to whole pages. kDontNeed discards the contents of
+   * the pages (private memory reads back as zeros), so it is applied only to
+   * the whole pages inside the range, and to none if it spans no whole page.
+   *
+   * @param data Start of the range.
+   * @param size Size of the range in bytes.
+   * @param advice The hint.
+   * @return true if the OS accepted the hint, or kDontNeed found no whole
+   * page to discard.
+   */
+  static bool advise(const void* data, size_type size,
+                     PageAdvice advice) noexcept;
+
+  /**
+   * @brief Returns the size of a regular page.
+   * @return The page size in bytes.
+   */
+  [[nodiscard]] static size_type page_size() noexcept;
+
+  /**
+   * @brief Returns the size of a huge page.
+   * @return The default huge page size in bytes, or 0 if unsupported.
+   */
+  [[nodiscard]] static size_type huge_page_size() noexcept;
+
+  ~PageMemory() { reset(); }
+
+  PageMemory(PageMemory&& other) noexcept
+      : data_(other.data_), size_(other.size_), huge_(other.huge_) {
+    other.data_ = nullptr;
+    other.size_ = 0;
+    other.huge_ = false;
+  }
+
+  PageMemory& operator=(PageMemory&& other) noexcept {
+    if (this != &other) {
+      reset();
+      data_ = other.data_;
+      size_ = other.size_;
+      huge_ = other.huge_;
+      other.data_ = nullptr;
+      other.size_ = 0;
+      other.huge_ = false;
+    }
+    return *this;
+  }
+
+  // Owns the pages
+  PageMemory(const PageMemory&) = delete;
+  PageMemory& operator=(const PageMemory&) = delete;
+
+  /**
+   * @brief Returns the start of the pages.
+   * @return The page-aligned start, or nullptr if empty.
+   */
+  [[nodiscard]] void* data() const noexcept { return data_; }
+
+  /**
+   * @brief Returns the size of the pages.
+   * @return The mapped size in bytes, a whole number of pages.
+   */
+  [[nodiscard]] size_type size() const noexcept { return size_; }
+
+  /**
+   * @brief Checks whether explicit huge pages were obtained.
+   * @return true if the pages are reserved huge pages.
+   */
+  [[nodiscard]] bool huge_pages() const noexcept { return huge_; }
+
+  /**
+   * @brief Checks whether any pages are owned.
+   * @return true if not empty.
+   */
+  explicit operator bool() const noexcept { return data_ != nullptr; }
+
+  /**
+   * @brief Gives up ownership of the pages; free them with unmap().
+   * @return The start of the pages.
+   */
+  [[nodiscard]] void* release() noexcept {
+    void* data = data_;
+    data_ = nullptr;
+    size_ = 0;
+    huge_ = false;
+    return data;
+  }
+
+  /**
+   * @brief Unmaps the pages, leaving this PageMemory empty.
+   */
+  void reset() noexcept {
+    if (data_) {
+      unmap(data_, size_);
+    }
+    data_ = nullptr;
+    size_ = 0;
+    huge_ = false;
+  }
+
+ private:
+  PageMemory(void* data, size_type size, bool huge) noexcept
+      : data_(data), size_(size), huge_(huge) {}
+
+  // Start of the pages
+  void* data_ = nullptr;
+
+  // Size of the pages in bytes
+  size_type size_ = 0;
+
+  // Whether the pages are explicit huge pages
+  bool huge_ = false;
+};
+
+}  // namespace intns::memory
+
+#endif
@@ -0,0 +1,61 @@
+#include "ScratchArena.hpp"
+
+#include <memory>
+#include <mutex>
+
+namespace intns::memory {
+
+namespace {
+
+// Settings for arenas created from now on
+std::mutex growth_mutex;
+ArenaGrowth growth_setting{.initial_block_size = 64 * 1024};
+
+// The calling thread's arena and its number of open frames
+thread_local std::unique_ptr<ArenaAllocator> local_arena;
+thread_local std::size_t local_depth = 0;
+
+}  // namespace
+
+void ScratchArena::set_default_growth(const ArenaGrowth& growth) {
+  std::scoped_lock<std::mutex> lock(growth_mutex);
+  growth_setting = growth;
+}
+
+ArenaGrowth ScratchArena::default_growth() {
+  std::scoped_lock<std::mutex> lock(growth_mutex);
+  return growth_setting;
+}
+
+ArenaAllocator& ScratchArena::local() {
+  if (!local_arena) [[unlikely]] {
+    local_arena = std::make_unique<ArenaAllocator>(default_growth());
+  }
+  return *local_arena;
+}
+
+bool ScratchArena::has_local() noexcept { return local_arena != nullptr; }
+
+std::size_t ScratchArena::frame_depth() noexcept { return local_depth; }
+
+bool ScratchArena::release_local() noexcept {
+  if (local_depth != 0) {
+    return false;
+  }
+
+  local_arena.reset();
+  return true;
+}
+
+void ScratchArena::enter_frame() noexcept { ++local_depth; }
+
+void ScratchArena::leave_frame() noexcept { --local_depth; }
+
+ScratchFrame::ScratchFrame()
+    : allocator_(ScratchArena::local()), checkpoint_(allocator_) {
+  ScratchArena::enter_frame();
+}
+
+ScratchFrame::~ScratchFrame() { ScratchArena::leave_frame(); }
+
+}  // namespace intns::memory
@@ -0,0 +1,162 @@
+#ifndef INTNS_MEMORY_SCRATCHARENA_HPP
+#define INTNS_MEMORY_SCRATCHARENA_HPP
+
+#include <cstddef>
+#include <utility>
+
+#include "ArenaAllocator.hpp"
+#include "StackAllocator.hpp"
+
+namespace intns::memory {
+
+/**
+ * @class ScratchArena
+ * @brief Per-thread scratch memory for short-lived, request-scoped data.
+ *
+ * Each thread gets its own ArenaAllocator, created on the thread's first use
+ * and destroyed when the thread exits. The arena is allocated and first
+ * touched by its owning thread, so on first-touch NUMA systems its memory
+ * lands on that thread's node. Released blocks are recycled, so once an arena
+ * has grown to a thread's working size, scratch allocations never touch the
+ * global heap.
+ *
+ * Use ScratchFrame to allocate; it restores the arena when it goes out of
+ * scope.
+ *
+ * @note All static methods are thread-safe; each only affects the calling
+ * thread's arena, except set_default_growth().
+ */
+class ScratchArena {
+ public:
+  ScratchArena() = delete;
+
+  /**
+   * @brief Sets the block sizing used by threads that create their arena
+   * after this call. Existing arenas are unaffected.
+   * @param growth Block sizing settings for new arenas.
+   */
+  static void set_default_growth(const ArenaGrowth& growth);
+
+  /**
+   * @brief Returns the block sizing used for new arenas.
+   * @return The current default settings (initial block of 64 KiB unless
+   * changed).
+   */
+  [[nodiscard]] static ArenaGrowth default_growth();
+
+  /**
+   * @brief Returns the calling thread's arena, creating it if needed.
+   * @return The thread's arena.
+   * @throws std::runtime_error If the arena could not be allocated.
+   */
+  [[nodiscard]] static ArenaAllocator& local();
+
+  /**
+   * @brief Checks whether the calling thread has created its arena yet.
+   * @return true if local() has been called on this thread and the arena was
+   * not released since.
+   */
+  [[nodiscard]] static bool has_local() noexcept;
+
+  /**
+   * @brief Returns the number of live ScratchFrames on the calling thread.
+   * @return The current frame nesting depth.
+   */
+  [[nodiscard]] static std::size_t frame_depth() noexcept;
+
+  /**
+   * @brief Frees the calling thread's arena, e.g. before a thread goes idle
+   * for a long time. The next local() call creates a new one.
+   * @return true if the arena was freed or did not exist; false if frames are
+   * still open on this thread.
+   */
+  static bool release_local() noexcept;
+
+ private:
+  friend class ScratchFrame;
+
+  // Frame bookkeeping, called by ScratchFrame
+  static void enter_frame() noexcept;
+  static void leave_frame() noexcept;
+};
+
+/**
+ * @class ScratchFrame
+ * @brief RAII frame over the calling thread's scratch arena.
+ *
+ * Works like StackCheckpoint on ScratchArena::local(): everything allocated
+ * through the frame is released, and objects created with emplace() are
+ * destroyed, when the frame goes out of scope. Frames nest, and must be
+ * destroyed on the thread that created them.
+ *
+ * Copying and moving are disabled to strictly enforce scope management.
+ */
+class ScratchFrame {
+ public:
+  /**
+   * @brief Opens a frame on the calling thread's arena, creating it if
+   * needed.
+   * @throws std::runtime_error If the arena could not be allocated.
+   */
+  ScratchFrame();
+
+  /**
+   * @brief Releases everything allocated since the frame was opened.
+   */
+  ~ScratchFrame();
+
+  // Don't allow moving or copying - this is a scoped frame!
+  ScratchFrame(const ScratchFrame&) = delete;
+  ScratchFrame& operator=(const ScratchFrame&) = delete;
+  ScratchFrame(ScratchFrame&&) = delete;
+  ScratchFrame& operator=(ScratchFrame&&) = delete;
+
+  /**
+   * @brief Allocates memory for a single object of type T.
+   * @return The allocated memory for T, or nullptr on failure.
+   */
+  template <typename T>
+  [[nodiscard]] T* alloc_t() noexcept {
+    return allocator_.alloc_t<T>();
+  }
+
+  /**
+   * @brief Allocates a block of memory with the specified size and alignment.
+   * @param size Number of bytes to allocate.
+   * @param alignment Alignment in bytes (default: alignof(std::max_align_t)).
+   * @return Pointer to allocated memory or nullptr if allocation fails.
+   */
+  [[nodiscard]] void* alloc(
+      std::size_t size,
+      std::size_t alignment = alignof(std::max_align_t)) noexcept {
+    return allocator_.alloc(size, alignment);
+  }
+
+  /**
+   * @brief Constructs an object of type T, destroyed with the frame.
+   * @param args Arguments forwarded to T's constructor.
+   * @return The constructed object, or nullptr if out of memory.
+   * @throws Any exception thrown by T's constructor.
+   */
+  template <typename T, typename... Args>
+  [[nodiscard]] T* emplace(Args&&... args) {
+    return allocator_.emplace<T>(std::forward<Args>(args)...);
+  }
+
+  /**
+   * @brief Returns the arena this frame allocates from.
+   * @return The calling thread's arena.
+   */
+  [[nodiscard]] ArenaAllocator& allocator() noexcept { return allocator_; }
+
+ private:
+  // The thread's arena
+  ArenaAllocator& allocator_;
+
+  // Restores the arena on destruction
+  BasicStackCheckpoint<ArenaAllocator> checkpoint_;
+};
+
+}  // namespace intns::memory
+
+#endif
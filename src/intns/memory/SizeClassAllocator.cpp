@@ -0,0 +1,322 @@
+#include "SizeClassAllocator.hpp"
+
+#include <algorithm>
+#include <new>
+#include <stdexcept>
+#include <utility>
+
+namespace intns::memory {
+
+namespace {
+
+// Chunks are aligned so every block is aligned to its own size class
+constexpr std::align_val_t kChunkAlign{SizeClassAllocator::kMaxBlockSize};
+
+// Alignment used for requests too large for a size class
+std::align_val_t large_align(std::size_t alignment) noexcept {
+  return std::align_val_t{std::max(alignment, alignof(std::max_align_t))};
+}
+
+}  // namespace
+
+SizeClassAllocator::SizeClassAllocator(size_type chunk_size,
+                                       std::optional<PageOptions> pages)
+    : chunk_size_(chunk_size), pages_(std::move(pages)) {
+  if (chunk_size < kMaxBlockSize) [[unlikely]] {
+    throw std::runtime_error(
+        "SizeClassAllocator: Chunk size is smaller than the largest block.");
+  }
+}
+
+SizeClassAllocator::~SizeClassAllocator() {
+  for (SizeClass& sc : classes_) {
+    for (const Chunk& chunk : sc.chunks) {
+      if (pages_.has_value()) {
+        PageMemory::unmap(chunk.memory, chunk.size);
+      } else {
+        ::operator delete(chunk.memory, kChunkAlign);
+      }
+    }
+  }
+}
+
+void* SizeClassAllocator::alloc(size_type size, size_type alignment) noexcept {
+  if (!is_power_of_two(alignment)) [[unlikely]] {
+    return nullptr;
+  }
+
+  const size_type index = class_of(size, alignment);
+  if (index == kClassCount) [[unlikely]] {
+    return ::operator new(size, large_align(alignment), std::nothrow);
+  }
+
+  SizeClass& sc = classes_[index];
+  std::scoped_lock<std::mutex> lock(sc.mutex);
+  return take_block(sc, index);
+}
+
+void SizeClassAllocator::deallocate(void* ptr, size_type size,
+                                    size_type alignment) noexcept {
+  if (!ptr) {
+    return;
+  }
+
+  const size_type index = class_of(size, alignment);
+  if (index == kClassCount) [[unlikely]] {
+    ::operator delete(ptr, large_align(alignment));
+    return;
+  }
+
+  auto* block = ::new (ptr) FreeBlock{nullptr};
+  free_batch(index, block, block);
+}
+
+SizeClassAllocator::FreeBlock* SizeClassAllocator::take_block(
+    SizeClass& sc, size_type index) noexcept {
+  if (FreeBlock* block = sc.free) {
+    sc.free = block->next;
+    return block;
+  }
+
+  // Carve a never-used block, starting a new chunk if needed
+  const size_type size = block_size(index);
+  if (static_cast<size_type>(sc.end - sc.bump) < size) {
+    try {
+      sc.chunks.reserve(sc.chunks.size() + 1);  // Nothing leaks if this throws
+    } catch (...) {
+      return nullptr;
+    }
+
+    const Chunk chunk = new_chunk();
+    if (!chunk.memory) [[unlikely]] {
+      return nullptr;
+    }
+
+    sc.chunks.push_back(chunk);
+    sc.bump = static_cast<std::byte*>(chunk.memory);
+    sc.end = sc.bump + chunk.size;
+    reserved_.fetch_add(chunk.size, std::memory_order_relaxed);
+  }
+
+  void* block = sc.bump;
+  sc.bump += size;
+  return ::new (block) FreeBlock{nullptr};
+}
+
+SizeClassAllocator::Chunk SizeClassAllocator::new_chunk() const noexcept {
+  if (pages_.has_value()) {
+    // Pages are aligned far beyond kChunkAlign
+    PageMemory pages = PageMemory::try_map(chunk_size_, *pages_);
+    const size_type size = pages.size();
+    return Chunk{pages.release(), size};
+  }
+
+  return Chunk{::operator new(chunk_size_, kChunkAlign, std::nothrow),
+               chunk_size_};
+}
+
+SizeClassAllocator::size_type SizeClassAllocator::alloc_batch(
+    size_type index, FreeBlock*& head, size_type count) noexcept {
+  SizeClass& sc = classes_[index];
+  std::scoped_lock<std::mutex> lock(sc.mutex);
+
+  size_type taken = 0;
+  while (taken < count) {
+    FreeBlock* block = take_block(sc, index);
+    if (!block) {
+      break;
+    }
+
+    block->next = head;
+    head = block;
+    ++taken;
+  }
+  return taken;
+}
+
+void SizeClassAllocator::free_batch(size_type index, FreeBlock* head,
+                                    FreeBlock* tail) noexcept {
+  SizeClass& sc = classes_[index];
+  std::scoped_lock<std::mutex> lock(sc.mutex);
+  tail->next = sc.free;
+  sc.free = head;
+}
+
+thread_local CachedSizeClassAllocator::ThreadCache
+    CachedSizeClassAllocator::tls_cache_;
+
+thread_local CachedSizeClassAllocator::CacheState
+    CachedSizeClassAllocator::tls_state_ = CacheState::kUnused;
+
+CachedSizeClassAllocator::CachedSizeClassAllocator(
+    size_type magazine_size, size_type chunk_size,
+    std::optional<PageOptions> pages)
+    : magazine_size_(magazine_size) {
+  if (magazine_size == 0) [[unlikely]] {
+    throw std::runtime_error(
+        "CachedSizeClassAllocator: Magazine size is zero.");
+  }
+
+  backend_ = std::make_shared<SizeClassAllocator>(chunk_size, std::move(pages));
+}
+
+CachedSizeClassAllocator::~CachedSizeClassAllocator() {
+  backend_->retired_.store(true, std::memory_order_release);
+
+  // Drop our own thread's cache now, other threads drop theirs lazily. A
+  // static allocator is destroyed after the main thread's cache, which then
+  // already flushed into the back end.
+  if (tls_state_ != CacheState::kLive) {
+    return;
+  }
+
+  ThreadCache& cache = tls_cache_;
+  if (cache.last && cache.last->owner_id == id_) {
+    cache.last = nullptr;
+  }
+
+  std::erase_if(cache.magazines,
+                [this](const auto& mag) { return mag->owner_id == id_; });
+}
+
+void* CachedSizeClassAllocator::alloc(size_type size,
+                                      size_type alignment) noexcept {
+  if (!is_power_of_two(alignment)) [[unlikely]] {
+    return nullptr;
+  }
+
+  const size_type index = SizeClassAllocator::class_of(size, alignment);
+  Magazine* mag = local_magazine();
+  if (index == SizeClassAllocator::kClassCount || !mag) [[unlikely]] {
+    return backend_->alloc(size, alignment);
+  }
+
+  // Take half a magazine so the next few frees don't spill straight back
+  auto& list = mag->lists[index];
+  if (!list.head) {
+    list.count += backend_->alloc_batch(
+        index, list.head, std::max<size_type>(magazine_size_ / 2, 1));
+    if (!list.head) [[unlikely]] {
+      return nullptr;
+    }
+  }
+
+  FreeBlock* block = list.head;
+  list.head = block->next;
+  --list.count;
+  return block;
+}
+
+void CachedSizeClassAllocator::deallocate(void* ptr, size_type size,
+                                          size_type alignment) noexcept {
+  if (!ptr) {
+    return;
+  }
+
+  const size_type index = SizeClassAllocator::class_of(size, alignment);
+  Magazine* mag = local_magazine();
+  if (index == SizeClassAllocator::kClassCount || !mag) [[unlikely]] {
+    backend_->deallocate(ptr, size, alignment);
+    return;
+  }
+
+  // Give back half a magazine so the next few allocs stay local
+  auto& list = mag->lists[index];
+  if (list.count >= magazine_size_) {
+    const size_type batch = std::max<size_type>(magazine_size_ / 2, 1);
+    FreeBlock* head = list.head;
+    FreeBlock* tail = head;
+    for (size_type i = 1; i < batch; ++i) {
+      tail = tail->next;
+    }
+
+    list.head = tail->next;
+    list.count -= batch;
+    backend_->free_batch(index, head, tail);
+  }
+
+  list.head = ::new (ptr) FreeBlock{list.head};
+  ++list.count;
+}
+
+void CachedSizeClassAllocator::flush_thread_cache() noexcept {
+  if (Magazine* mag = find_magazine()) {
+    mag->flush();
+  }
+}
+
+void CachedSizeClassAllocator::Magazine::flush() noexcept {
+  if (!backend) {
+    return;
+  }
+
+  for (size_type index = 0; index < lists.size(); ++index) {
+    List& list = lists[index];
+    if (!list.head) {
+      continue;
+    }
+
+    FreeBlock* tail = list.head;
+    while (tail->next) {
+      tail = tail->next;
+    }
+
+    backend->free_batch(index, list.head, tail);
+    list = List{};
+  }
+}
+
+CachedSizeClassAllocator::Magazine* CachedSizeClassAllocator::find_magazine()
+    const noexcept {
+  if (tls_state_ != CacheState::kLive) [[unlikely]] {
+    return nullptr;
+  }
+
+  ThreadCache& cache = tls_cache_;
+
+  // Fast path: same allocator as last time on this thread
+  if (cache.last && cache.last->owner_id == id_) [[likely]] {
+    return cache.last;
+  }
+
+  for (auto& mag : cache.magazines) {
+    if (mag->owner_id == id_) {
+      cache.last = mag.get();
+      return cache.last;
+    }
+  }
+
+  return nullptr;
+}
+
+CachedSizeClassAllocator::Magazine* CachedSizeClassAllocator::local_magazine()
+    const noexcept {
+  if (Magazine* mag = find_magazine()) [[likely]] {
+    return mag;
+  }
+
+  if (tls_state_ == CacheState::kDestroyed) [[unlikely]] {
+    return nullptr;  // Thread exiting, fall back to the back end
+  }
+
+  ThreadCache& cache = tls_cache_;
+
+  // First use on this thread, drop caches of allocators that no longer exist
+  std::erase_if(cache.magazines, [](const auto& mag) {
+    return mag->backend->retired_.load(std::memory_order_acquire);
+  });
+
+  try {
+    auto mag = std::make_unique<Magazine>();
+    mag->owner_id = id_;
+    mag->backend = backend_;
+    cache.magazines.push_back(std::move(mag));
+  } catch (...) {
+    return nullptr;  // Out of memory, fall back to the back end
+  }
+
+  cache.last = cache.magazines.back().get();
+  return cache.last;
+}
+
+}  // namespace intns::memory
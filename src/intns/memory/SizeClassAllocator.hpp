@@ -0,0 +1,387 @@
+#ifndef INTNS_MEMORY_SIZECLASSALLOCATOR_HPP
+#define INTNS_MEMORY_SIZECLASSALLOCATOR_HPP
+
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <type_traits>
+#include <vector>
+
+#include "Alignment.hpp"
+#include "PageMemory.hpp"
+
+namespace intns::memory {
+
+/**
+ * @class SizeClassAllocator
+ * @brief A thread-safe fixed-block allocator for small objects of varying
+ * size, freed in any order.
+ *
+ * Requests are rounded up to one of kClassCount size classes, multiples of
+ * kGranularity up to kMaxBlockSize. Each class carves blocks out of its own
+ * chunks and keeps freed blocks on an intrusive free list, so alloc() and
+ * deallocate() are O(1) and never touch the global heap once warmed up.
+ * Larger or over-aligned requests are forwarded to aligned operator new.
+ *
+ * Each size class has its own mutex; use CachedSizeClassAllocator where
+ * many threads allocate from the same class.
+ *
+ * Usage Notes:
+ * - deallocate() must be given the same size and alignment as alloc().
+ * - Chunks are only returned to the OS when the allocator is destroyed.
+ * - Chunks can be mapped with PageMemory, e.g. on huge pages.
+ * - Plugs into AllocatorResource and AllocatorAdapter.
+ */
+class SizeClassAllocator {
+ public:
+  using size_type = std::size_t;
+
+  // Size classes are multiples of this, which is also the minimum alignment
+  static constexpr size_type kGranularity = 16;
+
+  // Largest block served from a size class
+  static constexpr size_type kMaxBlockSize = 512;
+
+  // Number of size classes
+  static constexpr size_type kClassCount = kMaxBlockSize / kGranularity;
+
+  // Default bytes per chunk
+  static constexpr size_type kDefaultChunkSize = 64 * 1024;
+
+  static_assert(is_power_of_two(kGranularity) &&
+                    is_power_of_two(kMaxBlockSize),
+                "Size class bounds must be powers of two");
+
+  /**
+   * @brief Constructs an allocator; no memory is allocated until first use.
+   *
+   * @param chunk_size Bytes carved into blocks at a time, per size class.
+   * @param pages Map chunks straight from the OS with these options, e.g. for
+   * huge pages or NUMA binding; chunks come from operator new if unspecified.
+   * @throws std::runtime_error If `chunk_size` is smaller than kMaxBlockSize.
+   */
+  explicit SizeClassAllocator(
+      size_type chunk_size = kDefaultChunkSize,
+      std::optional<PageOptions> pages = std::nullopt);
+
+  /**
+   * @brief Frees every chunk. Blocks still allocated become invalid.
+   */
+  ~SizeClassAllocator();
+
+  // Blocks point into the allocator's chunks
+  SizeClassAllocator(const SizeClassAllocator&) = delete;
+  SizeClassAllocator& operator=(const SizeClassAllocator&) = delete;
+  SizeClassAllocator(SizeClassAllocator&&) = delete;
+  SizeClassAllocator& operator=(SizeClassAllocator&&) = delete;
+
+  /**
+   * @brief Returns the size class serving a request.
+   *
+   * @param size Requested bytes.
+   * @param alignment Requested alignment, a power of two.
+   * @return The class index, or kClassCount if the request is too large or
+   * too strictly aligned for a size class.
+   */
+  [[nodiscard]] static constexpr size_type class_of(
+      size_type size, size_type alignment) noexcept {
+    const size_type align = alignment < kGranularity ? kGranularity : alignment;
+    if (size > kMaxBlockSize || align > kMaxBlockSize) {
+      return kClassCount;
+    }
+
+    // Rounding to the alignment makes every block in the class aligned
+    const size_type block = align_address(size == 0 ? 1 : size, align);
+    return block > kMaxBlockSize ? kClassCount : block / kGranularity - 1;
+  }
+
+  /**
+   * @brief Returns the block size of a size class.
+   * @param index The class index, below kClassCount.
+   * @return The size in bytes of every block in the class.
+   */
+  [[nodiscard]] static constexpr size_type block_size(
+      size_type index) noexcept {
+    return (index + 1) * kGranularity;
+  }
+
+  /**
+   * @brief Allocates memory for a single object of type T.
+   * @return The allocated memory for T, or nullptr on failure.
+   */
+  template <typename T>
+  [[nodiscard]] T* alloc_t() noexcept {
+    static_assert(!std::is_reference_v<T>,
+                  "Cannot allocate storage for reference types");
+    static_assert(!std::is_void_v<T>, "Cannot allocate storage for void");
+    static_assert(sizeof(T) > 0, "Type must have non-zero size");
+
+    return static_cast<T*>(alloc(sizeof(T), alignof(T)));
+  }
+
+  /**
+   * @brief Allocates a block with the specified size and alignment.
+   *
+   * @param size Number of bytes to allocate.
+   * @param alignment Alignment in bytes (default: alignof(std::max_align_t)).
+   * @return Pointer to allocated memory, or nullptr if alignment is not a
+   * power of two or memory allocation fails.
+   */
+  [[nodiscard]] void* alloc(
+      size_type size,
+      size_type alignment = alignof(std::max_align_t)) noexcept;
+
+  /**
+   * @brief Returns a block to its size class.
+   *
+   * @param ptr The block, or nullptr to do nothing.
+   * @param size The size passed to alloc().
+   * @param alignment The alignment passed to alloc().
+   */
+  void deallocate(void* ptr, size_type size,
+                  size_type alignment = alignof(std::max_align_t)) noexcept;
+
+  /**
+   * @brief Returns the number of bytes reserved from the OS for size classes.
+   * @return The total size of all chunks.
+   */
+  [[nodiscard]] size_type bytes_reserved() const noexcept {
+    return reserved_.load(std::memory_order_relaxed);
+  }
+
+  /**
+   * @brief Returns the number of bytes carved into each chunk.
+   * @return The chunk size given on construction.
+   */
+  [[nodiscard]] size_type chunk_size() const noexcept { return chunk_size_; }
+
+ private:
+  friend class CachedSizeClassAllocator;
+
+  // Link stored in every free block
+  struct FreeBlock {
+    FreeBlock* next;
+  };
+
+  // A chunk and its size, which may be rounded up to whole pages
+  struct Chunk {
+    void* memory;
+    size_type size;
+  };
+
+  /**
+   * @brief One size class, padded so classes don't share cache lines.
+   */
+  struct alignas(kCacheLineSize) SizeClass {
+    std::mutex mutex;
+    FreeBlock* free = nullptr;  // Freed blocks, most recent first
+    std::byte* bump = nullptr;  // Next never-used block in the newest chunk
+    std::byte* end = nullptr;   // End of the newest chunk
+    std::vector<Chunk> chunks;  // Every chunk owned by this class
+  };
+
+  // Pops or carves one block, caller holds the class lock
+  [[nodiscard]] FreeBlock* take_block(SizeClass& sc,
+                                      size_type index) noexcept;
+
+  /**
+   * @brief Takes up to `count` blocks of a class in one lock acquisition.
+   * @return The number of blocks linked onto `head`.
+   */
+  size_type alloc_batch(size_type index, FreeBlock*& head,
+                        size_type count) noexcept;
+
+  // Returns a linked list of `tail`-terminated blocks in one lock acquisition
+  void free_batch(size_type index, FreeBlock* head, FreeBlock* tail) noexcept;
+
+  // Allocates a chunk of at least chunk_size_ bytes
+  [[nodiscard]] Chunk new_chunk() const noexcept;
+
+  // Bytes carved into blocks at a time
+  size_type chunk_size_ = kDefaultChunkSize;
+
+  // How chunks are mapped, operator new is used if empty
+  std::optional<PageOptions> pages_;
+
+  // Total size of all chunks
+  std::atomic<size_type> reserved_ = 0;
+
+  // Set once a CachedSizeClassAllocator front end is destroyed
+  std::atomic<bool> retired_ = false;
+
+  // The size classes, smallest first
+  std::array<SizeClass, kClassCount> classes_;
+};
+
+/**
+ * @class CachedSizeClassAllocator
+ * @brief A SizeClassAllocator with per-thread block caches in front.
+ *
+ * Each thread keeps up to `magazine_size()` free blocks per size class, so
+ * alloc() and deallocate() usually touch only thread-local state; blocks move
+ * to and from the shared back end half a magazine at a time, as in
+ * CachedObjectPool.
+ *
+ * Blocks may be freed on any thread. Thread caches keep the back end alive,
+ * so threads outliving the allocator can still flush safely.
+ *
+ * @note All public methods are thread-safe.
+ */
+class CachedSizeClassAllocator {
+ public:
+  using size_type = SizeClassAllocator::size_type;
+
+  // Default number of free blocks each thread may cache per size class
+  static constexpr size_type kDefaultMagazineSize = 32;
+
+  /**
+   * @brief Constructs the allocator and its back end.
+   *
+   * @param magazine_size Free blocks each thread may cache per size class.
+   * @param chunk_size Bytes carved into blocks at a time, per size class.
+   * @param pages Page options for the back end's chunks.
+   * @throws std::runtime_error If `magazine_size` is zero or `chunk_size` is
+   * smaller than SizeClassAllocator::kMaxBlockSize.
+   */
+  explicit CachedSizeClassAllocator(
+      size_type magazine_size = kDefaultMagazineSize,
+      size_type chunk_size = SizeClassAllocator::kDefaultChunkSize,
+      std::optional<PageOptions> pages = std::nullopt);
+
+  /**
+   * @brief Drops the calling thread's cache; other threads drop theirs when
+   * they exit, or when they next use an allocator of this type.
+   */
+  ~CachedSizeClassAllocator();
+
+  // Thread caches refer to the allocator by identity
+  CachedSizeClassAllocator(const CachedSizeClassAllocator&) = delete;
+  CachedSizeClassAllocator& operator=(const CachedSizeClassAllocator&) =
+      delete;
+  CachedSizeClassAllocator(CachedSizeClassAllocator&&) = delete;
+  CachedSizeClassAllocator& operator=(CachedSizeClassAllocator&&) = delete;
+
+  /**
+   * @brief Allocates memory for a single object of type T.
+   * @return The allocated memory for T, or nullptr on failure.
+   */
+  template <typename T>
+  [[nodiscard]] T* alloc_t() noexcept {
+    return static_cast<T*>(alloc(sizeof(T), alignof(T)));
+  }
+
+  /**
+   * @brief Allocates a block, from the calling thread's cache when possible.
+   *
+   * @param size Number of bytes to allocate.
+   * @param alignment Alignment in bytes (default: alignof(std::max_align_t)).
+   * @return Pointer to allocated memory, or nullptr on failure.
+   */
+  [[nodiscard]] void* alloc(
+      size_type size,
+      size_type alignment = alignof(std::max_align_t)) noexcept;
+
+  /**
+   * @brief Returns a block to the calling thread's cache.
+   *
+   * @param ptr The block, or nullptr to do nothing.
+   * @param size The size passed to alloc().
+   * @param alignment The alignment passed to alloc().
+   */
+  void deallocate(void* ptr, size_type size,
+                  size_type alignment = alignof(std::max_align_t)) noexcept;
+
+  /**
+   * @brief Returns every block cached by the calling thread to the back end.
+   * Does nothing on a thread that has not used the allocator.
+   */
+  void flush_thread_cache() noexcept;
+
+  /**
+   * @brief Returns the number of free blocks each thread may cache per class.
+   * @return The magazine size given on construction.
+   */
+  [[nodiscard]] size_type magazine_size() const noexcept {
+    return magazine_size_;
+  }
+
+  /**
+   * @brief Returns the shared back end.
+   * @return The allocator behind the thread caches.
+   */
+  [[nodiscard]] SizeClassAllocator& backend() const noexcept {
+    return *backend_;
+  }
+
+ private:
+  using FreeBlock = SizeClassAllocator::FreeBlock;
+
+  /**
+   * @brief One thread's free blocks for one allocator, per size class.
+   */
+  struct Magazine {
+    struct List {
+      FreeBlock* head = nullptr;
+      size_type count = 0;
+    };
+
+    std::uint64_t owner_id = 0;
+    std::shared_ptr<SizeClassAllocator> backend;
+    std::array<List, SizeClassAllocator::kClassCount> lists{};
+
+    ~Magazine() { flush(); }
+
+    // Returns every cached block to the back end
+    void flush() noexcept;
+  };
+
+  // Lifetime of the calling thread's ThreadCache; a static allocator is
+  // destroyed after the main thread's cache
+  enum class CacheState : std::uint8_t { kUnused, kLive, kDestroyed };
+
+  /**
+   * @brief Per-thread list of magazines, one per allocator this thread used.
+   */
+  struct ThreadCache {
+    std::vector<std::unique_ptr<Magazine>> magazines;
+    Magazine* last = nullptr;  // Most recently used magazine
+
+    ThreadCache() noexcept { tls_state_ = CacheState::kLive; }
+    ~ThreadCache() { tls_state_ = CacheState::kDestroyed; }
+  };
+
+  // Finds the calling thread's magazine, nullptr if this thread has not used
+  // the allocator
+  [[nodiscard]] Magazine* find_magazine() const noexcept;
+
+  // Finds or creates the calling thread's magazine, nullptr if out of memory
+  // or the thread's cache is already destroyed
+  [[nodiscard]] Magazine* local_magazine() const noexcept;
+
+  // The calling thread's caches for allocators of this type
+  static thread_local ThreadCache tls_cache_;
+
+  // Whether tls_cache_ may be accessed; trivially destructible, so still
+  // readable after tls_cache_ is gone
+  static thread_local CacheState tls_state_;
+
+  // Source of unique allocator identities; ids are never reused
+  static inline std::atomic<std::uint64_t> next_id_ = 1;
+
+  // Identity used to match this allocator's magazines
+  std::uint64_t id_ = next_id_.fetch_add(1, std::memory_order_relaxed);
+
+  // Free blocks each thread may cache per size class
+  size_type magazine_size_ = kDefaultMagazineSize;
+
+  // Shared storage behind the thread caches
+  std::shared_ptr<SizeClassAllocator> backend_;
+};
+
+}  // namespace intns::memory
+
+#endif
@@ -0,0 +1,284 @@
+#ifndef INTNS_MEMORY_SLOTPOOL_HPP
+#define INTNS_MEMORY_SLOTPOOL_HPP
+
+#include <algorithm>
+#include <cassert>
+#include <cstddef>
+#include <memory>
+#include <mutex>
+#include <new>
+#include <optional>
+#include <stdexcept>
+#include <type_traits>
+#include <vector>
+
+#include "Alignment.hpp"
+#include "ObjectPool.hpp"
+
+namespace intns::memory {
+
+/**
+ * @brief A thread-safe pool that keeps objects in place and hands out
+ * pointers to them.
+ *
+ * Objects live in fixed, cache-line-aligned chunks of slots and are never
+ * moved; take() returns a pointer to an idle slot and add() returns it to an
+ * intrusive free list, both in O(1). Useful for large objects where moving is
+ * expensive, and for pinned types (holding atomics, mutexes, ...) which
+ * ObjectPool cannot store.
+ *
+ * @tparam T The type of objects managed (default constructible).
+ * @tparam AcquirePolicy Class with static on_acquire(T&) called on acquisition.
+ * @tparam ReleasePolicy Class with static on_release(T&) called on release.
+ *
+ * @note All public methods are thread-safe.
+ *
+ * @section Usage
+ * Use take() or try_take() to acquire a pointer, add() or try_add() to give
+ * it back; PoolLease works as with ObjectPool. Use reserve() to grow the pool.
+ * Pointers are only valid while the pool is alive.
+ *
+ * @section Exception Safety
+ * Construction throws std::runtime_error if initial size exceeds limit.
+ * Methods throw std::runtime_error if pool is empty or size limit is exceeded.
+ * Exceptions during object creation or policy methods are propagated.
+ */
+template <typename T, typename AcquirePolicy = NoOpPoolPolicy<T>,
+          typename ReleasePolicy = AcquirePolicy>
+  requires AcquireHook<AcquirePolicy, T> && ReleaseHook<ReleasePolicy, T>
+class SlotPool {
+  static_assert(std::is_default_constructible_v<T>,
+                "T must be default constructible");
+
+ public:
+  using size_type = size_t;
+  using value_type = T;
+  using pointer = T*;
+
+  // Default number of slots allocated together in one chunk
+  static constexpr size_type kDefaultSlotsPerChunk = 64;
+
+  /**
+   * @brief Creates a SlotPool with a set initial size and optional max limit.
+   * Objects are default-constructed in place and processed by
+   * `ReleasePolicy::on_release` upon creation.
+   *
+   * @param init_size The number of objects to initially create in the pool.
+   * @param limit The maximum number of objects the pool may create (optional,
+   * default is 0 for unlimited).
+   * @param slots_per_chunk The number of slots allocated together.
+   * @throws std::runtime_error If `init_size` is greater than the specified
+   * size limit, or `slots_per_chunk` is zero.
+   * @throws Any exception thrown during object creation or by
+   * `ReleasePolicy::on_release`.
+   */
+  explicit SlotPool(size_type init_size = 0,
+                    std::optional<size_type> limit = std::nullopt,
+                    size_type slots_per_chunk = kDefaultSlotsPerChunk);
+
+  /**
+   * @brief Destroys every object created by the pool, leased or not.
+   */
+  ~SlotPool();
+
+  // Handed out pointers refer into the pool's chunks
+  SlotPool(const SlotPool&) = delete;
+  SlotPool& operator=(const SlotPool&) = delete;
+  SlotPool(SlotPool&&) = delete;
+  SlotPool& operator=(SlotPool&&) = delete;
+
+  /**
+   * @brief Acquires an idle object from the pool.
+   *
+   * @return pointer The acquired object, never null.
+   * @throws std::runtime_error If the pool is empty.
+   */
+  [[nodiscard]] pointer take();
+
+  /**
+   * @brief Attempts to acquire an idle object from the pool.
+   *
+   * @return pointer The acquired object, or nullptr if the pool is empty.
+   */
+  [[nodiscard]] pointer try_take() noexcept;
+
+  /**
+   * @brief Returns a previously taken object to the pool.
+   *
+   * @param obj The object to return, which must come from this pool's take().
+   * @throws std::invalid_argument If `obj` is null.
+   */
+  void add(pointer obj);
+
+  /**
+   * @brief Attempts to return a previously taken object to the pool.
+   *
+   * @param obj The object to return, which must come from this pool's take().
+   * @return true if the object was returned; false if `obj` is null.
+   */
+  [[nodiscard]] bool try_add(pointer obj) noexcept;
+
+  /**
+   * @brief Grows the pool until at least the specified number of objects are
+   * idle.
+   *
+   * @param target_size Minimum number of idle objects.
+   * @throws std::runtime_error if the target size is zero or growing would
+   * exceed the size limit.
+   */
+  void reserve(size_type target_size) {
+    (void)reserve_impl<true>(target_size);
+  }
+
+  /**
+   * @brief Grows the pool until at least the specified number of objects are
+   * idle, without throwing exceptions.
+   *
+   * @param target_size Minimum number of idle objects.
+   * @return true if the reservation was successful; false otherwise.
+   */
+  [[nodiscard]] bool try_reserve(size_type target_size) {
+    return reserve_impl<false>(target_size);
+  }
+
+  /**
+   * @brief Checks whether a pointer refers to a slot of this pool.
+   *
+   * @param obj The pointer to check.
+   * @return true if `obj` is one of this pool's objects.
+   * @note Linear in the number of chunks; intended for debugging.
+   */
+  [[nodiscard]] bool owns(const value_type* obj) const;
+
+  /**
+   * @brief Returns the number of idle objects.
+   * @return The number of objects available to take().
+   */
+  [[nodiscard]] size_type size() const {
+    std::scoped_lock<std::mutex> lock(mutex_);
+    return idle_count_;
+  }
+
+  /**
+   * @brief Checks if the pool has no idle objects.
+   * @return true if take() would fail, false otherwise.
+   */
+  [[nodiscard]] bool empty() const {
+    std::scoped_lock<std::mutex> lock(mutex_);
+    return idle_count_ == 0;
+  }
+
+  /**
+   * @brief Returns the number of objects created by the pool, leased or idle.
+   * @return The total number of objects.
+   */
+  [[nodiscard]] size_type capacity() const {
+    std::scoped_lock<std::mutex> lock(mutex_);
+    return created_count_;
+  }
+
+  /**
+   * @brief Returns the maximum number of objects the pool may create.
+   *
+   * @return The size limit, or std::nullopt if unlimited.
+   */
+  [[nodiscard]] std::optional<size_type> size_limit() const {
+    std::scoped_lock<std::mutex> lock(mutex_);
+    return size_limit_;
+  }
+
+  /**
+   * @brief Sets the max number of objects; nullopt makes it unlimited.
+   * Lowering the limit never destroys existing objects.
+   * @param limit The new size limit.
+   */
+  void set_size_limit(std::optional<size_type> limit) noexcept {
+    std::scoped_lock<std::mutex> lock(mutex_);
+    size_limit_ = limit;
+  }
+
+ private:
+  // Free list link, stored after the object so slot address == object address
+  struct FreeLink {
+    std::byte* next;
+  };
+
+  static constexpr size_type kSlotAlign =
+      std::max({alignof(T), alignof(FreeLink), kCacheLineSize});
+  static constexpr size_type kLinkOffset =
+      align_address(sizeof(T), alignof(FreeLink));
+  static constexpr size_type kSlotStride =
+      align_address(kLinkOffset + sizeof(FreeLink), kSlotAlign);
+
+  /**
+   * @brief A block of slots; objects are constructed front to back.
+   */
+  struct Chunk {
+    std::byte* memory = nullptr;
+    size_type constructed = 0;  // Slots in [0, constructed) hold objects
+  };
+
+  [[nodiscard]] static FreeLink& link_of(std::byte* slot) noexcept {
+    return *std::launder(reinterpret_cast<FreeLink*>(slot + kLinkOffset));
+  }
+
+  [[nodiscard]] static value_type* object_of(std::byte* slot) noexcept {
+    return std::launder(reinterpret_cast<value_type*>(slot));
+  }
+
+  // Pushes an idle slot onto the free list, caller holds the lock
+  void push_free(std::byte* slot) noexcept {
+    link_of(slot).next = free_head_;
+    free_head_ = slot;
+    ++idle_count_;
+  }
+
+  // Pops an idle slot from the free list, caller holds the lock
+  [[nodiscard]] std::byte* pop_free() noexcept {
+    std::byte* slot = free_head_;
+    if (slot) {
+      free_head_ = link_of(slot).next;
+      --idle_count_;
+    }
+    return slot;
+  }
+
+  /**
+   * @brief Constructs `count` new objects and puts them on the free list,
+   * allocating chunks as needed. Caller holds the lock.
+   */
+  void grow(size_type count);
+
+  // Destroys every object and frees every chunk
+  void destroy_all() noexcept;
+
+  template <bool ThrowOnError>
+  [[nodiscard]] bool reserve_impl(size_type target_size);
+
+  // Every chunk owned by the pool
+  std::vector<Chunk> chunks_;
+
+  // Head of the intrusive free list of idle slots
+  std::byte* free_head_ = nullptr;
+
+  // Number of slots on the free list
+  size_type idle_count_ = 0;
+
+  // Number of objects ever constructed
+  size_type created_count_ = 0;
+
+  // Number of slots per chunk
+  size_type slots_per_chunk_ = kDefaultSlotsPerChunk;
+
+  // Mutex for thread safety
+  mutable std::mutex mutex_;
+
+  // Customizable size limit on created objects, unlimited unless specified
+  std::optional<size_type> size_limit_ = std::nullopt;
+};
+
+}  // namespace intns::memory
+
+#include "SlotPool.tpp"
+
+#endif  // INTNS_MEMORY_SLOTPOOL_HPP
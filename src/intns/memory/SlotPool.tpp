@@ -0,0 +1,204 @@
+#include "SlotPool.hpp"
+
+namespace intns::memory {
+
+template <typename T, typename A, typename R>
+  requires AcquireHook<A, T> && ReleaseHook<R, T>
+SlotPool<T, A, R>::SlotPool(size_type init_size,
+                            std::optional<size_type> limit,
+                            size_type slots_per_chunk)
+    : slots_per_chunk_(slots_per_chunk), size_limit_(limit) {
+  if (slots_per_chunk == 0) [[unlikely]] {
+    throw std::runtime_error("SlotPool::SlotPool: slots per chunk is zero.");
+  }
+
+  if (limit.has_value() && init_size > limit.value()) [[unlikely]] {
+    throw std::runtime_error(
+        "SlotPool::SlotPool: initial size is > size limit.");
+  }
+
+  if (limit.has_value() && limit.value() == 0) {
+    size_limit_ = std::nullopt;  // 0 can also mean "unlimited"
+  }
+
+  try {
+    grow(init_size);
+  } catch (...) {
+    destroy_all();  // Destructor doesn't run for a throwing constructor
+    throw;
+  }
+}
+
+template <typename T, typename A, typename R>
+  requires AcquireHook<A, T> && ReleaseHook<R, T>
+SlotPool<T, A, R>::~SlotPool() {
+  destroy_all();
+}
+
+template <typename T, typename A, typename R>
+  requires AcquireHook<A, T> && ReleaseHook<R, T>
+void SlotPool<T, A, R>::destroy_all() noexcept {
+  for (Chunk& chunk : chunks_) {
+    for (size_type i = 0; i < chunk.constructed; ++i) {
+      std::destroy_at(object_of(chunk.memory + i * kSlotStride));
+    }
+    ::operator delete(chunk.memory, std::align_val_t{kSlotAlign});
+  }
+
+  chunks_.clear();
+  free_head_ = nullptr;
+  idle_count_ = 0;
+  created_count_ = 0;
+}
+
+template <typename T, typename A, typename R>
+  requires AcquireHook<A, T> && ReleaseHook<R, T>
+typename SlotPool<T, A, R>::pointer SlotPool<T, A, R>::take() {
+  std::scoped_lock<std::mutex> lock(mutex_);
+  std::byte* slot = pop_free();
+  if (!slot) [[unlikely]] {
+    throw std::runtime_error("SlotPool::take: pool is empty.");
+  }
+
+  // Notify the acquire policy, the object itself stays in place
+  value_type* obj = object_of(slot);
+  A::on_acquire(*obj);  // No exception can be thrown here
+  return obj;
+}
+
+template <typename T, typename A, typename R>
+  requires AcquireHook<A, T> && ReleaseHook<R, T>
+typename SlotPool<T, A, R>::pointer SlotPool<T, A, R>::try_take() noexcept {
+  std::scoped_lock<std::mutex> lock(mutex_);
+  std::byte* slot = pop_free();
+  if (!slot) {
+    return nullptr;
+  }
+
+  value_type* obj = object_of(slot);
+  A::on_acquire(*obj);
+  return obj;
+}
+
+template <typename T, typename A, typename R>
+  requires AcquireHook<A, T> && ReleaseHook<R, T>
+void SlotPool<T, A, R>::add(pointer obj) {
+  if (!obj) [[unlikely]] {
+    throw std::invalid_argument("SlotPool::add: object pointer is null.");
+  }
+
+  assert(owns(obj) && "SlotPool::add: object is not from this pool");
+
+  // Notify the release policy before
+  // putting the slot back on the free list
+  R::on_release(*obj);
+
+  std::scoped_lock<std::mutex> lock(mutex_);
+  push_free(reinterpret_cast<std::byte*>(obj));
+}
+
+template <typename T, typename A, typename R>
+  requires AcquireHook<A, T> && ReleaseHook<R, T>
+bool SlotPool<T, A, R>::try_add(pointer obj) noexcept {
+  if (!obj) {
+    return false;
+  }
+
+  assert(owns(obj) && "SlotPool::try_add: object is not from this pool");
+
+  R::on_release(*obj);
+
+  std::scoped_lock<std::mutex> lock(mutex_);
+  push_free(reinterpret_cast<std::byte*>(obj));
+  return true;
+}
+
+template <typename T, typename A, typename R>
+  requires AcquireHook<A, T> && ReleaseHook<R, T>
+bool SlotPool<T, A, R>::owns(const value_type* obj) const {
+  const auto* addr = reinterpret_cast<const std::byte*>(obj);
+
+  std::scoped_lock<std::mutex> lock(mutex_);
+  for (const Chunk& chunk : chunks_) {
+    if (addr < chunk.memory ||
+        addr >= chunk.memory + chunk.constructed * kSlotStride) {
+      continue;
+    }
+
+    return static_cast<size_type>(addr - chunk.memory) % kSlotStride == 0;
+  }
+
+  return false;
+}
+
+template <typename T, typename A, typename R>
+  requires AcquireHook<A, T> && ReleaseHook<R, T>
+void SlotPool<T, A, R>::grow(size_type count) {
+  while (count > 0) {
+    // Fill the unconstructed tail of the last chunk first
+    if (chunks_.empty() || chunks_.back().constructed == slots_per_chunk_) {
+      chunks_.reserve(chunks_.size() + 1);  // Nothing leaks if this throws
+      void* memory = ::operator new(slots_per_chunk_ * kSlotStride,
+                                    std::align_val_t{kSlotAlign});
+      chunks_.push_back(Chunk{static_cast<std::byte*>(memory), 0});
+    }
+
+    Chunk& chunk = chunks_.back();
+    std::byte* slot = chunk.memory + chunk.constructed * kSlotStride;
+
+    std::construct_at(object_of(slot));
+    ++chunk.constructed;
+    ++created_count_;
+
+    ::new (static_cast<void*>(slot + kLinkOffset)) FreeLink{nullptr};
+    R::on_release(*object_of(slot));
+    push_free(slot);
+    --count;
+  }
+}
+
+template <typename T, typename AcquirePolicy, typename ReleasePolicy>
+  requires AcquireHook<AcquirePolicy, T> && ReleaseHook<ReleasePolicy, T>
+template <bool ThrowOnError>
+bool SlotPool<T, AcquirePolicy, ReleasePolicy>::reserve_impl(
+    size_type target_size) {
+  if (target_size == 0) [[unlikely]] {
+    if constexpr (ThrowOnError) {
+      throw std::runtime_error("SlotPool::reserve: target size is zero.");
+    } else {
+      return true;  // Nothing to reserve
+    }
+  }
+
+  std::scoped_lock<std::mutex> lock(mutex_);
+  if (idle_count_ >= target_size) {
+    return true;  // Already at or above target size
+  }
+
+  // Check size limit against every object we would own afterwards
+  const size_type to_create = target_size - idle_count_;
+  if (size_limit_.has_value() &&
+      created_count_ + to_create > size_limit_.value()) {
+    if constexpr (ThrowOnError) {
+      throw std::runtime_error(
+          "SlotPool::reserve: cannot reserve more than size limit.");
+    } else {
+      return false;
+    }
+  }
+
+  // Objects created before a failure stay in the pool, idle and valid
+  if constexpr (ThrowOnError) {
+    grow(to_create);
+  } else {
+    try {
+      grow(to_create);
+    } catch (...) {
+      return false;
+    }
+  }
+
+  return true;
+}
+
+}  // namespace intns::memory
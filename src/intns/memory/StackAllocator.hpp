@@ -3,15 +3,22 @@
 
 #include <cstddef>
 #include <cstdint>
+#include <memory>
 #include <optional>
 #include <stdexcept>
+#include <type_traits>
+#include <utility>
 
+#include "../trace/Trace.hpp"
 #include "Alignment.hpp"
+#include "DestructorList.hpp"
+#include "MemoryStats.hpp"
+#include "PageMemory.hpp"
 
 namespace intns::memory {
 
 /**
- * @class StackAllocator
+ * @class BasicStackAllocator
  * @brief A fast, linear stack-based memory allocator for temporary allocations.
  *
  * Allocations are linear, with memory reclaimed on reset or restoring to a
@@ -22,19 +29,25 @@ namespace intns::memory {
  * - Supports checkpoints to save and restore allocation state.
  * - Disallows copying and moving for safety.
  * - Monitors memory usage and capacity.
- * - Manages internal memory only
+ * - Manages internal memory only, from malloc or PageMemory
  *
  * Usage Notes:
  * - Allocations valid only until allocator reset or checkpoint restore.
- * - Doesn't invoke constructors/destructors; use placement new and manual
- * cleanup.
+ * - alloc_t() and alloc() return raw storage; use emplace() to construct
+ * objects whose destructors must run on reset or checkpoint restore.
  * - Not thread-safe; designed for single-threaded use.
+ *
+ * @tparam StatsPolicy Records successful and failed allocations and peak
+ * usage; NoAllocatorStats (the default, used by StackAllocator) records
+ * nothing and costs nothing, AllocatorStats keeps relaxed atomic counters.
  */
-class StackAllocator {
+template <typename StatsPolicy = NoAllocatorStats>
+class BasicStackAllocator {
  public:
   using marker_type = std::uintptr_t;
   using checkpoint_t = marker_type;
   using size_type = std::size_t;
+  using stats_type = StatsPolicy;
 
   // Validate our assumptions
   static_assert(sizeof(marker_type) >= sizeof(void*),
@@ -50,7 +63,7 @@ class StackAllocator {
    * @param capacity The size in bytes of the memory block to allocate.
    * @throws std::runtime_error If capacity is zero or memory allocation fails.
    */
-  StackAllocator(size_type size = 1000);
+  BasicStackAllocator(size_type size = 1000);
 
   /**
    * @brief Constructs a StackAllocator with a given memory block and size.
@@ -61,20 +74,30 @@ class StackAllocator {
    * @throws std::runtime_error If memory is null, size is zero, or buffer is
    * too small after alignment.
    */
-  StackAllocator(void* memory, size_type size);
+  BasicStackAllocator(void* memory, size_type size);
+
+  /**
+   * @brief Constructs a StackAllocator over pages mapped with PageMemory,
+   * e.g. huge pages bound to a NUMA node, taking ownership of them.
+   *
+   * @param pages The backing pages; the capacity is pages.size().
+   * @throws std::runtime_error If `pages` is empty.
+   */
+  explicit BasicStackAllocator(PageMemory pages);
 
   /**
    * @brief Destructor for the StackAllocator class.
    *
-   * Releases the allocation by freeing the memory at start_marker_.
+   * Destroys any objects created with emplace(), then releases the
+   * allocation by freeing the memory at start_marker_.
    */
-  ~StackAllocator();
+  ~BasicStackAllocator();
 
   // Don't allow moving or copying
-  StackAllocator(const StackAllocator&) = delete;
-  StackAllocator& operator=(const StackAllocator&) = delete;
-  StackAllocator(StackAllocator&&) = delete;
-  StackAllocator& operator=(StackAllocator&&) = delete;
+  BasicStackAllocator(const BasicStackAllocator&) = delete;
+  BasicStackAllocator& operator=(const BasicStackAllocator&) = delete;
+  BasicStackAllocator(BasicStackAllocator&&) = delete;
+  BasicStackAllocator& operator=(BasicStackAllocator&&) = delete;
 
   /**
    * @brief Allocates memory for a single object of type T.
@@ -105,6 +128,7 @@ class StackAllocator {
     constexpr size_type align_req = alignof(T);  // Always power of 2 per spec
 
     if (type_size > capacity_) [[unlikely]] {
+      stats_.on_alloc_failed();
       return nullptr;
     }
 
@@ -113,12 +137,14 @@ class StackAllocator {
     // This calculates 'type_size' BACK from the end, where are we last valid?
     const auto last_valid_start_pos = (start_marker_ + capacity_) - type_size;
     if (aligned_pos < start_marker_ || aligned_pos > last_valid_start_pos) {
+      stats_.on_alloc_failed();
       return nullptr;
     }
 
     // Get aligned address and advance the marker
     T* new_addr = reinterpret_cast<T*>(aligned_pos);
     active_marker_ = aligned_pos + type_size;
+    on_alloc();
     return new_addr;
   }
 
@@ -141,11 +167,13 @@ class StackAllocator {
   [[nodiscard]] void* alloc(size_type size, size_type alignment = alignof(
                                                 std::max_align_t)) noexcept {
     if (size == 0 || size > capacity_) {
+      stats_.on_alloc_failed();
       return nullptr;
     }
 
     // If anything is awry with the alignment, bail
     if (!is_power_of_two(alignment) || alignment > capacity_) [[unlikely]] {
+      stats_.on_alloc_failed();
       return nullptr;
     }
 
@@ -154,15 +182,83 @@ class StackAllocator {
     // This calculates 'size' BACK from the end, where are we last valid?
     const auto last_valid_start_pos = (start_marker_ + capacity_) - size;
     if (aligned_pos < start_marker_ || aligned_pos > last_valid_start_pos) {
+      stats_.on_alloc_failed();
       return nullptr;
     }
 
     // Get aligned address and advance the marker
     void* new_addr = reinterpret_cast<void*>(aligned_pos);
     active_marker_ = aligned_pos + size;
+    on_alloc();
     return new_addr;
   }
 
+  /**
+   * @brief Allocates and constructs an object of type T in place.
+   *
+   * If T is not trivially destructible, a small destructor record is
+   * allocated alongside it, and the object is destroyed when the allocator is
+   * reset, destroyed, or restored to a checkpoint taken before this call.
+   * Destruction happens in reverse order of construction. Trivially
+   * destructible types cost exactly what alloc_t() does.
+   *
+   * @tparam T The type of object to construct.
+   * @param args Arguments forwarded to T's constructor.
+   * @return The constructed object, or nullptr if out of space.
+   * @throws Any exception thrown by T's constructor, in which case the
+   * allocator is left as it was before the call.
+   */
+  template <typename T, typename... Args>
+  [[nodiscard]] T* emplace(Args&&... args) {
+    const checkpoint_t before = active_marker_;
+
+    DestructorList::Record* record = nullptr;
+    if constexpr (!std::is_trivially_destructible_v<T>) {
+      record = alloc_t<DestructorList::Record>();
+      if (!record) {
+        return nullptr;
+      }
+    }
+
+    T* obj = alloc_t<T>();
+    if (!obj) {
+      active_marker_ = before;
+      return nullptr;
+    }
+
+    try {
+      std::construct_at(obj, std::forward<Args>(args)...);
+    } catch (...) {
+      active_marker_ = before;
+      throw;
+    }
+
+    if constexpr (!std::is_trivially_destructible_v<T>) {
+      destructors_.push(record, obj, before);
+    }
+    return obj;
+  }
+
+  /**
+   * @brief Frees the most recent allocation, if `ptr` is it.
+   *
+   * Lets callers that do free memory, such as containers, give back space
+   * when they free in LIFO order; any other call is a no-op.
+   *
+   * @param ptr Start of the allocation.
+   * @param size Size of the allocation in bytes, as passed to alloc().
+   * @return true if the allocation was on top and has been released.
+   */
+  [[nodiscard]] bool release_top(void* ptr, size_type size) noexcept {
+    const auto addr = reinterpret_cast<marker_type>(ptr);
+    if (addr < start_marker_ || addr + size != active_marker_) {
+      return false;
+    }
+
+    active_marker_ = addr;
+    return true;
+  }
+
   /**
    * @brief Saves the current state of the stack allocator.
    * @return checkpoint_t The current checkpoint marker.
@@ -174,6 +270,8 @@ class StackAllocator {
   /**
    * @brief Restores the stack allocator to a previously saved checkpoint.
    *
+   * Objects created with emplace() after the checkpoint are destroyed.
+   *
    * @param checkpoint The previous allocation state to restore.
    * @throws std::runtime_error if checkpoint is out of valid memory range.
    */
@@ -185,6 +283,7 @@ class StackAllocator {
           "StackAllocator::restore_checkpoint: Invalid checkpoint");
     }
 
+    destructors_.unwind_to(checkpoint);
     active_marker_ = checkpoint;
   }
 
@@ -214,12 +313,34 @@ class StackAllocator {
   [[nodiscard]] size_type capacity() const noexcept { return capacity_; }
 
   /**
-   * @brief Resets the stack allocator to its initial state.
+   * @brief Resets the stack allocator to its initial state, destroying every
+   * object created with emplace().
    * @note This function is noexcept and guarantees not to throw exceptions.
    */
-  void reset() noexcept { active_marker_ = start_marker_; }
+  void reset() noexcept {
+    destructors_.unwind_all();
+    active_marker_ = start_marker_;
+  }
+
+  /**
+   * @brief Returns the allocator's statistics policy.
+   * @return The statistics, call snapshot() on it to read counters.
+   */
+  [[nodiscard]] const stats_type& stats() const noexcept { return stats_; }
 
  private:
+  // Records a successful allocation, and traces each new high-water mark
+  void on_alloc() noexcept {
+    stats_.on_alloc(bytes_used());
+#if defined(INTNS_ENABLE_TRACING)
+    if (bytes_used() > traced_peak_) {
+      traced_peak_ = bytes_used();
+      INTNS_TRACE_COUNTER("StackAllocator::high_water", traced_peak_,
+                          reinterpret_cast<uintptr_t>(this));
+    }
+#endif
+  }
+
   // Marker to track the beginning of the stack
   marker_type start_marker_ = 0;
 
@@ -231,48 +352,92 @@ class StackAllocator {
 
   // Tracks ownership of the start marker
   bool owns_memory_ = true;
+
+  // Backing pages, if constructed from PageMemory
+  PageMemory pages_;
+
+  // Objects created by emplace() that still need destroying
+  DestructorList destructors_;
+
+  // Allocation statistics, empty unless enabled
+  [[no_unique_address]] StatsPolicy stats_;
+
+#if defined(INTNS_ENABLE_TRACING)
+  // Highest bytes_used() traced so far
+  size_type traced_peak_ = 0;
+#endif
 };
 
 /**
- * @class StackCheckpoint
- * @brief RAII wrapper for StackAllocator to manage scoped memory checkpoints.
+ * @brief The default stack allocator, without statistics.
+ */
+using StackAllocator = BasicStackAllocator<>;
+
+/**
+ * @class BasicStackCheckpoint
+ * @brief RAII wrapper managing a scoped checkpoint of any linear allocator.
  *
- * StackCheckpoint captures the StackAllocator state on creation and restores it
- * on destruction, ensuring all subsequent allocations are released when it goes
- * out of scope.
+ * BasicStackCheckpoint captures the allocator state on creation and restores
+ * it on destruction, ensuring all subsequent allocations are released when it
+ * goes out of scope. Use StackCheckpoint for StackAllocator itself.
  *
  * Copying and moving are disabled to strictly enforce scope management.
+ *
+ * @tparam Allocator Any allocator with save_checkpoint()/restore_checkpoint(),
+ * deduced from the constructor argument.
  */
-class StackCheckpoint {
+template <typename Allocator>
+class BasicStackCheckpoint {
   // The parent allocator
-  StackAllocator& allocator_;
+  Allocator& allocator_;
 
   // The position at object creation, to be restored on destruction
-  StackAllocator::checkpoint_t saved_ = 0;
+  typename Allocator::checkpoint_t saved_{};
 
  public:
   /**
-   * @brief Constructor that saves current state of the given StackAllocator.
-   * @param a Reference to the StackAllocator whose state will be checkpointed.
+   * @brief Constructor that saves current state of the given allocator.
+   * @param a Reference to the allocator whose state will be checkpointed.
    */
-  StackCheckpoint(StackAllocator& a)
+  BasicStackCheckpoint(Allocator& a)
       : allocator_(a), saved_(a.save_checkpoint()) {}
 
   /**
-   * @brief Destructor for the StackCheckpoint class.
+   * @brief Destructor for the BasicStackCheckpoint class.
    *
    * Restores the allocator to the saved checkpoint upon destruction,
    * releasing post-checkpoint allocations and maintaining stack-like semantics.
    */
-  ~StackCheckpoint() { allocator_.restore_checkpoint(saved_); }
+  ~BasicStackCheckpoint() { allocator_.restore_checkpoint(saved_); }
 
   // Don't allow moving or copying - this is a scoped checkpoint!
-  StackCheckpoint(const StackCheckpoint&) = delete;
-  StackCheckpoint& operator=(const StackCheckpoint&) = delete;
-  StackCheckpoint(StackCheckpoint&&) = delete;
-  StackCheckpoint& operator=(StackCheckpoint&&) = delete;
+  BasicStackCheckpoint(const BasicStackCheckpoint&) = delete;
+  BasicStackCheckpoint& operator=(const BasicStackCheckpoint&) = delete;
+  BasicStackCheckpoint(BasicStackCheckpoint&&) = delete;
+  BasicStackCheckpoint& operator=(BasicStackCheckpoint&&) = delete;
+};
+
+/**
+ * @class StackCheckpoint
+ * @brief RAII wrapper for StackAllocator to manage scoped memory checkpoints.
+ *
+ * StackCheckpoint captures the StackAllocator state on creation and restores it
+ * on destruction, ensuring all subsequent allocations are released when it goes
+ * out of scope.
+ *
+ * Copying and moving are disabled to strictly enforce scope management.
+ */
+class StackCheckpoint final : public BasicStackCheckpoint<StackAllocator> {
+ public:
+  /**
+   * @brief Constructor that saves current state of the given StackAllocator.
+   * @param a Reference to the StackAllocator whose state will be checkpointed.
+   */
+  StackCheckpoint(StackAllocator& a) : BasicStackCheckpoint(a) {}
 };
 
 }  // namespace intns::memory
 
+#include "StackAllocator.tpp"
+
 #endif
@@ -0,0 +1,10 @@
+#ifndef INTNS_TASK_HPP
+#define INTNS_TASK_HPP
+
+#include "task/MpmcRing.hpp"
+#include "task/Scheduler.hpp"
+#include "task/SpscRing.hpp"
+#include "task/TaskGraph.hpp"
+#include "task/WorkStealingDeque.hpp"
+
+#endif
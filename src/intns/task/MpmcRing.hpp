@@ -0,0 +1,176 @@
+#ifndef INTNS_TASK_MPMCRING_HPP
+#define INTNS_TASK_MPMCRING_HPP
+
+#include <atomic>
+#include <cstddef>
+#include <memory>
+#include <new>
+#include <optional>
+#include <span>
+#include <type_traits>
+#include <utility>
+
+#include "../memory/Alignment.hpp"
+
+namespace intns::task {
+
+/**
+ * @brief A bounded, lock-free multi-producer multi-consumer ring buffer.
+ *
+ * Each slot carries a sequence number saying whether it is ready to be
+ * filled or emptied in the current lap (Vyukov's bounded queue), so
+ * producers and consumers only contend on their own index, each on its own
+ * cache line, and never block one another. Batch operations claim a run of
+ * consecutive slots with a single compare-and-swap.
+ *
+ * @tparam T The element type, nothrow move constructible.
+ *
+ * @note All methods are thread-safe, except destruction.
+ */
+template <typename T>
+class MpmcRing {
+  static_assert(std::is_nothrow_move_constructible_v<T>,
+                "MpmcRing elements must be nothrow move constructible");
+
+ public:
+  using value_type = T;
+  using size_type = std::size_t;
+
+  /**
+   * @brief Creates an empty ring.
+   *
+   * @param capacity Maximum number of elements, a power of two of at least
+   * 2.
+   * @throws std::invalid_argument If capacity is not a power of two, or is
+   * 1.
+   */
+  explicit MpmcRing(size_type capacity);
+
+  /**
+   * @brief Destroys the elements still in the ring.
+   */
+  ~MpmcRing();
+
+  MpmcRing(const MpmcRing&) = delete;
+  MpmcRing& operator=(const MpmcRing&) = delete;
+  MpmcRing(MpmcRing&&) = delete;
+  MpmcRing& operator=(MpmcRing&&) = delete;
+
+  /**
+   * @brief Constructs an element at the back.
+   *
+   * @param args Constructor arguments.
+   * @return true if it was added; false if the ring is full.
+   */
+  template <typename... Args>
+  [[nodiscard]] bool try_emplace(Args&&... args);
+
+  /**
+   * @brief Moves an element to the back.
+   *
+   * @param value The element; left untouched if the ring is full.
+   * @return true if it was added; false if the ring is full.
+   */
+  [[nodiscard]] bool try_push(value_type&& value) {
+    return try_emplace(std::move(value));
+  }
+
+  /**
+   * @brief Moves as many elements as fit to the back as one contiguous
+   * run.
+   *
+   * @param values The elements; those added are moved from.
+   * @return The number of elements added, from the front of `values`.
+   */
+  size_type push_n(std::span<value_type> values);
+
+  /**
+   * @brief Removes the front element.
+   *
+   * @return The element, or std::nullopt if the ring is empty.
+   */
+  [[nodiscard]] std::optional<value_type> try_pop();
+
+  /**
+   * @brief Removes the front element into `out`.
+   *
+   * @param out Move-assigned the element if there is one.
+   * @return true if an element was removed; false if the ring is empty.
+   */
+  [[nodiscard]] bool try_pop(value_type& out)
+    requires std::is_nothrow_move_assignable_v<value_type>;
+
+  /**
+   * @brief Removes up to out.size() consecutive elements from the front.
+   * Existing elements of `out` are move-assigned over.
+   *
+   * @param out The destination.
+   * @return The number of elements removed, stored at the front of `out`.
+   */
+  size_type pop_n(std::span<value_type> out)
+    requires std::is_nothrow_move_assignable_v<value_type>;
+
+  /**
+   * @brief Returns the number of elements, approximate while other threads
+   * push or pop.
+   */
+  [[nodiscard]] size_type size() const noexcept {
+    const size_type tail = tail_.load(std::memory_order_acquire);
+    const size_type head = head_.load(std::memory_order_acquire);
+    return tail > head ? tail - head : 0;
+  }
+
+  /**
+   * @brief Checks whether the ring is empty, approximate like size().
+   */
+  [[nodiscard]] bool empty() const noexcept { return size() == 0; }
+
+  /**
+   * @brief Returns the maximum number of elements.
+   */
+  [[nodiscard]] size_type capacity() const noexcept { return mask_ + 1; }
+
+ private:
+  /**
+   * @brief One slot: its sequence number and uninitialized storage.
+   *
+   * `sequence == position` means free for the producer claiming
+   * `position`, `sequence == position + 1` means filled for the consumer
+   * claiming it.
+   */
+  struct Cell {
+    std::atomic<size_type> sequence;
+    alignas(value_type) std::byte storage[sizeof(value_type)];
+  };
+
+  [[nodiscard]] Cell& cell(size_type position) noexcept {
+    return cells_[position & mask_];
+  }
+
+  [[nodiscard]] static value_type* element(Cell& cell) noexcept {
+    return std::launder(reinterpret_cast<value_type*>(cell.storage));
+  }
+
+  // Claims up to `wanted` consecutive slots from `index`, those whose
+  // sequence is their position plus `offset` (0 to fill, 1 to empty).
+  // Returns the first position claimed and sets `count`, 0 if none were.
+  [[nodiscard]] size_type claim(std::atomic<size_type>& index,
+                                size_type offset, size_type wanted,
+                                size_type& count) noexcept;
+
+  // Read-only after construction
+  size_type mask_;
+  std::unique_ptr<Cell[]> cells_;
+
+  // Next position to empty, shared by consumers
+  alignas(memory::kCacheLineSize) std::atomic<size_type> head_{0};
+
+  // Next position to fill, shared by producers
+  alignas(memory::kCacheLineSize) std::atomic<size_type> tail_{0};
+};
+
+}  // namespace intns::task
+
+#include "MpmcRing.tpp"
+
+#endif  // INTNS_TASK_MPMCRING_HPP
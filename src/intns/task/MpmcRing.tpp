@@ -0,0 +1,153 @@
+#include "MpmcRing.hpp"
+
+#include <stdexcept>
+
+namespace intns::task {
+
+template <typename T>
+MpmcRing<T>::MpmcRing(size_type capacity) : mask_(capacity - 1) {
+  // With a single slot "filled" and "free for the next lap" look the same
+  if (!memory::is_power_of_two(capacity) || capacity < 2) {
+    throw std::invalid_argument(
+        "MpmcRing::MpmcRing: capacity must be a power of two of at least 2");
+  }
+
+  cells_ = std::make_unique<Cell[]>(capacity);
+  for (size_type i = 0; i < capacity; ++i) {
+    cells_[i].sequence.store(i, std::memory_order_relaxed);
+  }
+}
+
+template <typename T>
+MpmcRing<T>::~MpmcRing() {
+  const size_type tail = tail_.load(std::memory_order_relaxed);
+  for (size_type i = head_.load(std::memory_order_relaxed); i != tail; ++i) {
+    std::destroy_at(element(cell(i)));
+  }
+}
+
+template <typename T>
+typename MpmcRing<T>::size_type MpmcRing<T>::claim(
+    std::atomic<size_type>& index, size_type offset, size_type wanted,
+    size_type& count) noexcept {
+  count = 0;
+  if (wanted == 0) {
+    return 0;
+  }
+
+  size_type position = index.load(std::memory_order_relaxed);
+  for (;;) {
+    const size_type sequence =
+        cell(position).sequence.load(std::memory_order_acquire);
+    const auto lag = static_cast<std::ptrdiff_t>(sequence - position - offset);
+    if (lag < 0) {
+      return position;  // Full (or empty): the slot is a lap behind
+    }
+    if (lag > 0) {
+      // Another thread claimed `position` already
+      position = index.load(std::memory_order_relaxed);
+      continue;
+    }
+
+    // Extend the run over the following slots that are ready too
+    size_type run = 1;
+    while (run < wanted &&
+           cell(position + run).sequence.load(std::memory_order_acquire) ==
+               position + run + offset) {
+      ++run;
+    }
+
+    if (index.compare_exchange_weak(position, position + run,
+                                    std::memory_order_relaxed,
+                                    std::memory_order_relaxed)) {
+      count = run;
+      return position;
+    }
+  }
+}
+
+template <typename T>
+template <typename... Args>
+bool MpmcRing<T>::try_emplace(Args&&... args) {
+  if constexpr (std::is_nothrow_constructible_v<value_type, Args&&...>) {
+    size_type count;
+    const size_type position = claim(tail_, 0, 1, count);
+    if (count == 0) {
+      return false;
+    }
+
+    Cell& slot = cell(position);
+    std::construct_at(element(slot), std::forward<Args>(args)...);
+    slot.sequence.store(position + 1, std::memory_order_release);
+    return true;
+  } else {
+    // Construct first: a claimed slot must be published, or consumers
+    // would wait on it forever
+    value_type value(std::forward<Args>(args)...);
+    return try_emplace(std::move(value));
+  }
+}
+
+template <typename T>
+typename MpmcRing<T>::size_type MpmcRing<T>::push_n(
+    std::span<value_type> values) {
+  size_type count;
+  const size_type position = claim(tail_, 0, values.size(), count);
+
+  for (size_type i = 0; i < count; ++i) {
+    Cell& slot = cell(position + i);
+    std::construct_at(element(slot), std::move(values[i]));
+    slot.sequence.store(position + i + 1, std::memory_order_release);
+  }
+  return count;
+}
+
+template <typename T>
+std::optional<T> MpmcRing<T>::try_pop() {
+  size_type count;
+  const size_type position = claim(head_, 1, 1, count);
+  if (count == 0) {
+    return std::nullopt;
+  }
+
+  Cell& slot = cell(position);
+  std::optional<value_type> value(std::move(*element(slot)));
+  std::destroy_at(element(slot));
+  slot.sequence.store(position + mask_ + 1, std::memory_order_release);
+  return value;
+}
+
+template <typename T>
+bool MpmcRing<T>::try_pop(value_type& out)
+  requires std::is_nothrow_move_assignable_v<value_type>
+{
+  size_type count;
+  const size_type position = claim(head_, 1, 1, count);
+  if (count == 0) {
+    return false;
+  }
+
+  Cell& slot = cell(position);
+  out = std::move(*element(slot));
+  std::destroy_at(element(slot));
+  slot.sequence.store(position + mask_ + 1, std::memory_order_release);
+  return true;
+}
+
+template <typename T>
+typename MpmcRing<T>::size_type MpmcRing<T>::pop_n(std::span<value_type> out)
+  requires std::is_nothrow_move_assignable_v<value_type>
+{
+  size_type count;
+  const size_type position = claim(head_, 1, out.size(), count);
+
+  for (size_type i = 0; i < count; ++i) {
+    Cell& slot = cell(position + i);
+    out[i] = std::move(*element(slot));
+    std::destroy_at(element(slot));
+    slot.sequence.store(position + i + mask_ + 1, std::memory_order_release);
+  }
+  return count;
+}
+
+}  // namespace intns::task
@@ -0,0 +1,304 @@
+#include "Scheduler.hpp"
+
+#include <algorithm>
+#include <stdexcept>
+
+#include "WorkStealingDeque.hpp"
+
+namespace intns::task {
+
+namespace detail {
+
+/**
+ * @brief State owned by one worker thread.
+ */
+struct alignas(memory::kCacheLineSize) Worker {
+  Worker(Scheduler& owner, uint32_t number, const SchedulerOptions& options)
+      : scheduler(&owner),
+        index(number),
+        deque(options.deque_capacity),
+        scratch(options.scratch_size),
+        rng(0x9e3779b97f4a7c15ull * (number + 1)) {}
+
+  Scheduler* scheduler;  // Scheduler the worker belongs to
+  uint32_t index;        // Position in Scheduler::workers_
+
+  // Tasks spawned by this worker, stolen from by the others
+  WorkStealingDeque<Job*> deque;
+
+  // Restored after every task
+  memory::StackAllocator scratch;
+
+  // Free jobs of this worker's pool, only touched by the worker
+  Job* free_jobs = nullptr;
+
+  // Jobs of this pool released by other threads, reclaimed in one exchange
+  alignas(memory::kCacheLineSize) std::atomic<Job*> remote_free{nullptr};
+
+  // Every block of jobs the pool has allocated
+  std::vector<std::unique_ptr<Job[]>> job_blocks;
+
+  // Picks the first victim to steal from
+  uint64_t rng;
+};
+
+}  // namespace detail
+
+namespace {
+
+// Jobs allocated at once when a worker's pool runs dry
+constexpr size_t kJobsPerBlock = 64;
+
+// Failed searches for work before an idle worker goes to sleep
+constexpr int kIdleSpins = 64;
+
+// The worker running on this thread, if any
+thread_local detail::Worker* tls_worker = nullptr;
+
+}  // namespace
+
+Scheduler::Scheduler(SchedulerOptions options) {
+  size_t thread_count = options.thread_count;
+  if (thread_count == 0) {
+    thread_count = std::max(1u, std::thread::hardware_concurrency());
+  }
+
+  workers_.reserve(thread_count);
+  for (size_t i = 0; i < thread_count; ++i) {
+    workers_.push_back(std::make_unique<detail::Worker>(
+        *this, static_cast<uint32_t>(i), options));
+  }
+
+  threads_.reserve(thread_count);
+  try {
+    for (auto& worker : workers_) {
+      threads_.emplace_back([this, &worker] { run_worker(*worker); });
+    }
+  } catch (...) {
+    stop_.store(true);
+    wake_epoch_.fetch_add(1);
+    wake_epoch_.notify_all();
+    threads_.clear();
+    throw;
+  }
+}
+
+Scheduler::~Scheduler() {
+  stop_.store(true);
+  wake_epoch_.fetch_add(1);
+  wake_epoch_.notify_all();
+  threads_.clear();  // Joins, after the workers ran out of work
+}
+
+size_t Scheduler::current_worker() const noexcept {
+  const detail::Worker* self = local_worker();
+  return self ? self->index : kNotAWorker;
+}
+
+memory::StackAllocator& Scheduler::scratch() {
+  detail::Worker* self = local_worker();
+  if (!self) {
+    throw std::logic_error(
+        "Scheduler::scratch: not called from one of the scheduler's workers");
+  }
+  return self->scratch;
+}
+
+void Scheduler::wait(TaskGroup& group) {
+  if (detail::Worker* self = local_worker()) {
+    // Run other tasks, most likely the group's own, until it is done
+    while (!group.done()) {
+      if (detail::Job* job = find_job(*self)) {
+        run_job(*self, job);
+      } else {
+        std::this_thread::yield();
+      }
+    }
+  } else {
+    while (!group.done()) {
+      const uint32_t epoch = completion_epoch_.load();
+      waiting_.fetch_add(1);
+      std::atomic_thread_fence(std::memory_order_seq_cst);
+      if (!group.done()) {
+        completion_epoch_.wait(epoch);
+      }
+      waiting_.fetch_sub(1);
+    }
+  }
+
+  if (group.failed()) {
+    std::exception_ptr error = std::move(group.error_);
+    group.error_ = nullptr;
+    group.failed_.store(false, std::memory_order_release);
+    std::rethrow_exception(error);
+  }
+}
+
+void Scheduler::run_worker(detail::Worker& self) {
+  tls_worker = &self;
+
+  for (;;) {
+    detail::Job* job = find_job(self);
+    for (int spin = 0; !job && spin < kIdleSpins; ++spin) {
+      std::this_thread::yield();
+      job = find_job(self);
+    }
+
+    if (!job) {
+      // Announce the sleep, then look once more: a submit() either sees
+      // sleeping_ or its job is found here
+      const uint32_t epoch = wake_epoch_.load();
+      sleeping_.fetch_add(1);
+      std::atomic_thread_fence(std::memory_order_seq_cst);
+      job = find_job(self);
+      if (!job) {
+        if (stop_.load()) {
+          sleeping_.fetch_sub(1);
+          break;
+        }
+        wake_epoch_.wait(epoch);
+      }
+      sleeping_.fetch_sub(1);
+      if (!job) {
+        continue;
+      }
+    }
+
+    run_job(self, job);
+  }
+
+  tls_worker = nullptr;
+}
+
+detail::Worker* Scheduler::local_worker() const noexcept {
+  detail::Worker* self = tls_worker;
+  return self && self->scheduler == this ? self : nullptr;
+}
+
+detail::Job* Scheduler::allocate_job() {
+  detail::Worker* self = local_worker();
+  if (!self) {
+    auto* job = new detail::Job;
+    job->owner = detail::kExternalJob;
+    return job;
+  }
+
+  if (!self->free_jobs) {
+    self->free_jobs = self->remote_free.exchange(nullptr,
+                                                 std::memory_order_acquire);
+  }
+  if (!self->free_jobs) {
+    auto block = std::make_unique<detail::Job[]>(kJobsPerBlock);
+    for (size_t i = 0; i < kJobsPerBlock; ++i) {
+      block[i].owner = self->index;
+      block[i].next = i + 1 < kJobsPerBlock ? &block[i + 1] : nullptr;
+    }
+    self->free_jobs = block.get();
+    self->job_blocks.push_back(std::move(block));
+  }
+
+  detail::Job* job = self->free_jobs;
+  self->free_jobs = job->next;
+  return job;
+}
+
+void Scheduler::release_job(detail::Job* job) noexcept {
+  if (job->owner == detail::kExternalJob) {
+    delete job;
+    return;
+  }
+
+  detail::Worker* self = local_worker();
+  if (self && self->index == job->owner) {
+    job->next = self->free_jobs;
+    self->free_jobs = job;
+    return;
+  }
+
+  // Push only; the owner takes the whole list at once, so there is no ABA
+  std::atomic<detail::Job*>& list = workers_[job->owner]->remote_free;
+  detail::Job* head = list.load(std::memory_order_relaxed);
+  do {
+    job->next = head;
+  } while (!list.compare_exchange_weak(head, job, std::memory_order_release,
+                                       std::memory_order_relaxed));
+}
+
+void Scheduler::submit(detail::Job* job) {
+  if (detail::Worker* self = local_worker()) {
+    self->deque.push(job);
+  } else {
+    std::lock_guard lock(injected_mutex_);
+    injected_.push_back(job);
+    injected_count_.fetch_add(1, std::memory_order_release);
+  }
+  notify_work();
+}
+
+void Scheduler::notify_work() noexcept {
+  std::atomic_thread_fence(std::memory_order_seq_cst);
+  if (sleeping_.load(std::memory_order_relaxed) > 0) {
+    wake_epoch_.fetch_add(1);
+    wake_epoch_.notify_one();
+  }
+}
+
+detail::Job* Scheduler::find_job(detail::Worker& self) noexcept {
+  if (auto job = self.deque.pop()) {
+    return *job;
+  }
+
+  if (injected_count_.load(std::memory_order_acquire) > 0) {
+    std::lock_guard lock(injected_mutex_);
+    if (!injected_.empty()) {
+      detail::Job* job = injected_.front();
+      injected_.pop_front();
+      injected_count_.fetch_sub(1, std::memory_order_relaxed);
+      return job;
+    }
+  }
+
+  // xorshift64, so workers don't all hit the same victim first
+  self.rng ^= self.rng << 13;
+  self.rng ^= self.rng >> 7;
+  self.rng ^= self.rng << 17;
+  const size_t count = workers_.size();
+  const size_t first = static_cast<size_t>(self.rng % count);
+  for (size_t i = 0; i < count; ++i) {
+    detail::Worker& victim = *workers_[(first + i) % count];
+    if (&victim == &self) {
+      continue;
+    }
+    if (auto job = victim.deque.steal()) {
+      return *job;
+    }
+  }
+  return nullptr;
+}
+
+void Scheduler::run_job(detail::Worker& self, detail::Job* job) noexcept {
+  TaskGroup& group = *job->group;
+  const auto checkpoint = self.scratch.save_checkpoint();
+
+  try {
+    job->call(*job, true);
+  } catch (...) {
+    group.fail(std::current_exception());
+  }
+
+  // Only this task's allocations are above the checkpoint
+  self.scratch.restore_checkpoint(checkpoint);
+  release_job(job);
+
+  // The group may be destroyed as soon as it reaches zero, don't touch it
+  // after that
+  if (group.pending_.fetch_sub(1, std::memory_order_acq_rel) == 1) {
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    if (waiting_.load(std::memory_order_relaxed) > 0) {
+      completion_epoch_.fetch_add(1);
+      completion_epoch_.notify_all();
+    }
+  }
+}
+
+}  // namespace intns::task
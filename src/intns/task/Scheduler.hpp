@@ -0,0 +1,321 @@
+#ifndef INTNS_TASK_SCHEDULER_HPP
+#define INTNS_TASK_SCHEDULER_HPP
+
+#include <atomic>
+#include <concepts>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <exception>
+#include <limits>
+#include <memory>
+#include <mutex>
+#include <new>
+#include <thread>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include "../memory/Alignment.hpp"
+#include "../memory/StackAllocator.hpp"
+
+namespace intns::task {
+
+class Scheduler;
+class TaskGraph;
+
+/**
+ * @brief Tracks a set of tasks spawned on a Scheduler so they can be waited
+ * for together (fork-join).
+ *
+ * The first exception thrown by any of its tasks is kept and rethrown by
+ * Scheduler::wait(); the group can then be reused.
+ *
+ * @note A group must outlive its tasks: wait for it before destroying it.
+ */
+class TaskGroup {
+ public:
+  TaskGroup() = default;
+
+  TaskGroup(const TaskGroup&) = delete;
+  TaskGroup& operator=(const TaskGroup&) = delete;
+
+  /**
+   * @brief Checks whether every task spawned so far has finished.
+   */
+  [[nodiscard]] bool done() const noexcept {
+    return pending_.load(std::memory_order_acquire) == 0;
+  }
+
+  /**
+   * @brief Checks whether a task has thrown since the last wait().
+   */
+  [[nodiscard]] bool failed() const noexcept {
+    return failed_.load(std::memory_order_acquire);
+  }
+
+ private:
+  friend class Scheduler;
+  friend class TaskGraph;
+
+  // Keeps the first exception, later ones are dropped
+  void fail(std::exception_ptr error) noexcept {
+    if (!failed_.exchange(true, std::memory_order_acq_rel)) {
+      error_ = std::move(error);
+    }
+  }
+
+  std::atomic<size_t> pending_{0};  ///< Tasks spawned but not finished.
+  std::atomic<bool> failed_{false};  ///< Whether error_ is set.
+  std::exception_ptr error_;         ///< First exception thrown by a task.
+};
+
+/**
+ * @brief Settings for Scheduler.
+ */
+struct SchedulerOptions {
+  // Worker threads; 0 uses std::thread::hardware_concurrency()
+  size_t thread_count = 0;
+
+  // Bytes of each worker's scratch StackAllocator, see Scheduler::scratch()
+  size_t scratch_size = 256 * 1024;
+
+  // Initial capacity of each worker's deque, grown as needed
+  size_t deque_capacity = 1024;
+};
+
+namespace detail {
+
+/**
+ * @brief A spawned task: its callable, stored inline when small enough, and
+ * the group it reports to. Two cache lines, recycled by the worker pools.
+ */
+struct alignas(memory::kCacheLineSize) Job {
+  // Runs (if `run`) and destroys the callable
+  void (*call)(Job& job, bool run) = nullptr;
+
+  TaskGroup* group = nullptr;  // Group to notify when done
+  Job* next = nullptr;         // Free list link
+  uint32_t owner = 0;          // Worker whose pool it belongs to
+
+  static constexpr size_t kStorageSize = 96;
+  alignas(std::max_align_t) std::byte storage[kStorageSize];
+};
+
+static_assert(sizeof(Job) == 2 * memory::kCacheLineSize);
+
+// Jobs created off the worker threads, heap allocated
+inline constexpr uint32_t kExternalJob = std::numeric_limits<uint32_t>::max();
+
+// Stores a callable in a job, inline if it fits
+template <typename F>
+void store_callable(Job& job, F&& fn);
+
+struct Worker;
+
+}  // namespace detail
+
+/**
+ * @brief A work-stealing task scheduler.
+ *
+ * Each worker thread owns a Chase-Lev deque: tasks it spawns are pushed and
+ * popped at the bottom of its own deque without contention, and idle
+ * workers steal the oldest tasks from the top of the others'. Tasks spawned
+ * from other threads go through a shared queue. Idle workers spin briefly,
+ * then sleep until new work arrives.
+ *
+ * Job descriptors come from per-worker pools without locks: a worker
+ * allocates from its own free list, and jobs that finish on another worker
+ * are pushed back onto an atomic list the owner reclaims in one exchange.
+ * Each worker also owns a scratch StackAllocator, restored after every task,
+ * for temporary allocations inside tasks.
+ *
+ * @section Usage
+ * @code
+ * Scheduler scheduler;
+ * scheduler.parallel_for(0, file.chunk_count(), [&](size_t first,
+ *                                                     size_t last) {
+ *   for (size_t i = first; i < last; ++i) {
+ *     parse(file.load(i));
+ *   }
+ * });
+ *
+ * TaskGroup group;
+ * scheduler.spawn(group, [] { load_textures(); });
+ * scheduler.spawn(group, [] { load_meshes(); });
+ * scheduler.wait(group);
+ * @endcode
+ *
+ * @note All public methods are thread-safe. Waiting on a worker thread runs
+ * other tasks until the group is done; waiting on any other thread blocks.
+ *
+ * @section Exception Safety
+ * An exception thrown by a task is caught and rethrown by wait() on its
+ * group. Spawning throws std::bad_alloc if a job or deque slot cannot be
+ * allocated.
+ */
+class Scheduler {
+ public:
+  /**
+   * @brief Returned by current_worker() off the worker threads.
+   */
+  static constexpr size_t kNotAWorker = std::numeric_limits<size_t>::max();
+
+  /**
+   * @brief Starts the worker threads.
+   *
+   * @param options Thread count, scratch size and deque capacity.
+   * @throws std::runtime_error If a scratch allocator cannot be allocated.
+   * @throws std::system_error If a thread cannot be started.
+   */
+  explicit Scheduler(SchedulerOptions options = {});
+
+  /**
+   * @brief Runs every task already spawned, then joins the workers.
+   */
+  ~Scheduler();
+
+  // Workers refer to the scheduler by address
+  Scheduler(const Scheduler&) = delete;
+  Scheduler& operator=(const Scheduler&) = delete;
+  Scheduler(Scheduler&&) = delete;
+  Scheduler& operator=(Scheduler&&) = delete;
+
+  /**
+   * @brief Returns the number of worker threads.
+   */
+  [[nodiscard]] size_t thread_count() const noexcept {
+    return workers_.size();
+  }
+
+  /**
+   * @brief Schedules a task as part of a group.
+   *
+   * @param group Group to add the task to, waited for with wait().
+   * @param fn Callable taking no arguments, moved into the task. Callables
+   * of up to 96 bytes are stored in the job itself, larger ones on the heap.
+   * @throws std::bad_alloc If the task cannot be allocated.
+   */
+  template <std::invocable F>
+  void spawn(TaskGroup& group, F&& fn);
+
+  /**
+   * @brief Waits for every task of a group, including tasks they spawned
+   * into it.
+   *
+   * On a worker thread, runs other tasks while waiting.
+   *
+   * @param group The group to wait for.
+   * @throws Any exception thrown by one of the group's tasks (the first, if
+   * several threw).
+   */
+  void wait(TaskGroup& group);
+
+  /**
+   * @brief Runs each callable as a task and waits for all of them.
+   *
+   * @param fns Callables taking no arguments.
+   * @throws Any exception thrown by one of them.
+   */
+  template <std::invocable... F>
+  void invoke(F&&... fns);
+
+  /**
+   * @brief Calls `body(first, last)` over subranges covering [begin, end),
+   * in parallel, and waits for all of them.
+   *
+   * The range is split in halves recursively down to `grain` elements,
+   * spawning one half each time, so idle workers steal large subranges and
+   * split them further.
+   *
+   * @param begin First index.
+   * @param end One past the last index.
+   * @param body Callable taking (size_t first, size_t last); must be safe to
+   * call concurrently.
+   * @param grain Largest subrange passed to `body`; 0 picks one giving about
+   * eight subranges per worker.
+   * @throws Any exception thrown by `body`.
+   */
+  template <typename F>
+    requires std::invocable<F&, size_t, size_t>
+  void parallel_for(size_t begin, size_t end, F&& body, size_t grain = 0);
+
+  /**
+   * @brief Returns the index of the calling worker thread.
+   *
+   * @return The index, below thread_count(), or kNotAWorker if the caller is
+   * not one of this scheduler's workers.
+   */
+  [[nodiscard]] size_t current_worker() const noexcept;
+
+  /**
+   * @brief Returns the calling worker's scratch allocator.
+   *
+   * Allocations made by a task are released once it returns (the allocator
+   * is restored to its state before the task ran), so tasks can use it for
+   * temporary buffers without freeing them.
+   *
+   * @return The allocator, only to be used by the calling thread.
+   * @throws std::logic_error If the caller is not one of this scheduler's
+   * workers.
+   */
+  [[nodiscard]] memory::StackAllocator& scratch();
+
+ private:
+  // Body of each worker thread
+  void run_worker(detail::Worker& self);
+
+  // Returns the calling thread's worker, or nullptr
+  [[nodiscard]] detail::Worker* local_worker() const noexcept;
+
+  // Takes a job from the calling worker's pool, or the heap off the workers
+  [[nodiscard]] detail::Job* allocate_job();
+
+  // Returns a job to the pool it came from
+  void release_job(detail::Job* job) noexcept;
+
+  // Queues a job on the calling worker's deque, or the shared queue
+  void submit(detail::Job* job);
+
+  // Wakes a sleeping worker, if any
+  void notify_work() noexcept;
+
+  // Pops, then takes from the shared queue, then steals
+  [[nodiscard]] detail::Job* find_job(detail::Worker& self) noexcept;
+
+  // Runs a job on `self`, reports to its group and recycles it
+  void run_job(detail::Worker& self, detail::Job* job) noexcept;
+
+  // Splits [begin, end) for parallel_for(), running the first half inline
+  template <typename F>
+  void split_range(TaskGroup& group, size_t begin, size_t end, size_t grain,
+                   F& body);
+
+  // Every worker, indexed by worker number
+  std::vector<std::unique_ptr<detail::Worker>> workers_;
+
+  // Jobs spawned off the worker threads
+  std::mutex injected_mutex_;
+  std::deque<detail::Job*> injected_;
+  std::atomic<size_t> injected_count_{0};
+
+  // Sleeping workers wait for wake_epoch_ to change
+  std::atomic<uint32_t> wake_epoch_{0};
+  std::atomic<uint32_t> sleeping_{0};
+
+  // Threads blocked in wait() wait for completion_epoch_ to change
+  std::atomic<uint32_t> completion_epoch_{0};
+  std::atomic<uint32_t> waiting_{0};
+
+  // Set by the destructor, workers exit once out of work
+  std::atomic<bool> stop_{false};
+
+  // Started last, joined first
+  std::vector<std::jthread> threads_;
+};
+
+}  // namespace intns::task
+
+#include "Scheduler.tpp"
+
+#endif  // INTNS_TASK_SCHEDULER_HPP
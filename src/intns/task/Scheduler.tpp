@@ -0,0 +1,118 @@
+#include "Scheduler.hpp"
+
+#include <algorithm>
+#include <functional>
+
+namespace intns::task {
+
+namespace detail {
+
+template <typename F>
+void store_callable(Job& job, F&& fn) {
+  using Fn = std::decay_t<F>;
+
+  // Jobs never move, so whatever fits is stored in place
+  if constexpr (sizeof(Fn) <= Job::kStorageSize &&
+                alignof(Fn) <= alignof(std::max_align_t)) {
+    ::new (static_cast<void*>(job.storage)) Fn(std::forward<F>(fn));
+    job.call = [](Job& self, bool run) {
+      Fn& stored = *std::launder(reinterpret_cast<Fn*>(self.storage));
+      struct Destroy {
+        Fn& fn;
+        ~Destroy() { fn.~Fn(); }
+      } destroy{stored};
+      if (run) {
+        std::invoke(stored);
+      }
+    };
+  } else {
+    Fn* heap = new Fn(std::forward<F>(fn));
+    ::new (static_cast<void*>(job.storage)) Fn*(heap);
+    job.call = [](Job& self, bool run) {
+      std::unique_ptr<Fn> stored(
+          *std::launder(reinterpret_cast<Fn**>(self.storage)));
+      if (run) {
+        std::invoke(*stored);
+      }
+    };
+  }
+}
+
+}  // namespace detail
+
+template <std::invocable F>
+void Scheduler::spawn(TaskGroup& group, F&& fn) {
+  detail::Job* job = allocate_job();
+  try {
+    detail::store_callable(*job, std::forward<F>(fn));
+  } catch (...) {
+    release_job(job);
+    throw;
+  }
+
+  // Counted before it can run, so the group can't reach zero early
+  job->group = &group;
+  group.pending_.fetch_add(1, std::memory_order_relaxed);
+
+  try {
+    submit(job);
+  } catch (...) {
+    group.pending_.fetch_sub(1, std::memory_order_acq_rel);
+    job->call(*job, false);
+    release_job(job);
+    throw;
+  }
+}
+
+template <std::invocable... F>
+void Scheduler::invoke(F&&... fns) {
+  TaskGroup group;
+  try {
+    (spawn(group, std::forward<F>(fns)), ...);
+  } catch (...) {
+    group.fail(std::current_exception());
+  }
+  wait(group);
+}
+
+template <typename F>
+  requires std::invocable<F&, size_t, size_t>
+void Scheduler::parallel_for(size_t begin, size_t end, F&& body,
+                             size_t grain) {
+  if (begin >= end) {
+    return;
+  }
+  if (grain == 0) {
+    grain = std::max<size_t>(1, (end - begin) / (thread_count() * 8));
+  }
+
+  TaskGroup group;
+  if (local_worker()) {
+    // Take part in the work instead of just waiting for it
+    try {
+      split_range(group, begin, end, grain, body);
+    } catch (...) {
+      group.fail(std::current_exception());
+    }
+  } else {
+    spawn(group, [this, &group, &body, begin, end, grain] {
+      split_range(group, begin, end, grain, body);
+    });
+  }
+  wait(group);
+}
+
+template <typename F>
+void Scheduler::split_range(TaskGroup& group, size_t begin, size_t end,
+                            size_t grain, F& body) {
+  while (end - begin > grain) {
+    const size_t middle = begin + (end - begin) / 2;
+    spawn(group, [this, &group, &body, middle, end, grain] {
+      split_range(group, middle, end, grain, body);
+    });
+    end = middle;
+  }
+  body(begin, end);
+}
+
+}  // namespace intns::task
@@ -0,0 +1,171 @@
+#ifndef INTNS_TASK_SPSCRING_HPP
+#define INTNS_TASK_SPSCRING_HPP
+
+#include <atomic>
+#include <cstddef>
+#include <memory>
+#include <new>
+#include <optional>
+#include <span>
+#include <type_traits>
+#include <utility>
+
+#include "../memory/Alignment.hpp"
+
+namespace intns::task {
+
+/**
+ * @brief A bounded, lock-free single-producer single-consumer ring buffer.
+ *
+ * Hands objects (e.g. buffers taken from an ObjectPool) from one pipeline
+ * stage to the next without locks or allocation. The producer's and
+ * consumer's indices live on separate cache lines, and each side keeps a
+ * cached copy of the other's index so it only reads the shared one when the
+ * ring looks full (or empty).
+ *
+ * @tparam T The element type, nothrow move constructible.
+ *
+ * @note Push methods must only be called by one producer thread and pop
+ * methods by one consumer thread at a time; size() and empty() may be
+ * called from anywhere and are approximate while either side is active.
+ */
+template <typename T>
+class SpscRing {
+  static_assert(std::is_nothrow_move_constructible_v<T>,
+                "SpscRing elements must be nothrow move constructible");
+
+ public:
+  using value_type = T;
+  using size_type = std::size_t;
+
+  /**
+   * @brief Creates an empty ring.
+   *
+   * @param capacity Maximum number of elements, a power of two.
+   * @throws std::invalid_argument If capacity is not a power of two.
+   */
+  explicit SpscRing(size_type capacity);
+
+  /**
+   * @brief Destroys the elements still in the ring.
+   */
+  ~SpscRing();
+
+  SpscRing(const SpscRing&) = delete;
+  SpscRing& operator=(const SpscRing&) = delete;
+  SpscRing(SpscRing&&) = delete;
+  SpscRing& operator=(SpscRing&&) = delete;
+
+  /**
+   * @brief Constructs an element at the back. Producer only.
+   *
+   * @param args Constructor arguments.
+   * @return true if it was added; false if the ring is full.
+   */
+  template <typename... Args>
+  [[nodiscard]] bool try_emplace(Args&&... args);
+
+  /**
+   * @brief Moves an element to the back. Producer only.
+   *
+   * @param value The element; left untouched if the ring is full.
+   * @return true if it was added; false if the ring is full.
+   */
+  [[nodiscard]] bool try_push(value_type&& value) {
+    return try_emplace(std::move(value));
+  }
+
+  /**
+   * @brief Moves as many elements as fit to the back, publishing them at
+   * once. Producer only.
+   *
+   * @param values The elements; those added are moved from.
+   * @return The number of elements added, from the front of `values`.
+   */
+  size_type push_n(std::span<value_type> values);
+
+  /**
+   * @brief Removes the front element. Consumer only.
+   *
+   * @return The element, or std::nullopt if the ring is empty.
+   */
+  [[nodiscard]] std::optional<value_type> try_pop();
+
+  /**
+   * @brief Removes the front element into `out`. Consumer only.
+   *
+   * @param out Move-assigned the element if there is one.
+   * @return true if an element was removed; false if the ring is empty.
+   */
+  [[nodiscard]] bool try_pop(value_type& out)
+    requires std::is_nothrow_move_assignable_v<value_type>;
+
+  /**
+   * @brief Removes up to out.size() elements from the front, releasing
+   * their slots at once. Consumer only. Existing elements of `out` are
+   * move-assigned over.
+   *
+   * @param out The destination.
+   * @return The number of elements removed, stored at the front of `out`.
+   */
+  size_type pop_n(std::span<value_type> out)
+    requires std::is_nothrow_move_assignable_v<value_type>;
+
+  /**
+   * @brief Returns the number of elements, approximate while the producer or
+   * consumer is active.
+   */
+  [[nodiscard]] size_type size() const noexcept {
+    const size_type tail = tail_.load(std::memory_order_acquire);
+    const size_type head = head_.load(std::memory_order_acquire);
+    return tail - head;
+  }
+
+  /**
+   * @brief Checks whether the ring is empty, approximate like size().
+   */
+  [[nodiscard]] bool empty() const noexcept { return size() == 0; }
+
+  /**
+   * @brief Returns the maximum number of elements.
+   */
+  [[nodiscard]] size_type capacity() const noexcept { return mask_ + 1; }
+
+ private:
+  /**
+   * @brief Uninitialized storage for one element.
+   */
+  struct Slot {
+    alignas(value_type) std::byte storage[sizeof(value_type)];
+  };
+
+  [[nodiscard]] value_type* element(size_type index) noexcept {
+    return std::launder(
+        reinterpret_cast<value_type*>(slots_[index & mask_].storage));
+  }
+
+  // Free slots as seen by the producer, refreshing cached_head_ if needed
+  [[nodiscard]] size_type free_slots(size_type tail, size_type wanted) noexcept;
+
+  // Filled slots as seen by the consumer, refreshing cached_tail_ if needed
+  [[nodiscard]] size_type filled_slots(size_type head,
+                                       size_type wanted) noexcept;
+
+  // Read-only after construction
+  size_type mask_;
+  std::unique_ptr<Slot[]> slots_;
+
+  // Consumer side: the next element to pop, and the last tail it saw
+  alignas(memory::kCacheLineSize) std::atomic<size_type> head_{0};
+  size_type cached_tail_ = 0;
+
+  // Producer side: the next slot to fill, and the last head it saw
+  alignas(memory::kCacheLineSize) std::atomic<size_type> tail_{0};
+  size_type cached_head_ = 0;
+};
+
+}  // namespace intns::task
+
+#include "SpscRing.tpp"
+
+#endif  // INTNS_TASK_SPSCRING_HPP
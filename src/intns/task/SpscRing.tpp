@@ -0,0 +1,120 @@
+#include "SpscRing.hpp"
+
+#include <algorithm>
+#include <stdexcept>
+
+namespace intns::task {
+
+template <typename T>
+SpscRing<T>::SpscRing(size_type capacity) : mask_(capacity - 1) {
+  if (!memory::is_power_of_two(capacity)) {
+    throw std::invalid_argument(
+        "SpscRing::SpscRing: capacity must be a power of two");
+  }
+  slots_ = std::make_unique<Slot[]>(capacity);
+}
+
+template <typename T>
+SpscRing<T>::~SpscRing() {
+  const size_type tail = tail_.load(std::memory_order_relaxed);
+  for (size_type i = head_.load(std::memory_order_relaxed); i != tail; ++i) {
+    std::destroy_at(element(i));
+  }
+}
+
+template <typename T>
+typename SpscRing<T>::size_type SpscRing<T>::free_slots(
+    size_type tail, size_type wanted) noexcept {
+  size_type available = capacity() - (tail - cached_head_);
+  if (available < wanted) {
+    cached_head_ = head_.load(std::memory_order_acquire);
+    available = capacity() - (tail - cached_head_);
+  }
+  return available;
+}
+
+template <typename T>
+typename SpscRing<T>::size_type SpscRing<T>::filled_slots(
+    size_type head, size_type wanted) noexcept {
+  size_type available = cached_tail_ - head;
+  if (available < wanted) {
+    cached_tail_ = tail_.load(std::memory_order_acquire);
+    available = cached_tail_ - head;
+  }
+  return available;
+}
+
+template <typename T>
+template <typename... Args>
+bool SpscRing<T>::try_emplace(Args&&... args) {
+  const size_type tail = tail_.load(std::memory_order_relaxed);
+  if (free_slots(tail, 1) == 0) {
+    return false;
+  }
+
+  std::construct_at(element(tail), std::forward<Args>(args)...);
+  tail_.store(tail + 1, std::memory_order_release);
+  return true;
+}
+
+template <typename T>
+typename SpscRing<T>::size_type SpscRing<T>::push_n(
+    std::span<value_type> values) {
+  const size_type tail = tail_.load(std::memory_order_relaxed);
+  const size_type count =
+      std::min(values.size(), free_slots(tail, values.size()));
+
+  for (size_type i = 0; i < count; ++i) {
+    std::construct_at(element(tail + i), std::move(values[i]));
+  }
+  tail_.store(tail + count, std::memory_order_release);
+  return count;
+}
+
+template <typename T>
+std::optional<T> SpscRing<T>::try_pop() {
+  const size_type head = head_.load(std::memory_order_relaxed);
+  if (filled_slots(head, 1) == 0) {
+    return std::nullopt;
+  }
+
+  value_type* slot = element(head);
+  std::optional<value_type> value(std::move(*slot));
+  std::destroy_at(slot);
+  head_.store(head + 1, std::memory_order_release);
+  return value;
+}
+
+template <typename T>
+bool SpscRing<T>::try_pop(value_type& out)
+  requires std::is_nothrow_move_assignable_v<value_type>
+{
+  const size_type head = head_.load(std::memory_order_relaxed);
+  if (filled_slots(head, 1) == 0) {
+    return false;
+  }
+
+  value_type* slot = element(head);
+  out = std::move(*slot);
+  std::destroy_at(slot);
+  head_.store(head + 1, std::memory_order_release);
+  return true;
+}
+
+template <typename T>
+typename SpscRing<T>::size_type SpscRing<T>::pop_n(std::span<value_type> out)
+  requires std::is_nothrow_move_assignable_v<value_type>
+{
+  const size_type head = head_.load(std::memory_order_relaxed);
+  const size_type count = std::min(out.size(), filled_slots(head, out.size()));
+
+  for (size_type i = 0; i < count; ++i) {
+    value_type* slot = element(head + i);
+    out[i] = std::move(*slot);
+    std::destroy_at(slot);
+  }
+  head_.store(head + count, std::memory_order_release);
+  return count;
+}
+
+}  // namespace intns::task
@@ -0,0 +1,92 @@
+#include "TaskGraph.hpp"
+
+#include <algorithm>
+#include <stdexcept>
+#include <string>
+
+namespace intns::task {
+
+void TaskGraph::precede(node_type before, node_type after) {
+  if (before >= nodes_.size() || after >= nodes_.size()) {
+    throw std::out_of_range("TaskGraph::precede: node " +
+                            std::to_string(std::max(before, after)) +
+                            " is not in the graph");
+  }
+  if (before == after) {
+    throw std::invalid_argument(
+        "TaskGraph::precede: a node cannot precede itself");
+  }
+
+  nodes_[before].successors.push_back(after);
+  ++nodes_[after].predecessors;
+  scheduled_.reset();
+}
+
+void TaskGraph::run(Scheduler& scheduler) {
+  if (nodes_.empty()) {
+    return;
+  }
+
+  if (!scheduled_) {
+    check_acyclic();
+    scheduled_ = std::make_unique<std::atomic<size_t>[]>(nodes_.size());
+  }
+  for (size_t i = 0; i < nodes_.size(); ++i) {
+    scheduled_[i].store(nodes_[i].predecessors, std::memory_order_relaxed);
+  }
+
+  TaskGroup group;
+  try {
+    for (node_type i = 0; i < nodes_.size(); ++i) {
+      if (nodes_[i].predecessors == 0) {
+        schedule(scheduler, group, i);
+      }
+    }
+  } catch (...) {
+    group.fail(std::current_exception());
+  }
+  scheduler.wait(group);
+}
+
+void TaskGraph::schedule(Scheduler& scheduler, TaskGroup& group,
+                         node_type node) {
+  scheduler.spawn(group, [this, &scheduler, &group, node] {
+    // A throw skips the successors, they never reach zero
+    nodes_[node].work();
+    for (const node_type next : nodes_[node].successors) {
+      if (scheduled_[next].fetch_sub(1, std::memory_order_acq_rel) == 1) {
+        schedule(scheduler, group, next);
+      }
+    }
+  });
+}
+
+void TaskGraph::check_acyclic() const {
+  // Kahn's algorithm: every node is reached iff there is no cycle
+  std::vector<size_t> remaining(nodes_.size());
+  std::vector<node_type> ready;
+  for (node_type i = 0; i < nodes_.size(); ++i) {
+    remaining[i] = nodes_[i].predecessors;
+    if (remaining[i] == 0) {
+      ready.push_back(i);
+    }
+  }
+
+  size_t reached = 0;
+  while (!ready.empty()) {
+    const node_type node = ready.back();
+    ready.pop_back();
+    ++reached;
+    for (const node_type next : nodes_[node].successors) {
+      if (--remaining[next] == 0) {
+        ready.push_back(next);
+      }
+    }
+  }
+
+  if (reached != nodes_.size()) {
+    throw std::logic_error("TaskGraph::run: the dependencies form a cycle");
+  }
+}
+
+}  // namespace intns::task
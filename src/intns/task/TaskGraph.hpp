@@ -0,0 +1,134 @@
+#ifndef INTNS_TASK_TASKGRAPH_HPP
+#define INTNS_TASK_TASKGRAPH_HPP
+
+#include <atomic>
+#include <concepts>
+#include <cstddef>
+#include <functional>
+#include <memory>
+#include <utility>
+#include <vector>
+
+#include "Scheduler.hpp"
+
+namespace intns::task {
+
+/**
+ * @brief A reusable graph of tasks with dependencies, run on a Scheduler.
+ *
+ * Each node runs once its predecessors have finished; nodes with no ordering
+ * between them run in parallel. The graph is built once and can be run any
+ * number of times.
+ *
+ * @section Usage
+ * @code
+ * TaskGraph graph;
+ * auto load = graph.add([] { load_chunks(); });
+ * auto meshes = graph.add([] { parse_meshes(); });
+ * auto textures = graph.add([] { parse_textures(); });
+ * auto upload = graph.add([] { upload_to_gpu(); });
+ * graph.precede(load, meshes);
+ * graph.precede(load, textures);
+ * graph.precede(meshes, upload);
+ * graph.precede(textures, upload);
+ * graph.run(scheduler);
+ * @endcode
+ *
+ * @note Building the graph is not thread-safe, and a graph may only be run
+ * by one thread at a time.
+ *
+ * @section Exception Safety
+ * If a node throws, the nodes depending on it are skipped, and run()
+ * rethrows the exception once the others have finished.
+ */
+class TaskGraph {
+ public:
+  /**
+   * @brief Identifies a node, as returned by add().
+   */
+  using node_type = size_t;
+
+  TaskGraph() = default;
+
+  TaskGraph(const TaskGraph&) = delete;
+  TaskGraph& operator=(const TaskGraph&) = delete;
+  TaskGraph(TaskGraph&&) noexcept = default;
+  TaskGraph& operator=(TaskGraph&&) noexcept = default;
+
+  /**
+   * @brief Adds a node.
+   *
+   * @param fn Callable taking no arguments, run once per run().
+   * @return The node.
+   */
+  template <std::invocable F>
+  node_type add(F&& fn) {
+    nodes_.push_back(Node{std::function<void()>(std::forward<F>(fn)), {}, 0});
+    scheduled_.reset();
+    return nodes_.size() - 1;
+  }
+
+  /**
+   * @brief Makes `after` wait for `before` to finish.
+   *
+   * @param before The node to run first.
+   * @param after The node to run once `before` has finished.
+   * @throws std::out_of_range If either node is not part of the graph.
+   * @throws std::invalid_argument If both are the same node.
+   */
+  void precede(node_type before, node_type after);
+
+  /**
+   * @brief Runs every node, respecting dependencies, and waits for them.
+   *
+   * @param scheduler The scheduler to run the nodes on.
+   * @throws std::logic_error If the dependencies contain a cycle; no node
+   * is run.
+   * @throws Any exception thrown by a node (the first, if several threw).
+   */
+  void run(Scheduler& scheduler);
+
+  /**
+   * @brief Returns the number of nodes.
+   */
+  [[nodiscard]] size_t size() const noexcept { return nodes_.size(); }
+
+  /**
+   * @brief Checks whether the graph has no nodes.
+   */
+  [[nodiscard]] bool empty() const noexcept { return nodes_.empty(); }
+
+  /**
+   * @brief Removes every node.
+   */
+  void clear() noexcept {
+    nodes_.clear();
+    scheduled_.reset();
+  }
+
+ private:
+  /**
+   * @brief A node's work and the nodes waiting for it.
+   */
+  struct Node {
+    std::function<void()> work;
+    std::vector<node_type> successors;
+    size_t predecessors = 0;
+  };
+
+  // Spawns a node whose predecessors have all finished
+  void schedule(Scheduler& scheduler, TaskGroup& group, node_type node);
+
+  // Throws std::logic_error if the graph has a cycle
+  void check_acyclic() const;
+
+  std::vector<Node> nodes_;  ///< Every node, indexed by node_type.
+
+  // Per node, predecessors yet to finish during run(); also marks the graph
+  // as checked for cycles since it last changed
+  std::unique_ptr<std::atomic<size_t>[]> scheduled_;
+};
+
+}  // namespace intns::task
+
+#endif  // INTNS_TASK_TASKGRAPH_HPP
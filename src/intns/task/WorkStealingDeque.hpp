@@ -0,0 +1,146 @@
+#ifndef INTNS_TASK_WORKSTEALINGDEQUE_HPP
+#define INTNS_TASK_WORKSTEALINGDEQUE_HPP
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <optional>
+#include <type_traits>
+#include <vector>
+
+#include "../memory/Alignment.hpp"
+
+namespace intns::task {
+
+/**
+ * @brief A lock-free Chase-Lev work-stealing deque.
+ *
+ * One owner thread pushes and pops at the bottom, LIFO, so it keeps working
+ * on the most recently spawned (cache-hot) tasks; any number of other threads
+ * steal from the top, FIFO, taking the oldest and usually largest tasks.
+ * The ring grows when full; old rings are kept until the deque is destroyed
+ * since a thief may still be reading one.
+ *
+ * Follows "Correct and Efficient Work-Stealing for Weak Memory Models"
+ * (Lê et al., PPoPP 2013).
+ *
+ * @tparam T The element type, trivially copyable (typically a pointer).
+ *
+ * @note push() and pop() must only be called by the owner thread; steal()
+ * and size() may be called from any thread.
+ */
+template <typename T>
+class WorkStealingDeque {
+  static_assert(std::is_trivially_copyable_v<T>,
+                "WorkStealingDeque elements must be trivially copyable");
+
+ public:
+  using value_type = T;
+  using size_type = std::size_t;
+
+  /**
+   * @brief Creates an empty deque.
+   *
+   * @param capacity Initial capacity, rounded up to a power of two.
+   */
+  explicit WorkStealingDeque(size_type capacity = 1024);
+
+  WorkStealingDeque(const WorkStealingDeque&) = delete;
+  WorkStealingDeque& operator=(const WorkStealingDeque&) = delete;
+  WorkStealingDeque(WorkStealingDeque&&) = delete;
+  WorkStealingDeque& operator=(WorkStealingDeque&&) = delete;
+
+  /**
+   * @brief Pushes an element at the bottom, growing the ring if full.
+   * Owner only.
+   *
+   * @param value The element.
+   * @throws std::bad_alloc If the ring has to grow and allocation fails.
+   */
+  void push(value_type value);
+
+  /**
+   * @brief Pops the most recently pushed element. Owner only.
+   *
+   * @return The element, or std::nullopt if the deque is empty or a thief
+   * took the last one.
+   */
+  [[nodiscard]] std::optional<value_type> pop() noexcept;
+
+  /**
+   * @brief Takes the oldest element. Any thread.
+   *
+   * @return The element, or std::nullopt if the deque is empty or another
+   * thread won the race for it.
+   */
+  [[nodiscard]] std::optional<value_type> steal() noexcept;
+
+  /**
+   * @brief Returns the number of elements, approximate while other threads
+   * push, pop or steal.
+   */
+  [[nodiscard]] size_type size() const noexcept {
+    const int64_t bottom = bottom_.load(std::memory_order_relaxed);
+    const int64_t top = top_.load(std::memory_order_relaxed);
+    return bottom > top ? static_cast<size_type>(bottom - top) : 0;
+  }
+
+  /**
+   * @brief Checks whether the deque is empty, approximate like size().
+   */
+  [[nodiscard]] bool empty() const noexcept { return size() == 0; }
+
+  /**
+   * @brief Returns the current capacity of the ring.
+   */
+  [[nodiscard]] size_type capacity() const noexcept {
+    return array_.load(std::memory_order_relaxed)->capacity;
+  }
+
+ private:
+  /**
+   * @brief A power-of-two ring of elements, indexed modulo its capacity.
+   */
+  struct Array {
+    explicit Array(size_type size)
+        : capacity(size),
+          mask(size - 1),
+          slots(std::make_unique<std::atomic<value_type>[]>(size)) {}
+
+    [[nodiscard]] value_type get(int64_t index) const noexcept {
+      return slots[static_cast<size_type>(index) & mask].load(
+          std::memory_order_relaxed);
+    }
+
+    void put(int64_t index, value_type value) noexcept {
+      slots[static_cast<size_type>(index) & mask].store(
+          value, std::memory_order_relaxed);
+    }
+
+    size_type capacity;
+    size_type mask;
+    std::unique_ptr<std::atomic<value_type>[]> slots;
+  };
+
+  // Copies [top, bottom) into a ring twice the size and publishes it
+  Array* grow(Array* array, int64_t top, int64_t bottom);
+
+  // Stolen from by other threads, on its own cache line
+  alignas(memory::kCacheLineSize) std::atomic<int64_t> top_{0};
+
+  // Pushed and popped by the owner
+  alignas(memory::kCacheLineSize) std::atomic<int64_t> bottom_{0};
+
+  // The current ring
+  std::atomic<Array*> array_;
+
+  // Every ring ever used, owner only; thieves may still read retired ones
+  std::vector<std::unique_ptr<Array>> arrays_;
+};
+
+}  // namespace intns::task
+
+#include "WorkStealingDeque.tpp"
+
+#endif  // INTNS_TASK_WORKSTEALINGDEQUE_HPP
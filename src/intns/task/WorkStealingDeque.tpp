@@ -0,0 +1,88 @@
+#include "WorkStealingDeque.hpp"
+
+#include <algorithm>
+#include <bit>
+
+namespace intns::task {
+
+template <typename T>
+WorkStealingDeque<T>::WorkStealingDeque(size_type capacity) {
+  const size_type size = std::bit_ceil(std::max<size_type>(capacity, 2));
+  arrays_.push_back(std::make_unique<Array>(size));
+  array_.store(arrays_.back().get(), std::memory_order_relaxed);
+}
+
+template <typename T>
+void WorkStealingDeque<T>::push(value_type value) {
+  const int64_t bottom = bottom_.load(std::memory_order_relaxed);
+  const int64_t top = top_.load(std::memory_order_acquire);
+  Array* array = array_.load(std::memory_order_relaxed);
+  if (bottom - top > static_cast<int64_t>(array->capacity) - 1) {
+    array = grow(array, top, bottom);
+  }
+
+  // Release publishes the slot to thieves; the paper's release fence and
+  // relaxed store, in the form sanitizers understand
+  array->put(bottom, value);
+  bottom_.store(bottom + 1, std::memory_order_release);
+}
+
+template <typename T>
+std::optional<T> WorkStealingDeque<T>::pop() noexcept {
+  const int64_t bottom = bottom_.load(std::memory_order_relaxed) - 1;
+  Array* array = array_.load(std::memory_order_relaxed);
+  bottom_.store(bottom, std::memory_order_relaxed);
+  std::atomic_thread_fence(std::memory_order_seq_cst);
+  int64_t top = top_.load(std::memory_order_relaxed);
+
+  if (top > bottom) {
+    // Already empty, undo the reservation
+    bottom_.store(bottom + 1, std::memory_order_relaxed);
+    return std::nullopt;
+  }
+
+  std::optional<value_type> value = array->get(bottom);
+  if (top == bottom) {
+    // Last element, race thieves for it
+    if (!top_.compare_exchange_strong(top, top + 1, std::memory_order_seq_cst,
+                                      std::memory_order_relaxed)) {
+      value.reset();
+    }
+    bottom_.store(bottom + 1, std::memory_order_relaxed);
+  }
+  return value;
+}
+
+template <typename T>
+std::optional<T> WorkStealingDeque<T>::steal() noexcept {
+  int64_t top = top_.load(std::memory_order_acquire);
+  std::atomic_thread_fence(std::memory_order_seq_cst);
+  const int64_t bottom = bottom_.load(std::memory_order_acquire);
+  if (top >= bottom) {
+    return std::nullopt;
+  }
+
+  // Read before claiming; the owner never overwrites slots in [top, bottom)
+  const value_type value = array_.load(std::memory_order_acquire)->get(top);
+  if (!top_.compare_exchange_strong(top, top + 1, std::memory_order_seq_cst,
+                                    std::memory_order_relaxed)) {
+    return std::nullopt;
+  }
+  return value;
+}
+
+template <typename T>
+typename WorkStealingDeque<T>::Array* WorkStealingDeque<T>::grow(
+    Array* array, int64_t top, int64_t bottom) {
+  auto grown = std::make_unique<Array>(array->capacity * 2);
+  for (int64_t i = top; i < bottom; ++i) {
+    grown->put(i, array->get(i));
+  }
+
+  Array* result = grown.get();
+  arrays_.push_back(std::move(grown));
+  array_.store(result, std::memory_order_release);
+  return result;
+}
+
+}  // namespace intns::task
@@ -0,0 +1,6 @@
+#ifndef INTNS_TRACE_HPP
+#define INTNS_TRACE_HPP
+
+#include "trace/Trace.hpp"
+
+#endif
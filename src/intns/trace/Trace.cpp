@@ -0,0 +1,372 @@
+#include "Trace.hpp"
+
+#include <fstream>
+#include <ostream>
+#include <stdexcept>
+
+#if defined(INTNS_ENABLE_TRACING)
+#include <algorithm>
+#include <bit>
+#include <chrono>
+#include <cstdio>
+#include <mutex>
+#include <thread>
+#include <vector>
+#endif
+
+namespace intns::trace {
+
+#if defined(INTNS_ENABLE_TRACING)
+
+namespace detail {
+
+namespace {
+
+// Events per thread unless set_buffer_capacity() says otherwise: 640 KiB
+constexpr size_t kDefaultCapacity = 16 * 1024;
+
+// Shortest interval the tick rate is measured over on export
+constexpr auto kMinCalibration = std::chrono::milliseconds(10);
+
+// An event copied out of a ring
+struct Event {
+  EventKind kind;
+  const char* name;
+  uint64_t timestamp;
+  uint64_t value;
+  uint64_t id;
+};
+
+// The events copied out of one thread's ring
+struct ThreadEvents {
+  uint32_t id;
+  std::string name;
+  std::vector<Event> events;
+};
+
+void write_escaped(std::ostream& out, const char* text) {
+  out << '"';
+  for (const char* p = text; *p; ++p) {
+    const auto c = static_cast<unsigned char>(*p);
+    if (c == '"' || c == '\\') {
+      out << '\\' << *p;
+    } else if (c < 0x20) {
+      char escape[8];
+      std::snprintf(escape, sizeof(escape), "\\u%04x", c);
+      out << escape;
+    } else {
+      out << *p;
+    }
+  }
+  out << '"';
+}
+
+}  // namespace
+
+/**
+ * @brief Every thread's buffer, and the reference point for converting ticks
+ * to time.
+ */
+struct Registry {
+  using State = ThreadBuffer::State;
+
+  std::mutex mutex;
+  std::vector<std::unique_ptr<ThreadBuffer>> buffers;  // Including free ones
+  std::atomic<size_t> capacity{kDefaultCapacity};
+  uint32_t next_thread_id = 1;
+
+  const uint64_t start_ticks = now();
+  const std::chrono::steady_clock::time_point start_time =
+      std::chrono::steady_clock::now();
+
+  // Never destroyed, so threads still recording during static destruction
+  // keep valid buffers
+  static Registry& get() {
+    static Registry* registry = new Registry;
+    return *registry;
+  }
+
+  // Ticks per microsecond, measured since the registry was created
+  double ticks_per_us() {
+    const auto elapsed = std::chrono::steady_clock::now() - start_time;
+    if (elapsed < kMinCalibration) {
+      std::this_thread::sleep_for(kMinCalibration - elapsed);
+    }
+
+    const uint64_t ticks = now() - start_ticks;
+    const double us = std::chrono::duration<double, std::micro>(
+                          std::chrono::steady_clock::now() - start_time)
+                          .count();
+    return ticks > 0 && us > 0 ? static_cast<double>(ticks) / us : 1.0;
+  }
+
+  void set_name(ThreadBuffer& buffer, std::string_view name) {
+    std::scoped_lock lock(mutex);
+    buffer.name_ = name;
+  }
+
+  void clear() noexcept {
+    std::scoped_lock lock(mutex);
+    for (const auto& buffer : buffers) {
+      buffer->cleared_.store(buffer->head_.load(std::memory_order_acquire),
+                             std::memory_order_relaxed);
+    }
+    release_retired();
+  }
+
+  // Copies the events of every thread
+  std::vector<ThreadEvents> snapshot() {
+    std::vector<ThreadEvents> threads;
+    std::scoped_lock lock(mutex);
+    for (const auto& buffer : buffers) {
+      if (buffer->state_ == State::kFree) {
+        continue;
+      }
+      ThreadEvents& thread = threads.emplace_back();
+      thread.id = buffer->thread_id_;
+      thread.name = buffer->name_;
+      collect(*buffer, thread.events);
+    }
+    release_retired();
+    return threads;
+  }
+
+  // Returns a free buffer of `capacity` events as a new thread's, or null.
+  // Called with the lock held.
+  ThreadBuffer* reuse(size_t capacity, uint32_t thread_id) noexcept {
+    // Free buffers from before set_buffer_capacity() would never be reused
+    std::erase_if(buffers, [capacity](const auto& buffer) {
+      return buffer->state_ == State::kFree && buffer->mask_ + 1 != capacity;
+    });
+
+    const auto it = std::find_if(buffers.begin(), buffers.end(),
+                                 [](const auto& buffer) {
+                                   return buffer->state_ == State::kFree;
+                                 });
+    if (it == buffers.end()) {
+      return nullptr;
+    }
+
+    ThreadBuffer& buffer = **it;
+    buffer.thread_id_ = thread_id;
+    buffer.head_.store(0, std::memory_order_relaxed);
+    buffer.begin_.store(0, std::memory_order_relaxed);
+    buffer.cleared_.store(0, std::memory_order_relaxed);
+    buffer.name_.clear();
+    buffer.state_ = State::kLive;
+    return &buffer;
+  }
+
+  // Called when the owner of `buffer` exits
+  void retire(ThreadBuffer& buffer) noexcept {
+    std::scoped_lock lock(mutex);
+    const bool empty = buffer.head_.load(std::memory_order_relaxed) ==
+                       buffer.cleared_.load(std::memory_order_relaxed);
+    buffer.state_ = empty ? State::kFree : State::kRetired;
+  }
+
+  // Frees the buffers of exited threads once their events were exported or
+  // cleared. Called with the lock held.
+  void release_retired() noexcept {
+    for (const auto& buffer : buffers) {
+      if (buffer->state_ == State::kRetired) {
+        buffer->state_ = State::kFree;
+      }
+    }
+  }
+
+  // Appends the events of `buffer` that were not overwritten while copying
+  static void collect(const ThreadBuffer& buffer, std::vector<Event>& out) {
+    const uint64_t capacity = buffer.mask_ + 1;
+    const uint64_t head = buffer.head_.load(std::memory_order_acquire);
+    uint64_t first = head > capacity ? head - capacity : 0;
+    first = std::max(first, buffer.cleared_.load(std::memory_order_relaxed));
+
+    const size_t base = out.size();
+    for (uint64_t i = first; i < head; ++i) {
+      const ThreadBuffer::Slot& slot = buffer.slots_[i & buffer.mask_];
+      out.push_back(Event{
+          static_cast<EventKind>(slot.kind.load(std::memory_order_relaxed)),
+          reinterpret_cast<const char*>(static_cast<uintptr_t>(
+              slot.name.load(std::memory_order_relaxed))),
+          slot.timestamp.load(std::memory_order_relaxed),
+          slot.value.load(std::memory_order_relaxed),
+          slot.id.load(std::memory_order_relaxed)});
+    }
+
+    // Slots the owner started rewriting since may hold a mix of two events
+    std::atomic_thread_fence(std::memory_order_acquire);
+    const uint64_t begin = buffer.begin_.load(std::memory_order_relaxed);
+    if (begin > first + capacity) {
+      const uint64_t torn = std::min(begin - capacity, head) - first;
+      out.erase(out.begin() + static_cast<std::ptrdiff_t>(base),
+                out.begin() + static_cast<std::ptrdiff_t>(base + torn));
+    }
+  }
+};
+
+namespace {
+
+// Set once the thread's owner is destroyed, after which it records nothing
+thread_local bool t_exited = false;
+
+// Hands the thread's buffer back to the registry when the thread exits
+struct ThreadOwner {
+  ThreadBuffer* buffer = nullptr;
+
+  ~ThreadOwner() {
+    if (buffer) {
+      t_buffer = nullptr;
+      Registry::get().retire(*buffer);
+    }
+    t_exited = true;
+  }
+};
+
+thread_local ThreadOwner t_owner;
+
+}  // namespace
+
+ThreadBuffer::ThreadBuffer(size_t capacity, uint32_t thread_id)
+    : slots_(std::make_unique<Slot[]>(capacity)),
+      mask_(capacity - 1),
+      thread_id_(thread_id) {}
+
+ThreadBuffer& register_thread() {
+  if (t_exited) {
+    // Recording from a thread_local destructor running after the owner's
+    throw std::runtime_error("Trace buffer of an exiting thread");
+  }
+
+  Registry& registry = Registry::get();
+  const size_t capacity = registry.capacity.load(std::memory_order_relaxed);
+
+  std::scoped_lock lock(registry.mutex);
+  ThreadBuffer* buffer = registry.reuse(capacity, registry.next_thread_id);
+  if (!buffer) {
+    auto created =
+        std::make_unique<ThreadBuffer>(capacity, registry.next_thread_id);
+    buffer = created.get();
+    registry.buffers.push_back(std::move(created));
+  }
+  ++registry.next_thread_id;
+
+  t_owner.buffer = buffer;
+  t_buffer = buffer;
+  return *buffer;
+}
+
+}  // namespace detail
+
+void set_buffer_capacity(size_t events) noexcept {
+  detail::Registry::get().capacity.store(
+      std::bit_ceil(std::max<size_t>(events, 2)), std::memory_order_relaxed);
+}
+
+void set_thread_name(std::string_view name) {
+  detail::ThreadBuffer& buffer = detail::thread_buffer();
+  detail::Registry::get().set_name(buffer, name);
+}
+
+void clear() noexcept { detail::Registry::get().clear(); }
+
+void write_chrome_trace(std::ostream& out) {
+  detail::Registry& registry = detail::Registry::get();
+  const double ticks_per_us = registry.ticks_per_us();
+
+  const std::vector<detail::ThreadEvents> threads = registry.snapshot();
+
+  // Times are relative to the earliest event
+  uint64_t origin = UINT64_MAX;
+  for (const detail::ThreadEvents& thread : threads) {
+    for (const detail::Event& event : thread.events) {
+      origin = std::min(origin, event.timestamp);
+    }
+  }
+
+  const auto to_us = [&](uint64_t ticks) {
+    return static_cast<double>(ticks) / ticks_per_us;
+  };
+
+  const std::ios_base::fmtflags flags = out.flags();
+  const std::streamsize precision = out.precision();
+  out.setf(std::ios_base::fixed, std::ios_base::floatfield);
+  out.precision(3);
+
+  out << "{\"displayTimeUnit\":\"ns\",\"traceEvents\":[";
+  bool first = true;
+  const auto begin_event = [&](const char* name, const char* phase,
+                               uint32_t tid) {
+    out << (first ? "\n" : ",\n") << "{\"name\":";
+    first = false;
+    detail::write_escaped(out, name);
+    out << ",\"ph\":\"" << phase << "\",\"pid\":1,\"tid\":" << tid;
+  };
+
+  for (const detail::ThreadEvents& thread : threads) {
+    if (!thread.name.empty()) {
+      begin_event("thread_name", "M", thread.id);
+      out << ",\"args\":{\"name\":";
+      detail::write_escaped(out, thread.name.c_str());
+      out << "}}";
+    }
+
+    for (const detail::Event& event : thread.events) {
+      const double ts = to_us(event.timestamp - origin);
+      switch (event.kind) {
+        case EventKind::kZone:
+          begin_event(event.name, "X", thread.id);
+          out << ",\"ts\":" << ts << ",\"dur\":" << to_us(event.value) << '}';
+          break;
+        case EventKind::kCounter:
+          // One series per id, so counters of different objects stay apart
+          begin_event(event.name, "C", thread.id);
+          out << ",\"ts\":" << ts << ",\"args\":{\"";
+          if (event.id != 0) {
+            out << "0x" << std::hex << event.id << std::dec;
+          } else {
+            out << "value";
+          }
+          out << "\":" << event.value << "}}";
+          break;
+        case EventKind::kInstant:
+          begin_event(event.name, "i", thread.id);
+          out << ",\"ts\":" << ts << ",\"s\":\"t\"}";
+          break;
+      }
+    }
+  }
+  out << "\n]}\n";
+
+  out.flags(flags);
+  out.precision(precision);
+}
+
+#else
+
+void set_buffer_capacity(size_t) noexcept {}
+
+void set_thread_name(std::string_view) {}
+
+void clear() noexcept {}
+
+void write_chrome_trace(std::ostream& out) {
+  out << "{\"displayTimeUnit\":\"ns\",\"traceEvents\":[]}\n";
+}
+
+#endif  // INTNS_ENABLE_TRACING
+
+void write_chrome_trace(const std::string& filename) {
+  std::ofstream file(filename);
+  if (!file) {
+    throw std::runtime_error("Failed to open trace file: " + filename);
+  }
+
+  write_chrome_trace(file);
+  file.flush();
+  if (!file) {
+    throw std::runtime_error("Failed to write trace file: " + filename);
+  }
+}
+
+}  // namespace intns::trace
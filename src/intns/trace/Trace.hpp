@@ -0,0 +1,317 @@
+#ifndef INTNS_TRACE_TRACE_HPP
+#define INTNS_TRACE_TRACE_HPP
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <iosfwd>
+#include <memory>
+#include <string>
+#include <string_view>
+
+#if defined(INTNS_ENABLE_TRACING)
+#if defined(_MSC_VER) && !defined(__clang__) && \
+    (defined(_M_X64) || defined(_M_IX86))
+#include <intrin.h>
+#elif defined(__x86_64__) || defined(__i386__)
+#include <x86intrin.h>
+#elif !defined(__aarch64__)
+#include <chrono>
+#endif
+#endif
+
+/**
+ * @file Trace.hpp
+ * @brief A compile-time gated tracing layer for finding stalls.
+ *
+ * Define INTNS_ENABLE_TRACING (the INTNS_ENABLE_TRACING CMake option does so
+ * for every target) to record zones, counters and instants into per-thread
+ * lock-free ring buffers, time-stamped with the CPU's cycle counter, and
+ * export them with write_chrome_trace() for chrome://tracing or Perfetto.
+ * Without it the INTNS_TRACE_* macros expand to nothing and their arguments
+ * are not evaluated.
+ *
+ * @code
+ * void load_level() {
+ *   INTNS_TRACE_ZONE("load_level");
+ *   ...
+ * }
+ *
+ * intns::trace::write_chrome_trace("trace.json");
+ * @endcode
+ *
+ * @warning INTNS_ENABLE_TRACING changes the layout of instrumented classes,
+ * so it must be defined identically for the libraries and every program
+ * using them.
+ */
+
+namespace intns::trace {
+
+/**
+ * @brief Whether tracing is compiled in.
+ */
+#if defined(INTNS_ENABLE_TRACING)
+inline constexpr bool kEnabled = true;
+#else
+inline constexpr bool kEnabled = false;
+#endif
+
+/**
+ * @brief Kinds of recorded event.
+ */
+enum class EventKind : uint8_t {
+  kZone,     ///< A timed span, recorded when it ends.
+  kCounter,  ///< A sampled value, e.g. a high-water mark.
+  kInstant,  ///< A point in time.
+};
+
+/**
+ * @brief Sets the number of events each thread's ring buffer keeps; older
+ * events are overwritten. Applies to threads that record their first event
+ * afterwards.
+ *
+ * @param events Events per thread, rounded up to a power of two.
+ */
+void set_buffer_capacity(size_t events) noexcept;
+
+/**
+ * @brief Names the calling thread in exported traces.
+ *
+ * @param name The thread's name.
+ */
+void set_thread_name(std::string_view name);
+
+/**
+ * @brief Discards every event recorded so far, on all threads.
+ *
+ * The buffers of threads that have exited are kept until their events are
+ * cleared or exported, then reused by threads started later.
+ */
+void clear() noexcept;
+
+/**
+ * @brief Writes the recorded events as Chrome trace event JSON, which
+ * chrome://tracing and the Perfetto UI both open.
+ *
+ * May be called while other threads keep recording; events they overwrite
+ * during the export are left out. Afterwards the buffers of threads that
+ * have exited are reused, as by clear().
+ *
+ * @param out The stream to write to.
+ */
+void write_chrome_trace(std::ostream& out);
+
+/**
+ * @brief Writes the recorded events as Chrome trace event JSON to a file.
+ *
+ * @param filename The file to create or overwrite.
+ * @throws std::runtime_error If the file cannot be written.
+ */
+void write_chrome_trace(const std::string& filename);
+
+#if defined(INTNS_ENABLE_TRACING)
+
+namespace detail {
+
+/**
+ * @brief One thread's ring of events.
+ *
+ * Only the owning thread writes. Every word is a relaxed atomic so the
+ * exporter can copy slots while they are being overwritten; `begin_` is
+ * raised before a slot is rewritten, so the exporter can tell which of the
+ * slots it copied may be torn.
+ */
+class ThreadBuffer {
+ public:
+  ThreadBuffer(size_t capacity, uint32_t thread_id);
+
+  /**
+   * @brief Appends an event, overwriting the oldest once full.
+   */
+  void record(EventKind kind, const char* name, uint64_t timestamp,
+              uint64_t value, uint64_t id) noexcept {
+    const uint64_t index = head_.load(std::memory_order_relaxed);
+    begin_.store(index + 1, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_release);
+
+    Slot& slot = slots_[index & mask_];
+    slot.name.store(reinterpret_cast<uintptr_t>(name),
+                    std::memory_order_relaxed);
+    slot.timestamp.store(timestamp, std::memory_order_relaxed);
+    slot.value.store(value, std::memory_order_relaxed);
+    slot.id.store(id, std::memory_order_relaxed);
+    slot.kind.store(static_cast<uint64_t>(kind), std::memory_order_relaxed);
+    head_.store(index + 1, std::memory_order_release);
+  }
+
+ private:
+  friend struct Registry;
+
+  enum class State : uint8_t {
+    kLive,     // Owned by a running thread
+    kRetired,  // Its thread exited, events not yet exported or cleared
+    kFree,     // Waiting to be reused by a new thread
+  };
+
+  struct Slot {
+    std::atomic<uint64_t> name;
+    std::atomic<uint64_t> timestamp;
+    std::atomic<uint64_t> value;
+    std::atomic<uint64_t> id;
+    std::atomic<uint64_t> kind;
+  };
+
+  std::unique_ptr<Slot[]> slots_;
+  uint64_t mask_;
+  uint32_t thread_id_;
+
+  // One past the newest published event
+  std::atomic<uint64_t> head_{0};
+
+  // One past the newest event being written
+  std::atomic<uint64_t> begin_{0};
+
+  // Events before this index were discarded by clear()
+  std::atomic<uint64_t> cleared_{0};
+
+  // Set by set_thread_name(), read by the exporter under the registry lock
+  std::string name_;
+
+  // Guarded by the registry lock
+  State state_ = State::kLive;
+};
+
+// The calling thread's buffer, created on first use and handed back to the
+// registry when the thread exits
+inline thread_local ThreadBuffer* t_buffer = nullptr;
+
+// Creates or reuses a buffer for the calling thread and registers it
+ThreadBuffer& register_thread();
+
+inline ThreadBuffer& thread_buffer() {
+  ThreadBuffer* buffer = t_buffer;
+  return buffer ? *buffer : register_thread();
+}
+
+}  // namespace detail
+
+/**
+ * @brief Reads the timestamp counter: the TSC on x86, the virtual counter
+ * on AArch64 and the steady clock elsewhere.
+ *
+ * @return Ticks at an unspecified but constant rate, converted to
+ * microseconds on export.
+ */
+[[nodiscard]] inline uint64_t now() noexcept {
+#if defined(_MSC_VER) && !defined(__clang__) && \
+    (defined(_M_X64) || defined(_M_IX86))
+  return __rdtsc();
+#elif defined(__x86_64__) || defined(__i386__)
+  return __rdtsc();
+#elif defined(__aarch64__)
+  uint64_t ticks;
+  asm volatile("mrs %0, cntvct_el0" : "=r"(ticks));
+  return ticks;
+#else
+  return static_cast<uint64_t>(
+      std::chrono::steady_clock::now().time_since_epoch().count());
+#endif
+}
+
+/**
+ * @brief Records a counter sample.
+ *
+ * @param name Counter name; must outlive the trace, e.g. a string literal.
+ * @param value The sample.
+ * @param id Separates counters of the same name, e.g. an object address.
+ */
+inline void counter(const char* name, uint64_t value,
+                    uint64_t id = 0) noexcept {
+  try {
+    detail::thread_buffer().record(EventKind::kCounter, name, now(), value,
+                                   id);
+  } catch (...) {
+    // No buffer could be allocated for this thread: drop the event
+  }
+}
+
+/**
+ * @brief Records a point in time.
+ *
+ * @param name Event name; must outlive the trace, e.g. a string literal.
+ */
+inline void instant(const char* name) noexcept {
+  try {
+    detail::thread_buffer().record(EventKind::kInstant, name, now(), 0, 0);
+  } catch (...) {
+    // No buffer could be allocated for this thread: drop the event
+  }
+}
+
+/**
+ * @brief Records the span from its construction to its destruction.
+ */
+class Zone {
+ public:
+  /**
+   * @brief Starts the span.
+   *
+   * @param name Zone name; must outlive the trace, e.g. a string literal.
+   */
+  explicit Zone(const char* name) noexcept : name_(name), start_(now()) {}
+
+  ~Zone() {
+    const uint64_t end = now();
+    try {
+      detail::thread_buffer().record(EventKind::kZone, name_, start_,
+                                     end - start_, 0);
+    } catch (...) {
+      // No buffer could be allocated for this thread: drop the event
+    }
+  }
+
+  Zone(const Zone&) = delete;
+  Zone& operator=(const Zone&) = delete;
+
+ private:
+  const char* name_;
+  uint64_t start_;
+};
+
+#endif  // INTNS_ENABLE_TRACING
+
+}  // namespace intns::trace
+
+#define INTNS_TRACE_CONCAT_IMPL(a, b) a##b
+#define INTNS_TRACE_CONCAT(a, b) INTNS_TRACE_CONCAT_IMPL(a, b)
+
+#if defined(INTNS_ENABLE_TRACING)
+
+/**
+ * @brief Records a zone named `name` until the end of the enclosing scope.
+ */
+#define INTNS_TRACE_ZONE(name)      \
+  const ::intns::trace::Zone        \
+  INTNS_TRACE_CONCAT(intns_trace_zone_, __LINE__)(name)
+
+/**
+ * @brief Records a sample of the counter `name`, separated by `id`.
+ */
+#define INTNS_TRACE_COUNTER(name, value, id)                     \
+  ::intns::trace::counter((name), static_cast<uint64_t>(value), \
+                          static_cast<uint64_t>(id))
+
+/**
+ * @brief Records an instant named `name`.
+ */
+#define INTNS_TRACE_INSTANT(name) ::intns::trace::instant(name)
+
+#else
+
+#define INTNS_TRACE_ZONE(name) static_cast<void>(0)
+#define INTNS_TRACE_COUNTER(name, value, id) static_cast<void>(0)
+#define INTNS_TRACE_INSTANT(name) static_cast<void>(0)
+
+#endif
+
+#endif  // INTNS_TRACE_TRACE_HPP
@@ -1,15 +1,42 @@
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <cstring>
 #include <filesystem>
 #include <fstream>
 #include <iostream>
+#include <iterator>
+#include <memory>
+#include <memory_resource>
+#include <sstream>
+#include <stdexcept>
 #include <string>
+#include <thread>
+#include <vector>
 
 #include "intns/io.hpp"
 #include "intns/memory.hpp"
+#include "intns/task.hpp"
+#include "intns/trace.hpp"
 
 #ifndef _CRT_UNUSED
 #define _CRT_UNUSED(x) (void)x
 #endif
 
+// Number of failed checks, returned from main()
+int g_failures = 0;
+
+void check(bool ok, const char* what) {
+  if (ok) {
+    std::cout << what << " works correctly." << std::endl;
+  } else {
+    std::cout << what << " failed." << std::endl;
+    ++g_failures;
+  }
+}
+
 struct Object {
   int value;
   std::string s;
@@ -122,6 +149,1136 @@ void test_file_reader() {
   }
 }
 
+void test_cached_object_pool() {
+  using namespace intns::memory;
+
+  CachedObjectPool<int> pool(4, std::nullopt, 2);
+  bool ok = pool.size() == 4 && pool.magazine_size() == 2;
+
+  // Another thread sees the depot but not this thread's cache
+  int taken = pool.take();
+  pool.add(std::move(taken));
+  size_t other_size = 0;
+  std::thread([&] { other_size = pool.size(); }).join();
+  ok = ok && pool.size() == 4 && other_size == 3;
+
+  // Flushing moves the cached object back into the depot
+  pool.flush_thread_cache();
+  std::thread([&] { other_size = pool.size(); }).join();
+  ok = ok && other_size == 4;
+
+  ObjectPoolFor<PoolMode::kThreadCached, int> selected;
+  ok = ok && selected.empty();
+  check(ok, "CachedObjectPool");
+}
+
+void test_slot_pool() {
+  using namespace intns::memory;
+
+  SlotPool<std::string> pool(0, 8, 4);
+  pool.reserve(5);
+  std::string* first = pool.take();
+  *first = "stable";
+  std::string* second = pool.take();
+  pool.add(second);
+
+  // Growing the pool must not move objects already handed out
+  pool.reserve(7);
+  bool ok = *first == "stable" && pool.owns(first) && pool.capacity() == 8 &&
+            pool.size() == 7;
+
+  std::string outside;
+  ok = ok && !pool.owns(&outside) && !pool.try_reserve(9);
+  pool.add(first);
+  ok = ok && pool.size() == 8;
+  check(ok, "SlotPool");
+}
+
+void test_pool_batches() {
+  using namespace intns::memory;
+
+  ObjectPool<int> pool;
+  pool.add_n(std::vector<int>{1, 2, 3, 4});
+
+  // A short pool hands out what it has to try_take_n() and nothing to take_n()
+  std::vector<int> taken = pool.try_take_n(5);
+  bool ok = taken.size() == 4 && pool.empty();
+  ok = ok && pool.try_add_n(taken) && pool.size() == 4;
+  try {
+    (void)pool.take_n(5);
+    ok = false;
+  } catch (const std::runtime_error&) {
+    ok = ok && pool.size() == 4;
+  }
+
+  {
+    PoolBatchLease batch(pool, 2);
+    ok = ok && batch.size() == 2 && pool.size() == 2;
+  }
+  ok = ok && pool.size() == 4;
+  check(ok, "ObjectPool batching");
+}
+
+void test_pool_waiting() {
+  using namespace intns::memory;
+  using namespace std::chrono_literals;
+
+  ObjectPool<int> pool;
+  bool ok = !pool.try_take_for(1ms).has_value();
+
+  // A callback queued on an empty pool runs on the thread that adds an object
+  int handed = 0;
+  pool.async_take([&](int value) { handed = value; });
+  pool.add(7);
+  ok = ok && handed == 7 && pool.empty();
+
+  // A throwing callback doesn't keep the next waiter from being served
+  pool.async_take([](int) { throw std::runtime_error("callback failed"); });
+  pool.async_take([&](int value) { handed = value; });
+  bool rethrown = false;
+  try {
+    pool.add_n(std::vector<int>{3, 8});
+  } catch (const std::runtime_error&) {
+    rethrown = true;
+  }
+  ok = ok && rethrown && handed == 3 && pool.empty();
+
+  // A waiting take is woken by an add() from another thread
+  std::thread producer([&] {
+    std::this_thread::sleep_for(10ms);
+    pool.add(9);
+  });
+  ok = ok && pool.take_for(10s) == 9;
+  producer.join();
+  check(ok, "ObjectPool waiting");
+}
+
+// Has no default constructor, so pools of it must be built from a factory
+struct Handle {
+  explicit Handle(int v) : id(v) {}
+  int id;
+};
+
+void test_pool_growth() {
+  using namespace intns::memory;
+
+  int made = 0;
+  ObjectPool<Handle> pool([&] { return Handle(++made); },
+                          PoolGrowth{.chunk_size = 4}, 6);
+  bool ok = pool.empty() && made == 0;
+
+  // The first take creates a whole chunk; the limit caps the second one
+  Handle first = pool.take();
+  ok = ok && made == 4 && pool.size() == 3;
+  std::vector<Handle> rest = pool.take_n(5);
+  ok = ok && made == 6 && rest.size() == 5 && !pool.try_take().has_value();
+
+  // Nothing was touched since the last trim, so every object goes
+  pool.add(std::move(first));
+  pool.add_n(rest);
+  (void)pool.trim_idle();
+  ok = ok && pool.trim_idle() == 6 && pool.empty();
+
+  // A waiter queued and a limit lowered mid-growth are both honoured
+  int served = 0;
+  made = 0;
+  ObjectPool<Handle>* self = nullptr;
+  ObjectPool<Handle> racy(
+      [&] {
+        if (made == 0) {
+          self->async_take([&](Handle h) { served = h.id; });
+          self->set_size_limit(2);
+        }
+        return Handle(++made);
+      },
+      PoolGrowth{.chunk_size = 4}, 4);
+  self = &racy;
+  Handle taken = racy.take();
+  ok = ok && made == 4 && served != 0 && served != taken.id &&
+       racy.empty() && racy.size_limit() == 2;
+  check(ok, "ObjectPool growth");
+}
+
+void test_memory_stats() {
+  using namespace intns::memory;
+
+  ObjectPool<int, NoOpPoolPolicy<int>, NoOpPoolPolicy<int>, PoolStats> pool(
+      2, 3);
+  (void)pool.take();
+  (void)pool.take();
+  bool ok = !pool.try_take().has_value();
+  pool.add(1);
+  pool.add(2);
+  pool.add(3);
+  ok = ok && !pool.try_add(4);
+  { PoolLease lease(pool); }
+
+  const PoolStatsSnapshot pool_stats = pool.stats().snapshot();
+  ok = ok && pool_stats.hits == 3 && pool_stats.misses == 1 &&
+       pool_stats.rejected_adds == 1 && pool_stats.created == 2 &&
+       pool_stats.high_water == 3 && pool_stats.leases == 1;
+  check(ok, "PoolStats");
+
+  // The failed allocation does not count towards the peak
+  BasicStackAllocator<AllocatorStats> stack(64);
+  {
+    BasicStackCheckpoint checkpoint(stack);
+    ok = stack.alloc(32) && !stack.alloc(64) && stack.alloc_t<int>();
+  }
+  const AllocatorStatsSnapshot stack_stats = stack.stats().snapshot();
+  ok = ok && stack_stats.allocs == 2 && stack_stats.failed_allocs == 1 &&
+       stack_stats.peak_bytes == 36;
+  check(ok, "AllocatorStats");
+}
+
+void test_arena_allocator() {
+  using namespace intns::memory;
+
+  ArenaAllocator arena({.initial_block_size = 64,
+                        .growth_factor = 2,
+                        .max_block_size = 256,
+                        .max_capacity = 2048});
+  bool ok = arena.block_count() == 1 && arena.capacity() == 64;
+  ok = ok && arena.alloc(48);
+
+  {
+    BasicStackCheckpoint checkpoint(arena);
+    ok = ok && arena.alloc(48) && arena.block_count() == 2;
+
+    // Oversized requests get a block of their own
+    void* big = arena.alloc(1000, 256);
+    ok = ok && big && reinterpret_cast<uintptr_t>(big) % 256 == 0 &&
+         arena.block_count() == 3;
+  }
+  ok = ok && arena.block_count() == 1 && arena.bytes_used() == 48;
+
+  // Freed blocks are kept as spares, and max_capacity still caps growth
+  const size_t capacity = arena.capacity();
+  ok = ok && arena.alloc(100) && arena.capacity() == capacity &&
+       !arena.alloc(5000);
+  arena.reset();
+  arena.release_spare();
+  ok = ok && arena.bytes_used() == 0 && arena.capacity() == 64;
+
+  // A first block that can never fit is a usage error, not an OOM
+  bool rejected = false;
+  try {
+    ArenaAllocator tiny({.initial_block_size = 4096, .max_capacity = 1024});
+  } catch (const std::invalid_argument&) {
+    rejected = true;
+  }
+  ok = ok && rejected;
+  check(ok, "ArenaAllocator");
+}
+
+// Records the order objects are destroyed in
+struct Tracked {
+  static inline std::vector<int> destroyed;
+
+  explicit Tracked(int v) : id(v) {}
+  ~Tracked() { destroyed.push_back(id); }
+
+  int id;
+};
+
+void test_allocator_emplace() {
+  using namespace intns::memory;
+
+  Tracked::destroyed.clear();
+  StackAllocator stack(1024);
+  bool ok = stack.emplace<Tracked>(0) != nullptr;
+  {
+    StackCheckpoint checkpoint(stack);
+    ok = ok && stack.emplace<Tracked>(1) && stack.emplace<Tracked>(2);
+  }
+  // Rewinding destroys the objects above the checkpoint, newest first
+  ok = ok && Tracked::destroyed == std::vector<int>{2, 1};
+
+  ArenaAllocator arena({.initial_block_size = 64});
+  for (int i = 3; i < 8; ++i) {
+    ok = ok && arena.emplace<Tracked>(i) != nullptr;
+  }
+  arena.reset();
+  stack.reset();
+  ok = ok && Tracked::destroyed == std::vector<int>{2, 1, 7, 6, 5, 4, 3, 0};
+
+  // A failed emplace() leaves the allocator as it was
+  StackAllocator tiny(4);
+  ok = ok && !tiny.emplace<Tracked>(8) && tiny.bytes_used() == 0;
+  check(ok, "Allocator emplace()");
+}
+
+void test_scratch_frame() {
+  using namespace intns::memory;
+
+  bool ok = true;
+  {
+    ScratchFrame frame;
+    ok = ok && frame.emplace<std::string>(200, 'x')->size() == 200;
+    {
+      ScratchFrame nested;
+      ok = ok && nested.alloc(64) && ScratchArena::frame_depth() == 2;
+    }
+    // The arena cannot be released while a frame is open
+    ok = ok && ScratchArena::frame_depth() == 1 &&
+         !ScratchArena::release_local();
+  }
+  ok = ok && ScratchArena::local().bytes_used() == 0;
+
+  // Each thread gets an arena of its own
+  const ArenaAllocator* main_arena = &ScratchArena::local();
+  const ArenaAllocator* other_arena = nullptr;
+  std::thread([&] { other_arena = &ScratchArena::local(); }).join();
+  ok = ok && other_arena != main_arena;
+
+  ok = ok && ScratchArena::release_local() && !ScratchArena::has_local();
+  check(ok, "ScratchFrame");
+}
+
+void test_allocator_adapters() {
+  using namespace intns::memory;
+
+  StackAllocator stack(1 << 16);
+  AllocatorResource resource(stack);
+  bool ok = true;
+  {
+    StackCheckpoint checkpoint(stack);
+    std::pmr::vector<int> values(&resource);
+    for (int i = 0; i < 1000; ++i) {
+      values.push_back(i);
+    }
+    ok = ok && values[999] == 999 && stack.bytes_used() > 0;
+  }
+  ok = ok && stack.bytes_used() == 0;
+
+  // An exhausted allocator reports std::bad_alloc like any resource
+  try {
+    (void)resource.allocate(1 << 20);
+    ok = false;
+  } catch (const std::bad_alloc&) {
+  }
+  check(ok, "AllocatorResource");
+
+  std::vector<int, AllocatorAdapter<int>> adapted{AllocatorAdapter<int>(stack)};
+  adapted.assign(10, 3);
+  check(adapted.back() == 3 && stack.bytes_used() >= 10 * sizeof(int),
+        "AllocatorAdapter");
+}
+
+void test_double_stack_allocator() {
+  using namespace intns::memory;
+
+  DoubleStackAllocator stacks(256);
+  auto* bottom = static_cast<char*>(stacks.bottom().alloc(100));
+  auto* top = static_cast<char*>(stacks.top().alloc(100, 64));
+  bool ok = bottom && top && reinterpret_cast<uintptr_t>(top) % 64 == 0 &&
+            top >= bottom + 100;
+
+  // Both ends share the free space in the middle
+  ok = ok && !stacks.top().alloc(100) && !stacks.bottom().alloc(100);
+  ok = ok && stacks.top().release_top(top, 100) && stacks.bottom().alloc(100);
+  stacks.reset();
+  ok = ok && stacks.bytes_used() == 0;
+  check(ok, "DoubleStackAllocator");
+
+  DoubleBufferedAllocator<> frames(1024);
+  const auto* text = frames.emplace<std::string>(100, 'a');
+  frames.flip();
+
+  // Last frame's allocations stay valid for one more frame
+  ok = frames.previous().bytes_used() > 0 && *text == std::string(100, 'a');
+  frames.flip();
+  ok = ok && frames.current().bytes_used() == 0 && frames.frame_index() == 2;
+  check(ok, "DoubleBufferedAllocator");
+}
+
+void test_size_class_allocator() {
+  using namespace intns::memory;
+
+  static_assert(SizeClassAllocator::class_of(1, 1) == 0);
+  static_assert(SizeClassAllocator::class_of(512, 16) == 31);
+  static_assert(SizeClassAllocator::class_of(513, 16) == 32);
+
+  SizeClassAllocator allocator(4096);
+  std::vector<void*> blocks;
+  for (int i = 0; i < 200; ++i) {
+    blocks.push_back(allocator.alloc(48, 16));
+  }
+  const size_t reserved = allocator.bytes_reserved();
+
+  // Freed blocks are reused by later allocations of the same class
+  bool ok = true;
+  for (int round = 0; round < 2; ++round) {
+    for (void* block : blocks) {
+      ok = ok && block && reinterpret_cast<uintptr_t>(block) % 16 == 0;
+      allocator.deallocate(block, 48, 16);
+    }
+    for (void*& block : blocks) {
+      block = allocator.alloc(48, 16);
+    }
+  }
+  ok = ok && allocator.bytes_reserved() == reserved;
+  for (void* block : blocks) {
+    allocator.deallocate(block, 48, 16);
+  }
+  check(ok, "SizeClassAllocator");
+
+  // Blocks may be freed by a different thread than allocated them
+  CachedSizeClassAllocator cached(8, 4096);
+  ok = true;
+  for (void*& block : blocks) {
+    block = cached.alloc(64);
+    ok = ok && block;
+  }
+  std::thread([&] {
+    for (void* block : blocks) {
+      cached.deallocate(block, 64);
+    }
+  }).join();
+  ok = ok && cached.alloc(64) != nullptr;
+  check(ok, "CachedSizeClassAllocator");
+}
+
+void test_page_memory() {
+  using namespace intns::memory;
+
+  // Sizes are rounded up to whole pages
+  PageMemory pages = PageMemory::map(100);
+  bool ok = pages && pages.size() == PageMemory::page_size();
+  std::memset(pages.data(), 1, pages.size());
+  ok = ok && !PageMemory::try_map(0);
+
+  // Explicit huge pages fall back to small ones when none are reserved
+  PageOptions options;
+  options.huge_pages = HugePages::kExplicit;
+  PageMemory huge = PageMemory::map(3 << 20, options);
+  ok = ok && huge && huge.size() % PageMemory::huge_page_size() == 0;
+
+  // Discarding a sub-range keeps the partial pages at either end
+  const size_t page = PageMemory::page_size();
+  PageMemory three = PageMemory::map(3 * page);
+  auto* bytes = static_cast<uint8_t*>(three.data());
+  std::memset(bytes, 7, three.size());
+  (void)PageMemory::advise(bytes + 100, 2 * page, PageAdvice::kDontNeed);
+  ok = ok && bytes[100] == 7 && bytes[page - 1] == 7 && bytes[2 * page] == 7 &&
+       bytes[2 * page + 99] == 7;
+  check(ok, "PageMemory");
+}
+
+void write_file(const std::string& path, const std::vector<uint8_t>& bytes) {
+  std::ofstream out(path, std::ios::binary);
+  out.write(reinterpret_cast<const char*>(bytes.data()),
+            static_cast<std::streamsize>(bytes.size()));
+}
+
+void test_mapped_file_reader() {
+  using namespace intns::io;
+
+  write_file("test_mapped.bin", {0, 0, 0, 5, 'h', 'i', 0, 1, 2});
+  bool ok = true;
+  try {
+    BEMappedFileReader reader("test_mapped.bin");
+    ok = reader.size() == 9 && reader.read_u32() == 5 &&
+         reader.read_cstring() == "hi";
+    reader.set_position(7);
+    ok = ok && reader.read_u8() == 1 && reader.bytes().size() == 9;
+  } catch (const std::exception& e) {
+    std::cerr << "Error mapping file: " << e.what() << std::endl;
+    ok = false;
+  }
+  std::filesystem::remove("test_mapped.bin");
+
+  try {
+    LEMappedFileReader missing("test_missing.bin");
+    ok = false;
+  } catch (const std::runtime_error&) {
+  }
+  check(ok, "MappedFileReader");
+}
+
+void test_memory_reader_views() {
+  using namespace intns::io;
+
+  const std::vector<uint8_t> buffer = {'a', 'b', 0, 'c', 'd', 'e',
+                                       1,   2,   3, 4,   'x', 'y'};
+  LEMemoryReader reader(buffer);
+
+  // Views point into the buffer instead of copying
+  const std::string_view name = reader.read_cstring_view();
+  bool ok = name == "ab" &&
+            name.data() == reinterpret_cast<const char*>(buffer.data());
+  ok = ok && reader.read_string_view(3) == "cde";
+  const std::span<const uint8_t> bytes = reader.read_view(2);
+  ok = ok && bytes.size() == 2 && bytes.data() == buffer.data() + 6;
+
+  LEMemoryReader sub = reader.subreader(8, 2);
+  ok = ok && sub.size() == 2 && sub.read_u8() == 3 && reader.position() == 8;
+  try {
+    (void)reader.subreader(10, 3);
+    ok = false;
+  } catch (const std::out_of_range&) {
+  }
+  check(ok, "MemoryReader view access");
+}
+
+void test_byte_swap_arrays() {
+  using namespace intns::io;
+
+  // Odd lengths cover both the vector loop and the scalar tail
+  std::vector<uint8_t> buffer;
+  for (int i = 0; i < 8 * 37; ++i) {
+    buffer.push_back(static_cast<uint8_t>(i));
+  }
+  BEMemoryReader reader(buffer);
+  std::vector<uint64_t> wide(37);
+  reader.read_u64_array(wide.data(), wide.size());
+
+  bool ok = true;
+  for (size_t i = 0; i < wide.size(); ++i) {
+    uint64_t expected = 0;
+    for (size_t k = 0; k < 8; ++k) {
+      expected = (expected << 8) | buffer[8 * i + k];
+    }
+    ok = ok && wide[i] == expected;
+  }
+
+  // Reads spanning several refills of a small file buffer
+  write_file("test_swap.bin", buffer);
+  try {
+    BEFileReader file_reader("test_swap.bin", 16);
+    std::vector<uint16_t> narrow(147);
+    file_reader.read_u16_array(narrow.data(), narrow.size());
+    ok = ok && narrow[146] == ((292 & 0xff) << 8 | (293 & 0xff));
+  } catch (const std::exception& e) {
+    std::cerr << "Error reading file: " << e.what() << std::endl;
+    ok = false;
+  }
+  std::filesystem::remove("test_swap.bin");
+
+  std::vector<double> values = {1.5, 2.5};
+  bswap_inplace(std::span<double>(values));
+  bswap_inplace(std::span<double>(values));
+  ok = ok && values[1] == 2.5;
+  std::cout << "Byte swap kernel: " << bswap_kernel() << std::endl;
+  check(ok, "Big-endian array reading");
+}
+
+void test_read_cursor() {
+  using namespace intns::io;
+
+  std::vector<uint8_t> buffer(40);
+  for (size_t i = 0; i < buffer.size(); ++i) {
+    buffer[i] = static_cast<uint8_t>(i);
+  }
+
+  // The bounds are checked once, when the bytes are reserved
+  BEMemoryReader reader(buffer);
+  ReadCursor cursor = reader.reserve(8);
+  bool ok = reader.position() == 8 && cursor.remaining() == 8;
+  ok = ok && cursor.read_u16() == 0x0001 && cursor.read_u8() == 2 &&
+       cursor.read_string_view(1).size() == 1 &&
+       cursor.read_u32() == 0x04050607 && cursor.remaining() == 0;
+  try {
+    (void)reader.reserve(100);
+    ok = false;
+  } catch (const std::out_of_range&) {
+    ok = ok && reader.position() == 8;
+  }
+
+  // A file reader cannot reserve more than its buffer holds
+  write_file("test_cursor.bin", buffer);
+  try {
+    LEFileReader file_reader("test_cursor.bin", 16);
+    (void)file_reader.read_u8();
+    ok = ok && file_reader.reserve(16).read_u32() == 0x04030201 &&
+         file_reader.position() == 17;
+    try {
+      (void)file_reader.reserve(17);
+      ok = false;
+    } catch (const std::invalid_argument&) {
+    }
+  } catch (const std::exception& e) {
+    std::cerr << "Error reading file: " << e.what() << std::endl;
+    ok = false;
+  }
+  std::filesystem::remove("test_cursor.bin");
+  check(ok, "ReadCursor");
+}
+
+// Records read and written field by field, without padding
+enum class Kind : uint16_t { kMesh = 1, kLight = 0x0203 };
+
+struct Vec3 {
+  float x, y, z;
+};
+
+struct Vertex {
+  Vec3 pos;
+  uint32_t colour;
+};
+
+struct Header {
+  Kind kind;
+  std::array<uint16_t, 2> version;
+  uint8_t flags;
+  uint32_t count;
+};
+
+// C arrays have no wire layout, so records holding them are rejected
+struct WithCArray {
+  float p[3];
+  int x;
+};
+
+void test_schema() {
+  using namespace intns::io;
+
+  static_assert(wire_size<Vertex>() == 16);
+  static_assert(wire_size<Header>() == 2 + 4 + 1 + 4);
+  static_assert(!has_native_layout<Header, Endianness::kLittle>());
+  static_assert(!WireType<int*> && !WireType<long double>);
+  static_assert(!WireType<WithCArray>);
+
+  const Header header{Kind::kLight, {1, 2}, 9, 3};
+  std::vector<Vertex> vertices(3);
+  for (uint32_t i = 0; i < 3; ++i) {
+    vertices[i] = {{1.0f * i, 2.0f, 3.0f}, i};
+  }
+
+  BEMemoryWriter writer;
+  writer.write(header);
+  writer.write_array<Vertex>(vertices);
+  const std::vector<uint8_t> bytes = writer.take();
+
+  BEMemoryReader reader(bytes);
+  const auto read_header = reader.read<Header>();
+  std::vector<Vertex> read_vertices(read_header.count);
+  reader.read_array<Vertex>(read_vertices);
+
+  bool ok = bytes.size() == 11 + 3 * 16 && read_header.kind == Kind::kLight &&
+            read_header.version[1] == 2 && read_header.flags == 9 &&
+            reader.remaining() == 0;
+  ok = ok && read_vertices[2].pos.x == 2.0f && read_vertices[2].colour == 2;
+  check(ok, "Record reading");
+}
+
+void test_binary_writers() {
+  using namespace intns::io;
+
+  // Reserve a count up front and patch it once it is known
+  LEMemoryWriter writer(1);
+  writer.write_u32(0);
+  writer.write_cstring("hello");
+  const std::vector<uint8_t> payload(5000, 0x5a);
+  writer.write_bytes(payload.data(), payload.size());
+  writer.patch_u32(0, 2);
+  const std::vector<uint8_t> bytes = writer.take();
+
+  LEMemoryReader reader(bytes);
+  bool ok = reader.read_u32() == 2 && reader.read_cstring() == "hello" &&
+            reader.remaining() == payload.size() && writer.size() == 0;
+
+  // A file writer produces the same bytes through its own buffer
+  try {
+    {
+      LEFileWriter file_writer("test_writer.bin", 64);
+      file_writer.write_u32(0);
+      file_writer.write_cstring("hello");
+      file_writer.write_bytes(payload.data(), payload.size());
+      file_writer.patch_u32(0, 2);
+    }
+    LEMappedFileReader file_reader("test_writer.bin");
+    ok = ok && std::ranges::equal(file_reader.bytes(), bytes);
+  } catch (const std::exception& e) {
+    std::cerr << "Error writing file: " << e.what() << std::endl;
+    ok = false;
+  }
+  std::filesystem::remove("test_writer.bin");
+
+  // A fixed writer refuses to write past its buffer
+  uint8_t fixed[8];
+  BEMemoryWriter fixed_writer(std::span<uint8_t>(fixed, 8));
+  fixed_writer.write_u32(1);
+  try {
+    fixed_writer.write_u64(2);
+    ok = false;
+  } catch (const std::out_of_range&) {
+    ok = ok && fixed_writer.size() == 4;
+  }
+  check(ok, "Binary writing");
+}
+
+void test_read_ahead() {
+  using namespace intns::io;
+
+  std::vector<uint8_t> bytes(100003);
+  for (size_t i = 0; i < bytes.size(); ++i) {
+    bytes[i] = static_cast<uint8_t>(i * 31 + (i >> 8));
+  }
+  write_file("test_read_ahead.bin", bytes);
+
+  bool ok = true;
+  try {
+    LEFileReader reader("test_read_ahead.bin", 4096, ReadAhead{2, 1000});
+    std::vector<uint8_t> read(bytes.size());
+    reader.read_bytes(read.data(), 50000);
+
+    // Seeking restarts the background reads at the new position
+    reader.set_position(100);
+    reader.read_bytes(read.data() + 100, read.size() - 100);
+    ok = reader.reads_ahead() && read == bytes && reader.remaining() == 0;
+    try {
+      (void)reader.read_u8();
+      ok = false;
+    } catch (const std::out_of_range&) {
+    }
+    reader.set_position(5);
+    ok = ok && reader.read_u8() == bytes[5];
+  } catch (const std::exception& e) {
+    std::cerr << "Error reading file: " << e.what() << std::endl;
+    ok = false;
+  }
+  std::filesystem::remove("test_read_ahead.bin");
+  check(ok, "FileReader read-ahead");
+}
+
+void test_cstring_tables() {
+  using namespace intns::io;
+
+  const std::vector<std::string> names = {"", "a", "mesh",
+                                          std::string(300, 'x'), "light"};
+  std::vector<uint8_t> bytes;
+  for (const std::string& name : names) {
+    bytes.insert(bytes.end(), name.begin(), name.end());
+    bytes.push_back(0);
+  }
+  bytes.push_back(7);
+
+  // A memory reader's table points into the buffer it reads from
+  LEMemoryReader reader(bytes);
+  const StringTable table = reader.read_cstring_table(names.size());
+  bool ok = table.size() == names.size() && table.storage_size() == 0 &&
+            table[3] == names[3] && reader.read_u8() == 7;
+  LEMemoryReader short_reader(bytes);
+  try {
+    (void)short_reader.read_cstring_table(names.size() + 2);
+    ok = false;
+  } catch (const std::out_of_range&) {
+    ok = ok && short_reader.position() == 0;
+  }
+
+  // Strings straddling buffer refills are copied out whole
+  write_file("test_strings.bin", bytes);
+  for (size_t buffer_size : {1, 3}) {
+    try {
+      LEFileReader file_reader("test_strings.bin", buffer_size);
+      ok = ok && file_reader.read_cstring().empty();
+      const StringTable file_table =
+          file_reader.read_cstring_table(names.size() - 1);
+      for (size_t i = 0; i < file_table.size(); ++i) {
+        ok = ok && file_table[i] == names[i + 1];
+      }
+      ok = ok && file_reader.read_u8() == 7;
+    } catch (const std::exception& e) {
+      std::cerr << "Error reading file: " << e.what() << std::endl;
+      ok = false;
+    }
+  }
+  std::filesystem::remove("test_strings.bin");
+  check(ok, "C string table reading");
+}
+
+void test_varints() {
+  using namespace intns::io;
+
+  const std::vector<uint64_t> values = {0, 127, 128, 1ull << 56, UINT64_MAX};
+  const std::vector<int64_t> signed_values = {0, -1, 63, -65, INT64_MIN};
+  std::vector<uint8_t> bytes;
+  const auto put_uleb128 = [&](uint64_t value) {
+    do {
+      const auto byte = static_cast<uint8_t>(value & 0x7f);
+      value >>= 7;
+      bytes.push_back(value != 0 ? byte | 0x80 : byte);
+    } while (value != 0);
+  };
+  for (uint64_t value : values) {
+    put_uleb128(value);
+  }
+  for (int64_t value : signed_values) {
+    put_uleb128(zigzag_encode(value));
+  }
+
+  bool ok = true;
+  LEMemoryReader reader(bytes);
+  for (uint64_t value : values) {
+    ok = ok && reader.read_uleb128() == value;
+  }
+  for (int64_t value : signed_values) {
+    ok = ok && reader.read_zigzag() == value;
+  }
+  ok = ok && reader.remaining() == 0;
+
+  // Varints straddling buffer refills decode the same
+  write_file("test_varints.bin", bytes);
+  for (size_t buffer_size : {1, 3}) {
+    try {
+      LEFileReader file_reader("test_varints.bin", buffer_size);
+      for (uint64_t value : values) {
+        ok = ok && file_reader.read_uleb128() == value;
+      }
+      for (int64_t value : signed_values) {
+        ok = ok && file_reader.read_zigzag() == value;
+      }
+    } catch (const std::exception& e) {
+      std::cerr << "Error reading file: " << e.what() << std::endl;
+      ok = false;
+    }
+  }
+  std::filesystem::remove("test_varints.bin");
+
+  // A truncated varint runs out of input, an overlong one is malformed
+  const std::vector<uint8_t> truncated = {0x80, 0x80};
+  try {
+    LEMemoryReader truncated_reader(truncated);
+    (void)truncated_reader.read_uleb128();
+    ok = false;
+  } catch (const std::out_of_range&) {
+  }
+  const std::vector<uint8_t> overlong(11, 0x80);
+  try {
+    LEMemoryReader overlong_reader(overlong);
+    (void)overlong_reader.read_uleb128();
+    ok = false;
+  } catch (const std::out_of_range&) {
+    ok = false;
+  } catch (const std::runtime_error&) {
+  }
+  check(ok, "LEB128 varint reading");
+
+  // 3 bits, 13 bits, then a byte after syncing with the byte reader
+  const std::vector<uint8_t> packed = {0xB5, 0x55, 0xA5, 0x5A};
+  LEMemoryReader bit_source(packed);
+  BitReader<LEMemoryReader> bits(bit_source);
+  ok = bits.read_bits(3) == 0b101 && bits.peek_bits(13) == 0x1555 &&
+       bits.read_bits(13) == 0x1555 && bits.read_bit();
+  bits.align_to_byte();
+  bits.sync();
+  ok = ok && bit_source.read_u8() == 0x5A;
+  check(ok, "BitReader");
+}
+
+void test_stream_reader() {
+  using namespace intns::io;
+
+  LEMemoryWriter writer;
+  for (uint32_t i = 0; i < 1000; ++i) {
+    writer.write_u32(i);
+    writer.write_cstring(std::string(i % 40, 'a'));
+  }
+  const std::vector<uint8_t> raw = writer.take();
+
+  const auto read_all = [&](StreamReader<>& reader) {
+    bool ok = true;
+    for (uint32_t i = 0; i < 1000; ++i) {
+      ok = ok && reader.read_u32() == i &&
+           reader.read_cstring().size() == i % 40;
+    }
+    return ok && reader.at_end() && reader.position() == raw.size();
+  };
+
+  bool ok = true;
+  write_file("test_stream.bin", raw);
+  try {
+    StreamReader<> reader("test_stream.bin", 16);
+    ok = read_all(reader);
+  } catch (const std::exception& e) {
+    std::cerr << "Error reading file: " << e.what() << std::endl;
+    ok = false;
+  }
+  std::filesystem::remove("test_stream.bin");
+
+  // Compressed input is decoded as it is read; needs zlib at build time
+  if (compression_supported(Compression::kZlib)) {
+    const std::vector<uint8_t> compressed =
+        compress_block(raw, Compression::kZlib);
+    ok = ok && detect_compression(compressed) == Compression::kZlib;
+    StreamReader<> reader(std::make_unique<DecompressStream>(
+                              std::make_unique<MemoryInputStream>(compressed),
+                              Compression::kZlib, 100),
+                          16);
+    ok = ok && read_all(reader);
+  }
+  check(ok, "StreamReader");
+}
+
+void test_chunk_file() {
+  using namespace intns::io;
+
+  // The standard CRC-32C check value, whole and in pieces
+  const std::string digits = "123456789";
+  const std::span<const uint8_t> digit_bytes(
+      reinterpret_cast<const uint8_t*>(digits.data()), digits.size());
+  bool ok = crc32c(digit_bytes) == 0xE3069283 &&
+            crc32c(digit_bytes.subspan(4), crc32c(digit_bytes.first(4))) ==
+                0xE3069283;
+  std::cout << "CRC-32C kernel: " << crc32c_kernel() << std::endl;
+  check(ok, "CRC-32C");
+
+  const Compression compression = compression_supported(Compression::kZlib)
+                                      ? Compression::kZlib
+                                      : Compression::kNone;
+  const std::vector<uint8_t> mesh(10000, 0x11);
+  const std::vector<uint8_t> empty;
+  uint64_t mesh_offset = 0;
+  try {
+    {
+      ChunkFileWriter writer("test_chunks.bin");
+      ok = writer.add_chunk(chunk_tag("MESH"), mesh, compression) == 0 &&
+           writer.add_chunk(chunk_tag("NONE"), empty) == 1;
+      writer.finish();
+    }
+
+    ChunkFile file("test_chunks.bin");
+    ok = ok && file.chunk_count() == 2 && file.chunk(0).offset % 64 == 0 &&
+         file.find(chunk_tag("NONE")) == 1 && !file.find(chunk_tag("GONE"));
+    mesh_offset = file.chunk(0).offset;
+    const ChunkData data = file.load(0);
+    ok = ok && std::ranges::equal(data.bytes(), mesh) &&
+         file.load(1).size() == 0;
+  } catch (const std::exception& e) {
+    std::cerr << "Error with chunk file: " << e.what() << std::endl;
+    ok = false;
+  }
+
+  // A flipped bit in a chunk fails its checksum
+  try {
+    std::vector<uint8_t> bytes;
+    {
+      std::ifstream in("test_chunks.bin", std::ios::binary);
+      bytes.assign(std::istreambuf_iterator<char>(in), {});
+    }
+    bytes[mesh_offset + 10] ^= 1;
+    write_file("test_chunks.bin", bytes);
+    ChunkFile corrupt("test_chunks.bin");
+    (void)corrupt.load(0);
+    ok = false;
+  } catch (const std::runtime_error&) {
+  }
+  std::filesystem::remove("test_chunks.bin");
+  check(ok, "ChunkFile");
+}
+
+void test_batch_loader() {
+  using namespace intns::io;
+
+  std::vector<std::string> paths;
+  for (uint32_t i = 0; i < 20; ++i) {
+    paths.push_back("test_batch_" + std::to_string(i) + ".bin");
+    write_file(paths.back(), {static_cast<uint8_t>(i), 0, 0, 0});
+  }
+  paths.push_back("test_batch_missing.bin");
+
+  // Files are parsed concurrently; a missing one is reported, not thrown
+  BatchLoader loader({.thread_count = 4});
+  std::vector<uint32_t> values(paths.size(), 0);
+  size_t failed_index = 0;
+  const BatchLoadResult result = loader.load(
+      paths,
+      [&](size_t i, LEMemoryReader& reader) { values[i] = reader.read_u32(); },
+      [&](size_t i, std::exception_ptr) { failed_index = i; });
+
+  bool ok = result.loaded == 20 && result.failed == 1 && failed_index == 20;
+  for (uint32_t i = 0; i < 20; ++i) {
+    ok = ok && values[i] == i;
+  }
+
+  // Without an error callback the first failure is rethrown
+  try {
+    (void)loader.load(paths, [](size_t, LEMemoryReader&) {});
+    ok = false;
+  } catch (const std::runtime_error&) {
+  }
+  for (const std::string& path : paths) {
+    std::filesystem::remove(path);
+  }
+  check(ok, "BatchLoader");
+}
+
+long fibonacci(intns::task::Scheduler& scheduler, int n) {
+  if (n < 2) {
+    return n;
+  }
+  long a = 0;
+  long b = 0;
+  scheduler.invoke([&] { a = fibonacci(scheduler, n - 1); },
+                   [&] { b = fibonacci(scheduler, n - 2); });
+  return a + b;
+}
+
+void test_scheduler() {
+  using namespace intns::task;
+
+  Scheduler scheduler({.thread_count = 4});
+  bool ok = fibonacci(scheduler, 20) == 6765;
+
+  std::vector<std::atomic<int>> hits(10000);
+  scheduler.parallel_for(0, hits.size(), [&](size_t first, size_t last) {
+    for (size_t i = first; i < last; ++i) {
+      hits[i].fetch_add(1, std::memory_order_relaxed);
+    }
+  });
+  for (const std::atomic<int>& hit : hits) {
+    ok = ok && hit.load() == 1;
+  }
+
+  // A task's exception is rethrown by wait(), which resets the group
+  TaskGroup group;
+  for (int i = 0; i < 100; ++i) {
+    scheduler.spawn(group, [i] {
+      if (i == 50) {
+        throw std::runtime_error("Task failed");
+      }
+    });
+  }
+  try {
+    scheduler.wait(group);
+    ok = false;
+  } catch (const std::runtime_error&) {
+    ok = ok && group.done() && !group.failed();
+  }
+  check(ok, "Scheduler");
+
+  std::vector<int> order;
+  TaskGraph graph;
+  const auto load = graph.add([&] { order.push_back(1); });
+  const auto parse = graph.add([&] { order.push_back(2); });
+  const auto upload = graph.add([&] { order.push_back(3); });
+  graph.precede(load, parse);
+  graph.precede(parse, upload);
+  graph.run(scheduler);
+  ok = order == std::vector<int>{1, 2, 3};
+
+  // A cycle is rejected before any node runs
+  graph.precede(upload, load);
+  try {
+    graph.run(scheduler);
+    ok = false;
+  } catch (const std::logic_error&) {
+    ok = ok && order.size() == 3;
+  }
+  check(ok, "TaskGraph");
+
+  // The owner pops from the bottom, thieves steal from the top
+  WorkStealingDeque<int> deque(2);
+  for (int i = 0; i < 5; ++i) {
+    deque.push(i);
+  }
+  ok = deque.size() == 5 && deque.capacity() >= 5 && deque.pop() == 4;
+  std::optional<int> stolen;
+  std::thread([&] { stolen = deque.steal(); }).join();
+  ok = ok && stolen == 0 && deque.pop() == 3 && deque.size() == 2;
+  check(ok, "WorkStealingDeque");
+}
+
+void test_rings() {
+  using namespace intns::task;
+
+  SpscRing<std::unique_ptr<int>> spsc(4);
+  bool ok = true;
+  for (int i = 0; i < 4; ++i) {
+    ok = ok && spsc.try_push(std::make_unique<int>(i));
+  }
+
+  // A full ring leaves the rejected value with the caller
+  auto extra = std::make_unique<int>(9);
+  ok = ok && !spsc.try_push(std::move(extra)) && extra && spsc.size() == 4;
+  ok = ok && **spsc.try_pop() == 0;
+  std::vector<std::unique_ptr<int>> out(10);
+  ok = ok && spsc.pop_n(out) == 3 && *out[2] == 3 && spsc.empty();
+
+  // Every value pushed by one thread arrives in order on the other
+  SpscRing<size_t> numbers(64);
+  constexpr size_t kCount = 100000;
+  std::thread producer([&] {
+    for (size_t i = 1; i <= kCount;) {
+      if (numbers.try_push(size_t{i})) {
+        ++i;
+      } else {
+        std::this_thread::yield();
+      }
+    }
+  });
+  size_t expected = 1;
+  while (expected <= kCount) {
+    size_t value = 0;
+    if (numbers.try_pop(value)) {
+      ok = ok && value == expected++;
+    } else {
+      std::this_thread::yield();
+    }
+  }
+  producer.join();
+  check(ok, "SpscRing");
+
+  // Many producers and consumers share one ring
+  MpmcRing<size_t> shared(128);
+  std::atomic<size_t> sum{0};
+  std::atomic<size_t> received{0};
+  std::vector<std::thread> threads;
+  for (size_t t = 0; t < 2; ++t) {
+    threads.emplace_back([&, t] {
+      for (size_t i = t; i < kCount;) {
+        if (shared.try_push(size_t{i})) {
+          i += 2;
+        } else {
+          std::this_thread::yield();
+        }
+      }
+    });
+    threads.emplace_back([&] {
+      while (received.load() < kCount) {
+        if (std::optional<size_t> value = shared.try_pop()) {
+          sum += *value;
+          ++received;
+        } else {
+          std::this_thread::yield();
+        }
+      }
+    });
+  }
+  for (std::thread& thread : threads) {
+    thread.join();
+  }
+  check(sum == kCount * (kCount - 1) / 2 && shared.empty(), "MpmcRing");
+}
+
+void test_trace() {
+  namespace trace = intns::trace;
+
+  std::thread([] {
+    trace::set_thread_name("loader");
+    INTNS_TRACE_ZONE("load_level");
+    INTNS_TRACE_COUNTER("bytes_loaded", 4096, 0);
+  }).join();
+
+  // Events of exited threads are still exported once
+  std::ostringstream first;
+  trace::write_chrome_trace(first);
+  std::ostringstream second;
+  trace::write_chrome_trace(second);
+
+  bool ok = first.str().find("{\"displayTimeUnit\"") == 0;
+  if constexpr (trace::kEnabled) {
+    ok = ok && first.str().find("\"load_level\"") != std::string::npos &&
+         first.str().find("\"loader\"") != std::string::npos &&
+         second.str().find("\"load_level\"") == std::string::npos;
+  } else {
+    ok = ok && first.str() == second.str();
+  }
+  trace::clear();
+  check(ok, "Tracing");
+}
+
 int main(int argc, char** argv) {
   _CRT_UNUSED(argc);
   _CRT_UNUSED(argv);
@@ -130,6 +1287,34 @@ int main(int argc, char** argv) {
   test_stack_allocator();
   test_memory_reader();
   test_file_reader();
+  test_cached_object_pool();
+  test_slot_pool();
+  test_pool_batches();
+  test_pool_waiting();
+  test_pool_growth();
+  test_memory_stats();
+  test_arena_allocator();
+  test_allocator_emplace();
+  test_scratch_frame();
+  test_allocator_adapters();
+  test_double_stack_allocator();
+  test_size_class_allocator();
+  test_page_memory();
+  test_mapped_file_reader();
+  test_memory_reader_views();
+  test_byte_swap_arrays();
+  test_read_cursor();
+  test_schema();
+  test_binary_writers();
+  test_read_ahead();
+  test_cstring_tables();
+  test_varints();
+  test_stream_reader();
+  test_chunk_file();
+  test_batch_loader();
+  test_scheduler();
+  test_rings();
+  test_trace();
 
-  return 0;
+  return g_failures == 0 ? 0 : 1;
 }